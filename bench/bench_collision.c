@@ -0,0 +1,42 @@
+#include "bench_util.h"
+#include "collision.h"
+#include "polygon.h"
+#include <stdlib.h>
+
+const size_t VERTEX_COUNTS[] = {3, 4, 8, 16, 32, 64};
+const size_t VERTEX_COUNT_COUNT = sizeof(VERTEX_COUNTS) / sizeof(VERTEX_COUNTS[0]);
+
+// Two polygons with the same number of vertices
+typedef struct collision_bench {
+    list_t *shape1;
+    list_t *shape2;
+} collision_bench_t;
+
+void bench_find_collision(collision_bench_t *bench, size_t iterations) {
+    size_t collided = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        collided += find_collision(bench->shape1, bench->shape2).collided;
+    }
+    bench_sink = collided;
+}
+
+int main(int argc, char *argv[]) {
+    bench_begin("collision");
+    for (size_t i = 0; i < VERTEX_COUNT_COUNT; i++) {
+        size_t n = VERTEX_COUNTS[i];
+        collision_bench_t bench = {
+            .shape1 = polygon_reg_ngon(vec(0, 0), 10, n),
+            .shape2 = polygon_reg_ngon(vec(15, 3), 10, n)
+        };
+        // overlapping shapes have to check every axis
+        bench_run("find_collision_overlapping", n, (bench_func_t)bench_find_collision, &bench);
+        list_free(bench.shape2);
+
+        // far apart shapes can stop at the first separating axis
+        bench.shape2 = polygon_reg_ngon(vec(100, 3), 10, n);
+        bench_run("find_collision_separate", n, (bench_func_t)bench_find_collision, &bench);
+        list_free(bench.shape1);
+        list_free(bench.shape2);
+    }
+    bench_end();
+}
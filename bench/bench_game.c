@@ -0,0 +1,229 @@
+#include "aster_blaster_imports.h"
+#include "bench_util.h"
+#include <sys/resource.h>
+
+/**
+ * Runs the game's scene without a display, holding the number of asteroids,
+ * saws, shooters, black holes and bullets at a target, and reports how fast
+ * scene_tick() is as the targets grow.
+ *
+ *   bench_game [seconds] [asteroids saws shooters black_holes bullets]
+ *   bench_game --snapshot <file> [seconds]
+ *
+ * Each scale of the sweep multiplies the counts, which default to
+ * STRESS_BASE_COUNTS, and simulates the given number of seconds
+ * (STRESS_DEFAULT_SECONDS by default) in fixed steps.
+ * With a snapshot saved by `aster_blaster --snapshot`, the game instead
+ * starts from the saved frame and runs without spawning anything new
+ * besides the shooters' volleys.
+ */
+
+#define STRESS_KINDS 5
+#define STRESS_SCALES 5
+
+const body_type_e STRESS_TYPES[STRESS_KINDS] = {ASTEROID, ENEMY_SAW, ENEMY_SHOOTER, BLACK_HOLE, BULLET};
+const char *const STRESS_NAMES[STRESS_KINDS] = {"asteroids", "saws", "shooters", "black_holes", "bullets"};
+void (*const STRESS_SPAWNERS[STRESS_KINDS])(game_context_t *ctx) = {
+    spawn_asteroid_top, spawn_enemy_saw, spawn_enemy_shooter, spawn_black_hole, spawn_bullet};
+// Roughly what a busy moment of a real game looks like
+const size_t STRESS_BASE_COUNTS[STRESS_KINDS] = {20, 10, 4, 1, 20};
+const size_t STRESS_SCALE_FACTORS[STRESS_SCALES] = {1, 2, 4, 8, 16};
+const double STRESS_DEFAULT_SECONDS = 10;
+const double STRESS_DT = 1.0 / 120;
+// Simulated before timing starts, so the spawned bodies have spread out
+const double STRESS_WARM_UP_SECONDS = 1;
+// How far the player sweeps left and right of the middle, and how often
+const double STRESS_SWEEP_FRACTION = 0.4;
+const double STRESS_SWEEP_PERIOD = 4;
+const double STRESS_US_PER_NS = 1e-3;
+const double STRESS_NS_PER_S = 1e9;
+const double STRESS_NS_PER_MS = 1e6;
+
+/**
+ * Sets up a game's context, without any bodies or force creators.
+ * The scene keeps pointers to ctx, so it must not move until it is freed.
+ */
+void stress_context_init(game_context_t *ctx, const sdl_atlas_t *atlas, uint64_t seed) {
+    scene_t *scene = scene_init();
+    scene_set_kill_box(scene, KILL_BOX_MIN, KILL_BOX_MAX);
+    *ctx = (game_context_t){
+        .scene = scene,
+        .atlas = atlas,
+        .ast_sprites_list = ast_sprites_list_init(atlas),
+        .player = NULL,
+        .weapon_ready = true,
+        .boss = NULL,
+        .boss_tangible = false,
+        .shapes = shape_cache_init()};
+    seed_game(ctx, seed);
+    archetype_pools_init(ctx);
+}
+
+/**
+ * Sets up a game the way game_loop() does, with the player and every
+ * interaction and steering rule, but without any waves.
+ */
+void stress_game_init(game_context_t *ctx, const sdl_atlas_t *atlas, uint64_t seed) {
+    stress_context_init(ctx, atlas, seed);
+    wire_interactions(ctx, PHASE_ALWAYS);
+
+    body_t *health_bar = body_health_bar_init();
+    scene_add_body(ctx->scene, health_bar);
+    spawn_player(ctx, health_bar);
+    wire_enemy_steering(ctx);
+    scene_schedule(ctx->scene, ENEMY_SHOOTER_SHOT_RATE, (timer_callback_t)shooter_volley, ctx, NULL);
+}
+
+void stress_game_free(game_context_t *ctx) {
+    scene_free(ctx->scene);
+    archetype_pools_free(ctx);
+    shape_cache_free(ctx->shapes);
+}
+
+/**
+ * Spawns bodies of each kind until there are as many as its target,
+ * and moves the player so that bullets and enemies cover the screen.
+ */
+void stress_top_up(game_context_t *ctx, const size_t targets[STRESS_KINDS], double time) {
+    for (size_t i = 0; i < STRESS_KINDS; i++) {
+        for (size_t n = scene_tagged_bodies(ctx->scene, STRESS_TYPES[i]); n < targets[i]; n++) {
+            STRESS_SPAWNERS[i](ctx);
+        }
+    }
+    double sweep = STRESS_SWEEP_FRACTION * SDL_MAX.x * sin(2 * M_PI * time / STRESS_SWEEP_PERIOD);
+    body_set_centroid(ctx->player, vec_add(PLAYER_INIT_POS, vec_x(sweep)));
+    body_set_velocity(ctx->player, VEC_ZERO);
+}
+
+int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+double percentile(const double *sorted, size_t count, double p) {
+    return sorted[(size_t)(p * (count - 1))];
+}
+
+// The process's peak resident memory so far, in kilobytes
+long peak_memory_kb(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * Simulates a number of ticks, topping up the bodies to the targets
+ * before each one if there are targets, and prints the timings.
+ */
+void stress_time(game_context_t *ctx, const size_t *targets, double time, size_t ticks) {
+    double *tick_ns = malloc(ticks * sizeof(double));
+    assert(tick_ns != NULL);
+    double total_ns = 0;
+    double total_bodies = 0;
+    for (size_t i = 0; i < ticks; i++) {
+        if (targets != NULL) {
+            stress_top_up(ctx, targets, time);
+        }
+        total_bodies += scene_bodies(ctx->scene);
+        double start = bench_now_ns();
+        scene_tick(ctx->scene, STRESS_DT);
+        tick_ns[i] = bench_now_ns() - start;
+        total_ns += tick_ns[i];
+        time += STRESS_DT;
+    }
+    qsort(tick_ns, ticks, sizeof(double), compare_doubles);
+
+    printf("\"mean_bodies\": %.1f, \"ticks\": %zu, \"ticks_per_s\": %.1f, "
+           "\"p50_us\": %.3f, \"p90_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f, "
+           "\"peak_memory_kb\": %ld}",
+           total_bodies / ticks, ticks, ticks * STRESS_NS_PER_S / total_ns,
+           percentile(tick_ns, ticks, 0.5) * STRESS_US_PER_NS,
+           percentile(tick_ns, ticks, 0.9) * STRESS_US_PER_NS,
+           percentile(tick_ns, ticks, 0.99) * STRESS_US_PER_NS,
+           tick_ns[ticks - 1] * STRESS_US_PER_NS,
+           peak_memory_kb());
+    fflush(stdout);
+    free(tick_ns);
+}
+
+/**
+ * Simulates one scale of the sweep and prints its result.
+ */
+void stress_run(const sdl_atlas_t *atlas, const size_t targets[STRESS_KINDS], size_t scale, double seconds, bool first) {
+    game_context_t ctx;
+    stress_game_init(&ctx, atlas, HEADLESS_DEFAULT_SEED);
+    size_t warm_up_ticks = STRESS_WARM_UP_SECONDS / STRESS_DT;
+
+    double time = 0;
+    for (size_t i = 0; i < warm_up_ticks; i++) {
+        stress_top_up(&ctx, targets, time);
+        scene_tick(ctx.scene, STRESS_DT);
+        time += STRESS_DT;
+    }
+
+    printf("%s\n  {\"scale\": %zu, ", first ? "" : ",", scale);
+    for (size_t i = 0; i < STRESS_KINDS; i++) {
+        printf("\"%s\": %zu, ", STRESS_NAMES[i], targets[i]);
+    }
+    stress_time(&ctx, targets, time, seconds / STRESS_DT);
+    stress_game_free(&ctx);
+}
+
+/**
+ * Simulates the game from a snapshot and prints the result.
+ */
+int snapshot_run(const sdl_atlas_t *atlas, const char *path, double seconds) {
+    game_context_t ctx;
+    stress_context_init(&ctx, atlas, HEADLESS_DEFAULT_SEED);
+    double start = bench_now_ns();
+    if (!game_snapshot_load(&ctx, path)) {
+        stress_game_free(&ctx);
+        return 1;
+    }
+    double load_ms = (bench_now_ns() - start) / STRESS_NS_PER_MS;
+    scene_schedule(ctx.scene, ENEMY_SHOOTER_SHOT_RATE, (timer_callback_t)shooter_volley, &ctx, NULL);
+
+    printf("{\"suite\": \"game\", \"snapshot\": \"%s\", \"seconds\": %g, \"dt\": %g, "
+           "\"results\": [\n  {\"bodies\": %zu, \"load_ms\": %.3f, ",
+           path, seconds, STRESS_DT, scene_bodies(ctx.scene), load_ms);
+    stress_time(&ctx, NULL, 0, seconds / STRESS_DT);
+    printf("\n]}\n");
+    stress_game_free(&ctx);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    sdl_configure_headless(0, false);
+    backend_use(&HEADLESS_BACKEND);
+    backend_init(SDL_MIN, SDL_MAX);
+    sdl_atlas_t *atlas = backend_atlas_init(SPRITE_PATHS, SPRITE_COUNT);
+
+    if (argc > 2 && strcmp(argv[1], "--snapshot") == 0) {
+        double seconds = argc > 3 ? strtod(argv[3], NULL) : STRESS_DEFAULT_SECONDS;
+        assert(seconds >= STRESS_DT);
+        int status = snapshot_run(atlas, argv[2], seconds);
+        backend_atlas_free(atlas);
+        return status;
+    }
+
+    double seconds = argc > 1 ? strtod(argv[1], NULL) : STRESS_DEFAULT_SECONDS;
+    assert(seconds >= STRESS_DT);
+    size_t base_counts[STRESS_KINDS];
+    for (size_t i = 0; i < STRESS_KINDS; i++) {
+        base_counts[i] = argc > 2 + (int)i ? strtoul(argv[2 + i], NULL, 10) : STRESS_BASE_COUNTS[i];
+    }
+
+    // The peak memory only grows, so the sweep goes from smallest to largest
+    printf("{\"suite\": \"game\", \"seconds\": %g, \"dt\": %g, \"results\": [", seconds, STRESS_DT);
+    for (size_t i = 0; i < STRESS_SCALES; i++) {
+        size_t targets[STRESS_KINDS];
+        for (size_t j = 0; j < STRESS_KINDS; j++) {
+            targets[j] = base_counts[j] * STRESS_SCALE_FACTORS[i];
+        }
+        stress_run(atlas, targets, STRESS_SCALE_FACTORS[i], seconds, i == 0);
+    }
+    printf("\n]}\n");
+
+    backend_atlas_free(atlas);
+}
@@ -0,0 +1,73 @@
+#include "bench_util.h"
+#include "list.h"
+#include <stdlib.h>
+
+const size_t LIST_SIZES[] = {10, 100, 1000, 10000};
+const size_t LIST_SIZE_COUNT = sizeof(LIST_SIZES) / sizeof(LIST_SIZES[0]);
+
+// A list that holds size items, all pointing at one value
+typedef struct list_bench {
+    list_t *list;
+    size_t size;
+    int value;
+} list_bench_t;
+
+// Adds to a list, starting over once it holds size items
+void bench_list_add(list_bench_t *bench, size_t iterations) {
+    list_t *list = list_init(1, NULL);
+    for (size_t i = 0; i < iterations; i++) {
+        if (list_size(list) == bench->size) {
+            list_free(list);
+            list = list_init(1, NULL);
+        }
+        list_add(list, &bench->value);
+    }
+    bench_sink = list_size(list);
+    list_free(list);
+}
+
+// Removes the first item, which moves every other one, and adds it back
+void bench_list_remove_front(list_bench_t *bench, size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        list_add(bench->list, list_remove(bench->list, 0));
+    }
+    bench_sink = list_size(bench->list);
+}
+
+// Removes the first item by moving the last into its place, and adds it back
+void bench_list_swap_remove(list_bench_t *bench, size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        list_add(bench->list, list_swap_remove(bench->list, 0));
+    }
+    bench_sink = list_size(bench->list);
+}
+
+// Looks for an item that is in the middle of the list
+void bench_list_contains(list_bench_t *bench, size_t iterations) {
+    void *middle = list_get(bench->list, bench->size / 2);
+    size_t found = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        found += list_contains(bench->list, middle);
+    }
+    bench_sink = found;
+}
+
+int main(int argc, char *argv[]) {
+    bench_begin("list");
+    for (size_t i = 0; i < LIST_SIZE_COUNT; i++) {
+        list_bench_t bench = {.size = LIST_SIZES[i], .value = 0};
+        bench.list = list_init(bench.size, free);
+        for (size_t j = 0; j < bench.size; j++) {
+            int *value = malloc(sizeof(int));
+            *value = j;
+            list_add(bench.list, value);
+        }
+
+        bench_run("list_add", bench.size, (bench_func_t)bench_list_add, &bench);
+        bench_run("list_remove_front", bench.size, (bench_func_t)bench_list_remove_front, &bench);
+        bench_run("list_swap_remove", bench.size, (bench_func_t)bench_list_swap_remove, &bench);
+        bench_run("list_contains", bench.size, (bench_func_t)bench_list_contains, &bench);
+        list_free(bench.list);
+    }
+    bench_end();
+}
@@ -0,0 +1,101 @@
+#include "bench_util.h"
+#include "polygon.h"
+#include "vector.h"
+#include <math.h>
+#include <stdlib.h>
+
+const size_t VERTEX_COUNTS[] = {3, 4, 8, 16, 32, 64};
+const size_t VERTEX_COUNT_COUNT = sizeof(VERTEX_COUNTS) / sizeof(VERTEX_COUNTS[0]);
+// Number of vectors the vec_* benchmarks cycle through
+#define VECTOR_COUNT 256
+
+typedef struct vector_bench {
+    vector_t vectors[VECTOR_COUNT];
+} vector_bench_t;
+
+void bench_vec_add(vector_bench_t *bench, size_t iterations) {
+    vector_t sum = VEC_ZERO;
+    for (size_t i = 0; i < iterations; i++) {
+        sum = vec_add(sum, bench->vectors[i % VECTOR_COUNT]);
+    }
+    bench_sink = sum.x + sum.y;
+}
+
+void bench_vec_rotate(vector_bench_t *bench, size_t iterations) {
+    double total = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        total += vec_rotate(bench->vectors[i % VECTOR_COUNT], 0.1).x;
+    }
+    bench_sink = total;
+}
+
+void bench_vec_normalize(vector_bench_t *bench, size_t iterations) {
+    double total = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        total += vec_normalize(bench->vectors[i % VECTOR_COUNT]).y;
+    }
+    bench_sink = total;
+}
+
+void bench_vec_dot(vector_bench_t *bench, size_t iterations) {
+    double total = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        total += vec_dot(bench->vectors[i % VECTOR_COUNT], bench->vectors[(i + 1) % VECTOR_COUNT]);
+    }
+    bench_sink = total;
+}
+
+void bench_polygon_rotate(list_t *polygon, size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        polygon_rotate(polygon, 0.01, VEC_ZERO);
+    }
+    bench_sink = ((vector_t *)list_get(polygon, 0))->x;
+}
+
+void bench_polygon_translate(list_t *polygon, size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        // alternate so the polygon stays put
+        polygon_translate(polygon, i % 2 == 0 ? vec(1, 1) : vec(-1, -1));
+    }
+    bench_sink = ((vector_t *)list_get(polygon, 0))->x;
+}
+
+void bench_polygon_centroid(list_t *polygon, size_t iterations) {
+    double total = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        total += polygon_centroid(polygon).x;
+    }
+    bench_sink = total;
+}
+
+void bench_polygon_area(list_t *polygon, size_t iterations) {
+    double total = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        total += polygon_area(polygon);
+    }
+    bench_sink = total;
+}
+
+int main(int argc, char *argv[]) {
+    bench_begin("polygon");
+
+    vector_bench_t vectors;
+    for (size_t i = 0; i < VECTOR_COUNT; i++) {
+        vectors.vectors[i] = vec(cos(i) * (i + 1), sin(i) * (i + 1));
+    }
+    bench_run("vec_add", 1, (bench_func_t)bench_vec_add, &vectors);
+    bench_run("vec_rotate", 1, (bench_func_t)bench_vec_rotate, &vectors);
+    bench_run("vec_normalize", 1, (bench_func_t)bench_vec_normalize, &vectors);
+    bench_run("vec_dot", 1, (bench_func_t)bench_vec_dot, &vectors);
+
+    for (size_t i = 0; i < VERTEX_COUNT_COUNT; i++) {
+        size_t n = VERTEX_COUNTS[i];
+        list_t *polygon = polygon_reg_ngon(vec(50, 50), 10, n);
+        bench_run("polygon_rotate", n, (bench_func_t)bench_polygon_rotate, polygon);
+        bench_run("polygon_translate", n, (bench_func_t)bench_polygon_translate, polygon);
+        bench_run("polygon_centroid", n, (bench_func_t)bench_polygon_centroid, polygon);
+        bench_run("polygon_area", n, (bench_func_t)bench_polygon_area, polygon);
+        list_free(polygon);
+    }
+    bench_end();
+}
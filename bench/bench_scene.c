@@ -0,0 +1,81 @@
+#include "bench_util.h"
+#include "forces.h"
+#include "polygon.h"
+#include "scene.h"
+#include <math.h>
+#include <stdlib.h>
+
+const size_t VERTEX_COUNTS[] = {3, 4, 8, 16, 32, 64};
+const size_t VERTEX_COUNT_COUNT = sizeof(VERTEX_COUNTS) / sizeof(VERTEX_COUNTS[0]);
+const size_t BODY_COUNTS[] = {10, 100, 1000, 10000};
+const size_t BODY_COUNT_COUNT = sizeof(BODY_COUNTS) / sizeof(BODY_COUNTS[0]);
+// Every pair is checked, so colliding scenes stop at fewer bodies
+const size_t MAX_COLLIDING_BODIES = 1000;
+const double BENCH_DT = 1.0 / 60;
+const size_t BALL_TAG = 0;
+const size_t BALL_VERTICES = 8;
+const double BALL_RADIUS = 2;
+// Size of the square the bodies are spread over
+const double ARENA_SIZE = 1000;
+
+void bench_body_tick(body_t *body, size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        body_tick(body, BENCH_DT);
+    }
+    bench_sink = body_get_centroid(body).x;
+}
+
+void bench_scene_tick(scene_t *scene, size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        scene_tick(scene, BENCH_DT);
+    }
+    bench_sink = scene_bodies(scene);
+}
+
+/**
+ * Makes a scene of bodies spread evenly over the arena,
+ * spinning and moving slowly in different directions.
+ */
+scene_t *make_scene(size_t bodies, bool colliding) {
+    scene_t *scene = scene_init();
+    size_t columns = ceil(sqrt(bodies));
+    double spacing = ARENA_SIZE / columns;
+    for (size_t i = 0; i < bodies; i++) {
+        vector_t center = vec((i % columns) * spacing, (i / columns) * spacing);
+        body_t *body = body_init(polygon_reg_ngon(center, BALL_RADIUS, BALL_VERTICES), 1, (rgb_color_t){1, 1, 1});
+        body_set_tag(body, BALL_TAG);
+        body_set_velocity(body, vec_rotate(vec(10, 0), i));
+        body_set_omega(body, 1);
+        scene_add_body(scene, body);
+    }
+    if (colliding) {
+        create_pair_physics_collision(scene, 1, BALL_TAG, BALL_TAG);
+    }
+    return scene;
+}
+
+int main(int argc, char *argv[]) {
+    bench_begin("scene");
+    for (size_t i = 0; i < VERTEX_COUNT_COUNT; i++) {
+        size_t n = VERTEX_COUNTS[i];
+        body_t *body = body_init(polygon_reg_ngon(VEC_ZERO, 10, n), 1, (rgb_color_t){1, 1, 1});
+        body_set_velocity(body, vec(1, 2));
+        body_set_omega(body, 0.5);
+        bench_run("body_tick", n, (bench_func_t)bench_body_tick, body);
+        body_free(body);
+    }
+
+    for (size_t i = 0; i < BODY_COUNT_COUNT; i++) {
+        size_t bodies = BODY_COUNTS[i];
+        scene_t *scene = make_scene(bodies, false);
+        bench_run("scene_tick", bodies, (bench_func_t)bench_scene_tick, scene);
+        scene_free(scene);
+
+        if (bodies <= MAX_COLLIDING_BODIES) {
+            scene = make_scene(bodies, true);
+            bench_run("scene_tick_colliding", bodies, (bench_func_t)bench_scene_tick, scene);
+            scene_free(scene);
+        }
+    }
+    bench_end();
+}
@@ -4,19 +4,118 @@ void menu_loop();
 void game_loop();
 void victory_loop();
 void control_loop(); // TODO: later
+void replay_loop();
+void first_loop();
+
+// Seed of the next game; each game after it gets the following seed
+uint64_t game_seed;
+// Where the games are recorded, or NULL if they aren't
+replay_t *recording = NULL;
+// The recording being replayed, or NULL when the games are played by hand
+replay_t *playback = NULL;
+// Where the busiest frame is saved, or NULL if it isn't
+const char *snapshot_path = NULL;
+// The number of bodies in the frame that was saved
+size_t snapshot_bodies = 0;
+// The sprites of every game, loaded before the backend starts the games
+sdl_atlas_t *atlas = NULL;
+
+/**
+ * Runs the game in a window, or without a display when started as
+ * `aster_blaster --headless [frames] [--rasterize]`.
+ * Headless runs stop after the given number of frames
+ * and print how long they took.
+ * Either can end with `--seed <seed>` to replay the same games.
+ * Otherwise windowed games are seeded from the time,
+ * and headless games with HEADLESS_DEFAULT_SEED.
+ * `--record <file>` writes each game's seed and input to a file,
+ * and `--replay <file>` plays the recorded games again, without the menus
+ * and ignoring the keyboard, e.g. to profile the same games across builds.
+ * `--snapshot <file>` saves the frame with the most bodies so far,
+ * which `bench_game --snapshot <file>` can start from.
+ * Builds with the profiler (`make PROFILE=1`) write the recent frame times
+ * and a trace to PROFILE_CSV_PATH and PROFILE_TRACE_PATH on exit, and the
+ * collision counters of each pair of body_type_e tags to PROFILE_PAIRS_CSV_PATH.
+ * Builds that track allocations (`make ALLOC_TRACK=1`) print them on exit.
+ */
+int main(int argc, char **argv) {
+    game_seed = time(NULL);
+    bool seeded = false;
+    // options with a value come last, in any order
+    while (argc > 2) {
+        const char *option = argv[argc - 2];
+        const char *value = argv[argc - 1];
+        if (strcmp(option, "--seed") == 0) {
+            game_seed = strtoull(value, NULL, 10);
+            seeded = true;
+        } else if (strcmp(option, "--record") == 0) {
+            recording = replay_record(value);
+            if (recording == NULL) {
+                return 1;
+            }
+        } else if (strcmp(option, "--replay") == 0) {
+            playback = replay_load(value);
+            if (playback == NULL) {
+                return 1;
+            }
+        } else if (strcmp(option, "--snapshot") == 0) {
+            snapshot_path = value;
+        } else {
+            break;
+        }
+        argc -= 2;
+    }
+    if (!seeded && argc > 1 && strcmp(argv[1], "--headless") == 0) {
+        game_seed = HEADLESS_DEFAULT_SEED;
+    }
 
-int main() {
-    sdl_init(SDL_MIN, SDL_MAX);
-    sdl_set_font(&FONT_PATH_ASTER_BLASTER[0]);
-    init_random();
-    menu_loop();
+    backend_use(&SDL_BACKEND);
+    if (argc > 1 && strcmp(argv[1], "--headless") == 0) {
+        size_t frames = argc > 2 ? strtoul(argv[2], NULL, 10) : HEADLESS_DEFAULT_FRAMES;
+        bool rasterize = argc > 3 && strcmp(argv[3], "--rasterize") == 0;
+        sdl_configure_headless(frames, rasterize);
+        backend_use(&HEADLESS_BACKEND);
+    }
+    backend_init(SDL_MIN, SDL_MAX);
+    backend_set_frame_rate(TARGET_FRAME_RATE);
+    backend_set_font(&FONT_PATH_ASTER_BLASTER[0]);
+    atlas = backend_atlas_init(SPRITE_PATHS, SPRITE_COUNT);
+    backend_run(first_loop);
+    backend_atlas_free(atlas);
+    if (playback != NULL) {
+        replay_free(playback);
+        // a headless replay can end before its frame limit
+        sdl_headless_report();
+    }
+    if (recording != NULL && !replay_free(recording)) {
+        printf("Unable to finish the recording!\n");
+    }
+#ifdef PROFILER
+    profiler_write_csv(PROFILE_CSV_PATH);
+    profiler_write_trace(PROFILE_TRACE_PATH);
+    profiler_write_pairs_csv(PROFILE_PAIRS_CSV_PATH);
+#endif
+#ifdef ALLOC_TRACK
+    alloc_track_report();
+#endif
+}
+
+/**
+ * Starts at the menu, or with the first game of the replay if there is one.
+ */
+void first_loop() {
+    if (playback != NULL) {
+        replay_loop();
+    } else {
+        menu_loop();
+    }
 }
 
 void menu_loop() {
-    sdl_set_background_color(COLOR_WHITE);
+    backend_set_background_color(COLOR_WHITE);
     scene_t *scene = scene_init();
 
-    sdl_on_key((key_handler_t)on_key_menu);
+    backend_on_key((key_handler_t)on_key_menu);
 
     menu_keypress_aux_t *menu_keypress_aux = malloc(sizeof(menu_keypress_aux_t));
     menu_keypress_aux->scene = scene;
@@ -30,8 +129,8 @@ void menu_loop() {
     scene_add_text_box(scene, menu_game_start_text_box);
 
     bool to_game = false;
-    while (!sdl_is_done(menu_keypress_aux)) {
-        double dt = time_since_last_tick();
+    while (!backend_is_done(menu_keypress_aux)) {
+        double dt = backend_time_since_last_tick();
 
         if (menu_keypress_aux->window == GAME) {
             to_game = true;
@@ -39,7 +138,7 @@ void menu_loop() {
         }
 
         scene_tick(scene, dt);
-        sdl_render_scene(scene);
+        backend_render_scene(scene);
     }
 
     free(menu_keypress_aux);
@@ -51,10 +150,10 @@ void menu_loop() {
 }
 
 void victory_loop() {
-    sdl_set_background_color(COLOR_WHITE);
+    backend_set_background_color(COLOR_WHITE);
     scene_t *scene = scene_init();
 
-    sdl_on_key((key_handler_t)on_key_victory);
+    backend_on_key((key_handler_t)on_key_victory);
 
     menu_keypress_aux_t *menu_keypress_aux = malloc(sizeof(menu_keypress_aux_t));
     menu_keypress_aux->scene = scene;
@@ -70,8 +169,8 @@ void victory_loop() {
 
     bool to_game = false;
     bool to_menu = false;
-    while (!sdl_is_done(menu_keypress_aux)) {
-        double dt = time_since_last_tick();
+    while (!backend_is_done(menu_keypress_aux)) {
+        double dt = backend_time_since_last_tick();
 
         if (menu_keypress_aux->window == GAME) {
             to_game = true;
@@ -84,7 +183,7 @@ void victory_loop() {
         }
 
         scene_tick(scene, dt);
-        sdl_render_scene(scene);
+        backend_render_scene(scene);
     }
 
     free(menu_keypress_aux);
@@ -99,11 +198,12 @@ void victory_loop() {
 }
 
 void game_loop() {
-    sdl_set_background_color(COLOR_BLACK);
+    backend_set_background_color(COLOR_BLACK);
 
     scene_t *scene = scene_init();
+    scene_reserve(scene, GAME_BODY_CAPACITY, GAME_CONTACT_CAPACITY);
 
-    sdl_on_key((key_handler_t)on_key_game);
+    backend_on_key((key_handler_t)on_key_game);
 
     // using ASTEROID_RADIUS for bounds because it's maximum size
     // TODO: make a new variable for this?
@@ -113,39 +213,61 @@ void game_loop() {
         .left = body_init(polygon_rect(vec(SDL_MIN.x - 3 * ASTEROID_RADIUS_MAX, SDL_MIN.y), ASTEROID_RADIUS_MAX, SDL_MAX.y), INFINITY, COLOR_BLACK),
         .right = body_init(polygon_rect(vec(SDL_MAX.x + ASTEROID_RADIUS_MAX, SDL_MIN.y), ASTEROID_RADIUS_MAX, SDL_MAX.y), INFINITY, COLOR_BLACK)};
 
+    body_set_layer(bounds.left, LAYER_BACKDROP);
+    body_set_layer(bounds.right, LAYER_BACKDROP);
+    body_set_layer(bounds.top, LAYER_BACKDROP);
+    body_set_layer(bounds.bottom, LAYER_BACKDROP);
+    scene_set_kill_box(scene, KILL_BOX_MIN, KILL_BOX_MAX);
     scene_add_body(scene, bounds.left);
     scene_add_body(scene, bounds.right);
     scene_add_body(scene, bounds.top);
     scene_add_body(scene, bounds.bottom);
 
-    // Boss movement triggers (made before stars so they aren't seen)
+    // Boss movement triggers (drawn behind the stars so they aren't seen)
     list_t *boss_movement_trigger_shape = polygon_rect(vec(SDL_MIN.x, 0.5 * SDL_MAX.y), SDL_MAX.x, BOSS_OUT_RADIUS);
     body_t *boss_movement_trigger = body_init(boss_movement_trigger_shape, INFINITY, COLOR_BLACK);
     list_t *boss_right_trigger_shape = polygon_rect(vec(SDL_MIN.x, SDL_MIN.y), 0.125 * SDL_MAX.x, SDL_MAX.y);
     body_t *boss_right_trigger = body_init(boss_right_trigger_shape, INFINITY, COLOR_BLACK);
     list_t *boss_left_trigger_shape = polygon_rect(vec(0.875 * SDL_MAX.x, SDL_MIN.y), 0.125 * SDL_MAX.x, SDL_MAX.y);
     body_t *boss_left_trigger = body_init(boss_left_trigger_shape, INFINITY, COLOR_BLACK);
+    body_set_layer(boss_movement_trigger, LAYER_BACKDROP);
+    body_set_layer(boss_left_trigger, LAYER_BACKDROP);
+    body_set_layer(boss_right_trigger, LAYER_BACKDROP);
     scene_add_body(scene, boss_movement_trigger);
     scene_add_body(scene, boss_left_trigger);
     scene_add_body(scene, boss_right_trigger);
 
-    // when stars collide with this offscreen they'll teleport to just off the
-    // top of the scene so it loops
-    // TODO: magic numbers
-    body_t *star_bound = body_init(polygon_rect(vec(SDL_MIN.x, SDL_MIN.y - 6 * STAR_RADIUS_MAX), SDL_MAX.x, 2 * STAR_RADIUS_MAX), INFINITY, COLOR_BLACK);
-    create_background_stars(scene, star_bound);
-
     // health bar
     body_t *health_bar_background = body_health_bar_background_init();
     body_t *health_bar = body_health_bar_init();
     scene_add_body(scene, health_bar_background);
     scene_add_body(scene, health_bar);
 
-    SDL_Texture *player_texture = sdl_load_texture("./assets/ship.png");
+    game_context_t ctx = {
+        .scene = scene,
+        .bounds = bounds,
+        .atlas = atlas,
+        .ast_sprites_list = ast_sprites_list_init(atlas),
+        .player = NULL,
+        .weapon_ready = true,
+        .boss_triggers = {
+            .movement = boss_movement_trigger,
+            .left = boss_left_trigger,
+            .right = boss_right_trigger},
+        .boss = NULL,
+        .boss_tangible = false,
+        .shapes = shape_cache_init()};
+    if (recording != NULL) {
+        replay_record_game(recording, game_seed);
+    }
+    seed_game(&ctx, game_seed++);
+    create_background_stars(&ctx);
+    archetype_pools_init(&ctx);
+    wire_interactions(&ctx, PHASE_ALWAYS);
+
     // player
-    body_t *player = body_init_player(health_bar, render_texture(player_texture, PLAYER_RADIUS * 1.5, PLAYER_RADIUS * 1.2));
-    body_set_manual_acceleration(player, true);
-    scene_add_body(scene, player);
+    body_t *player = spawn_player(&ctx, health_bar);
+    wire_enemy_steering(&ctx);
     aster_aux_t *player_aux = body_get_info(player);
 
     // keypress aux
@@ -156,123 +278,22 @@ void game_loop() {
     game_keypress_aux->window = GAME;
 
 
-    bool boss_tangible = false;
+    schedule_environment_waves(&ctx);
+    schedule_enemy_waves(&ctx);
 
     size_t frame = 0;
-    double ast_time = 0;
-    double bh_time = 0;
-    double bullet_time = BULLET_COOLDOWN; // time since last bullet being fired
-    double saw_time = 0;
-    double shooter_spawn_time = 0;
-    double shooter_shot_time = 0;
-    double boss_spawn_time = 0;
-    double boss_shot_time = 0;
-
     bool to_menu = false;
     bool to_victory = false;
+    bool out_of_input = false;
 
-    ast_sprites_list_t ast_sprites_list = {
-        .circle = sdl_load_texture("./assets/circle.png"),
-        .heptagon = sdl_load_texture("./assets/heptagon.png"),
-        .hexagon = sdl_load_texture("./assets/hexagon.png"),
-        .pentagon = sdl_load_texture("./assets/pentagon.png"),
-        // .ship = sdl_load_texture("./assets/ship.png"),
-    };
-
-    SDL_Texture *blackhole_texture = sdl_load_texture("./assets/blackhole.png");
-    SDL_Texture *boss_alien_texture = sdl_load_texture("./assets/boss_alien.png");
-    SDL_Texture *saw_alien_texture = sdl_load_texture("./assets/saw_alien.png");
-    SDL_Texture *shooting_alien_texture = sdl_load_texture("./assets/shooting_alien.png");
-
-    list_t *boss_bombs = list_init(1, NULL);
-
-    double saw_spawn_rate = rate_variant(ENEMY_SAW_SPAWN_RATE);
-    double shooter_spawn_rate = rate_variant(ENEMY_SHOOTER_SPAWN_RATE);
-    double shooter_shot_rate = rate_variant(ENEMY_SHOOTER_SHOT_RATE);
-    double boss_shot_rate = rate_variant(BOSS_SHOT_RATE);
-    aster_aux_t *boss_aux = NULL;
-
-    while (!sdl_is_done(game_keypress_aux)) {
-        double dt = time_since_last_tick();
-        ast_time += dt;
-        bh_time += dt;
-        bullet_time += dt;
-        saw_time += dt;
-        shooter_spawn_time += dt;
-        shooter_shot_time += dt;
-        boss_spawn_time += dt;
-        boss_shot_time += dt;
-
-        if (boss_spawn_time >= BOSS_SPAWN_TIME && !boss_tangible) {
-            spawn_boss(scene, boss_movement_trigger, boss_left_trigger, boss_right_trigger, &boss_tangible, boss_alien_texture);
-            boss_spawn_time = 0;
-            boss_shot_time = 0;
-            boss_aux = body_get_info(scene_get_body(scene, scene_bodies(scene) - 1));
-        }
-
-        //ast_time completely resets when an asteroid spawns
-        //and decreases by half when it's met without an asteroid spawning
-        if (ast_time >= ASTEROID_SPAWN_RATE) {
-            ast_time = ASTEROID_SPAWN_RATE / 2;
-            double spawn_chance = drand48();
-
-            // If boss is present the chance of spawning is halved and the spawn_chance
-            // stops increasing when an asteroid doesn't spawn
-            if (boss_tangible) {
-                spawn_chance *= 2;
-                ast_time = 0;
-            }
-
-            if (spawn_chance < ASTEROID_SPAWN_CHANCE) {
-                ast_time = 0;
-                spawn_asteroid_top(scene, bounds, ast_sprites_list);
-            }
-        }
+#ifdef ALLOC_TRACK
+    // spawning the game allocates, so the budget starts after the warm-up
+    alloc_track_set_budget(SIZE_MAX);
+#endif
+    while (!backend_is_done(game_keypress_aux)) {
+        double dt = backend_time_since_last_tick();
 
-        // bh_time completely resets when an black hole spawns
-        // and decreases by half when it's met without an black hole spawning
-        // Black holes don't spawn when the boss is present.
-        if (!boss_tangible && bh_time >= BLACK_HOLE_SPAWN_RATE) {
-            bh_time = BLACK_HOLE_SPAWN_RATE / 2;
-            double spawn_chance = drand48();
-            if (spawn_chance < BLACK_HOLE_SPAWN_CHANCE) {
-                bh_time = 0;
-                spawn_black_hole(scene, bounds, blackhole_texture);
-            }
-        }
-
-        if (saw_time >= saw_spawn_rate) {
-            size_t to_spawn = irand_range(ENEMY_SAW_SWARM_SIZE_MIN, ENEMY_SAW_SWARM_SIZE_MAX);
-            for (size_t i = 0; i < to_spawn; i++) {
-                spawn_enemy_saw(scene, player, saw_alien_texture);
-            }
-            saw_time = 0;
-            saw_spawn_rate = rate_variant(ENEMY_SAW_SPAWN_RATE);
-        }
-
-        if (shooter_spawn_time >= shooter_spawn_rate) {
-            spawn_enemy_shooter(scene, player, shooting_alien_texture);
-            shooter_spawn_time = 0;
-            shooter_spawn_rate = rate_variant(ENEMY_SHOOTER_SPAWN_RATE);
-        }
-
-        if (shooter_shot_time >= shooter_shot_rate) {
-            shooter_enemy_all_shoot(scene, player, bounds, ast_sprites_list);
-            shooter_shot_time = 0;
-            shooter_shot_rate = rate_variant(ENEMY_SHOOTER_SHOT_RATE);
-        }
-
-        if (boss_tangible && boss_shot_time >= BOSS_SHOT_RATE) {
-            spawn_boss_bomb(scene, bounds, ast_sprites_list, boss_bombs);
-            boss_shot_time = 0;
-            boss_shot_rate = rate_variant(BOSS_SHOT_RATE);
-        }
-
-        for (size_t i = 0; i < list_size(boss_bombs); i++) {
-            boss_bomb_tick(scene, list_get(boss_bombs, i), dt, bounds, ast_sprites_list, boss_bombs);
-        }
-
-        if (boss_tangible && boss_aux->game_over) {
+        if (ctx.boss_tangible && ((aster_aux_t *)body_get_info(ctx.boss))->game_over) {
             to_victory = true;
             break;
         }
@@ -286,24 +307,51 @@ void game_loop() {
             print_bits(game_keypress_aux->key_down);
         } */
 
+        // a replay's input takes the place of the keyboard and the clock
+        if (playback != NULL &&
+            !replay_next_tick(playback, &game_keypress_aux->key_down, &dt)) {
+            out_of_input = true;
+            break;
+        }
+        if (recording != NULL) {
+            replay_record_tick(recording, game_keypress_aux->key_down, dt);
+        }
+
+        PROFILE_BEGIN(ZONE_FRAME);
         velocity_handle(player, game_keypress_aux->key_down, bounds);
-        shoot_handle(scene, player, &bullet_time, game_keypress_aux->key_down, bounds, ast_sprites_list, boss_tangible);
+        shoot_handle(&ctx, game_keypress_aux->key_down);
 
         scene_tick(scene, dt);
-        sdl_render_scene(scene);
+        backend_render_scene(scene);
+        PROFILE_END(ZONE_FRAME);
+        PROFILE_FRAME_END();
+        ALLOC_FRAME_END();
+        if (snapshot_path != NULL && frame % SNAPSHOT_CHECK_FRAMES == 0 &&
+            scene_bodies(scene) > snapshot_bodies) {
+            snapshot_bodies = scene_bodies(scene);
+            game_snapshot_save(&ctx, snapshot_path);
+            ALLOC_FRAME_EXEMPT();
+        }
+#ifdef ALLOC_TRACK
+        if (frame == ALLOC_BUDGET_WARM_UP_FRAMES) {
+            alloc_track_set_budget(ALLOC_FRAME_BUDGET);
+        }
+#endif
         frame++;
     }
 
     free(game_keypress_aux);
     scene_free(scene);
-    list_free(boss_bombs);
-    destroy_ast_sprite_list(ast_sprites_list);
-    SDL_DestroyTexture(player_texture);
-    SDL_DestroyTexture(blackhole_texture);
-    SDL_DestroyTexture(saw_alien_texture);
-    SDL_DestroyTexture(shooting_alien_texture);
-    SDL_DestroyTexture(boss_alien_texture);
+    archetype_pools_free(&ctx);
+    shape_cache_free(ctx.shapes);
 
+    if (playback != NULL) {
+        // replays skip the menus between games
+        if (to_menu || to_victory || out_of_input) {
+            replay_loop();
+        }
+        return;
+    }
     if (to_menu) {
         menu_loop();
     }
@@ -311,3 +359,14 @@ void game_loop() {
         victory_loop();
     }
 }
+
+/**
+ * Plays the next game of the replay, if there is one.
+ */
+void replay_loop() {
+    uint64_t seed;
+    if (replay_next_game(playback, &seed)) {
+        game_seed = seed;
+        game_loop();
+    }
+}
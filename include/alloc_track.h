@@ -0,0 +1,148 @@
+#ifndef __ALLOC_TRACK_H__
+#define __ALLOC_TRACK_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/**
+ * What the engine allocates memory for.
+ */
+typedef enum alloc_site {
+    ALLOC_BODY,
+    // the unit shapes in a shape_cache_t
+    ALLOC_SHAPE,
+    // vectors allocated with vec_alloc(), e.g. the vertices of a shape,
+    // and the vertex buffers of bodies built from a template
+    ALLOC_VERTEX,
+    // the force creators of a scene
+    ALLOC_BUNDLE,
+    // the aux values of forces, collisions, bodies and timers
+    ALLOC_AUX,
+    // a list and its array
+    ALLOC_LIST,
+    // scenes, their tag indexes and timers, pools and text boxes
+    ALLOC_OTHER,
+    ALLOC_SITE_COUNT
+} alloc_site_e;
+
+/**
+ * What one site allocated and freed.
+ */
+typedef struct alloc_stats {
+    // calls to malloc() and realloc()
+    size_t allocs;
+    // bytes asked for by those calls
+    size_t bytes;
+    // calls to free() made directly by the engine. Memory freed through
+    // a free_func_t, like the elements of a list, is not counted.
+    size_t frees;
+} alloc_stats_t;
+
+/**
+ * The engine allocates through these macros. Allocations are only counted
+ * when ALLOC_TRACK is defined, e.g. with `make ALLOC_TRACK=1`;
+ * otherwise they are plain calls to malloc(), realloc() and free().
+ * Only the game thread's allocations are instrumented.
+ */
+#ifdef ALLOC_TRACK
+#define TRACKED_MALLOC(site, size) alloc_track_malloc(site, size)
+#define TRACKED_REALLOC(site, ptr, size) alloc_track_realloc(site, ptr, size)
+#define TRACKED_FREE(site, ptr) alloc_track_free(site, ptr)
+#define ALLOC_FRAME_END() alloc_track_frame_end()
+#define ALLOC_FRAME_EXEMPT() alloc_track_exempt_frame()
+#else
+#define TRACKED_MALLOC(site, size) malloc(size)
+#define TRACKED_REALLOC(site, ptr, size) realloc(ptr, size)
+#define TRACKED_FREE(site, ptr) free(ptr)
+#define ALLOC_FRAME_END() ((void)0)
+#define ALLOC_FRAME_EXEMPT() ((void)0)
+#endif
+
+/**
+ * Calls malloc() and counts the allocation for a site.
+ * Use TRACKED_MALLOC() instead, so it is compiled out of normal builds.
+ */
+void *alloc_track_malloc(alloc_site_e site, size_t size);
+
+/**
+ * Calls realloc() and counts the allocation for a site.
+ * Use TRACKED_REALLOC() instead, so it is compiled out of normal builds.
+ */
+void *alloc_track_realloc(alloc_site_e site, void *ptr, size_t size);
+
+/**
+ * Calls free() and counts it for a site.
+ * Use TRACKED_FREE() instead, so it is compiled out of normal builds.
+ */
+void alloc_track_free(alloc_site_e site, void *ptr);
+
+/**
+ * Ends the current frame: what each site did since the last call becomes
+ * the last frame's stats and a new frame starts.
+ * Asserts that the frame kept within the budget, if one is set
+ * and the frame isn't exempt.
+ */
+void alloc_track_frame_end(void);
+
+/**
+ * Exempts the current frame from the budget, for one-off events that
+ * build what can't be pooled, like the arrival of a boss.
+ * Its allocations are still counted.
+ * Use ALLOC_FRAME_EXEMPT() instead, so it is compiled out of normal builds.
+ */
+void alloc_track_exempt_frame(void);
+
+/**
+ * Sets the most allocations, over all sites, that a frame may make
+ * before alloc_track_frame_end() fails its assertion.
+ * Meant to be set once the game loop reaches a steady state,
+ * e.g. 0 to check that it doesn't allocate at all.
+ *
+ * @param max_allocs the budget per frame, or SIZE_MAX for none
+ */
+void alloc_track_set_budget(size_t max_allocs);
+
+/**
+ * Gets what a site did in the last frame that ended.
+ *
+ * @param site the site
+ * @return its allocations, bytes and frees in that frame
+ */
+alloc_stats_t alloc_track_frame(alloc_site_e site);
+
+/**
+ * Gets what a site has done since the start or the last reset.
+ *
+ * @param site the site
+ * @return its total allocations, bytes and frees
+ */
+alloc_stats_t alloc_track_total(alloc_site_e site);
+
+/**
+ * Gets the number of frames ended since the start or the last reset.
+ *
+ * @return the number of calls to alloc_track_frame_end()
+ */
+size_t alloc_track_frames(void);
+
+/**
+ * Forgets every count and removes the budget.
+ */
+void alloc_track_reset(void);
+
+/**
+ * Gets the name of a site, e.g. "body".
+ *
+ * @param site the site
+ * @return the name, which must not be freed
+ */
+const char *alloc_site_name(alloc_site_e site);
+
+/**
+ * Prints a table of each site's totals, its average per frame
+ * and its most allocations in a single frame.
+ */
+void alloc_track_report(void);
+
+#endif // #ifndef __ALLOC_TRACK_H__
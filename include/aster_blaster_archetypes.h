@@ -0,0 +1,102 @@
+#ifndef __ASTER_BLASTER_ARCHETYPES__
+#define __ASTER_BLASTER_ARCHETYPES__
+
+#include "aster_blaster_imports.h"
+
+// Which polygon_*() function builds an archetype's shape
+typedef enum shape_kind {
+    SHAPE_NGON,
+    SHAPE_STAR,
+    SHAPE_RECT,
+    SHAPE_SECTOR
+} shape_kind_e;
+
+/**
+ * Everything needed to spawn one kind of body.
+ * Spawners that vary a field per body (e.g. asteroid size) copy the
+ * archetype from archetype_get() and change the copy.
+ */
+typedef struct archetype {
+    shape_kind_e shape;
+    // outer radius of an ngon, star or sector, or width of a rect
+    double radius;
+    // inner radius of a star, or height of a rect
+    double inner_radius;
+    size_t points;
+    // the points and angle of the cut-out part of a sector
+    size_t sector_points;
+    double sector_angle;
+    double mass;
+    double omega;
+    // used when this archetype bounces off another
+    double elasticity;
+    // starting aster_aux_t health
+    double health;
+    render_info_t render;
+    render_layer_e layer;
+    // whether the body is removed once it leaves the kill box
+    bool cullable;
+    // how many bodies to build ahead of time, or 0 to build one per spawn
+    size_t pool_size;
+} archetype_t;
+
+/**
+ * Gets the archetype of a body type.
+ *
+ * @param ctx the game, whose atlas the sprites are taken from
+ * @param type the type of body
+ * @return the archetype
+ */
+archetype_t archetype_get(const game_context_t *ctx, body_type_e type);
+
+/**
+ * Builds a body from an archetype and adds it to the scene.
+ * The body is tagged with its type, so the interactions set up by
+ * wire_interactions() apply to it without any per-spawn wiring.
+ *
+ * @param ctx the game to spawn into
+ * @param type the type stored in the body's aster_aux_t
+ * @param archetype the archetype to build the body from
+ * @param center the centroid of the new body
+ * @return the new body, owned by the scene
+ */
+body_t *spawn_archetype(game_context_t *ctx, body_type_e type, const archetype_t *archetype, vector_t center);
+
+/**
+ * Spawns a body of the given type from its archetype.
+ * Pooled types reuse an idle body from their pool, and only build a new one
+ * when the pool has run out. See spawn_archetype().
+ */
+body_t *spawn_entity(game_context_t *ctx, body_type_e type, vector_t center);
+
+/**
+ * Builds the pools of every archetype with a pool_size, and makes room
+ * in the scene's tag index for them. Also caches the shapes of every
+ * archetype and asteroid, and sets up the queue of the boss's armed bombs,
+ * so that spawning doesn't allocate.
+ * Must be called before spawning, once the scene and atlas are set.
+ *
+ * @param ctx the game
+ */
+void archetype_pools_init(game_context_t *ctx);
+
+/**
+ * Frees the pools built by archetype_pools_init().
+ * The scene must be freed first, so that it gives back the pooled bodies.
+ *
+ * @param ctx the game
+ */
+void archetype_pools_free(game_context_t *ctx);
+
+/**
+ * Registers the interaction rules of a game phase with the scene.
+ * Each rule is one pair force creator between two body types, so it covers
+ * every body of those types spawned from then on.
+ * Must be called once with PHASE_ALWAYS when the game starts.
+ *
+ * @param ctx the game
+ * @param phase the phase whose rules start applying
+ */
+void wire_interactions(game_context_t *ctx, game_phase_e phase);
+
+#endif // #ifndef __ASTER_BLASTER_ARCHETYPES__
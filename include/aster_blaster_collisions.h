@@ -10,27 +10,17 @@ void create_boss_health_collision(body_t *attacker, body_t *boss, vector_t axis,
 
 void create_destructive_collision_force_single(body_t *body1, body_t *body_immortal, vector_t axis, void *aux);
 
-void create_destructive_collision_single(scene_t *scene, body_t *body1, body_t *body_immortal);
-
 void create_mass_laser_collision_force(body_t *body1, body_t *body_laser, vector_t axis, void *aux);
 
-void create_mass_laser_collision(scene_t *scene, body_t *body_1, body_t *body_laser);
-
-void destroy_at_bounds(scene_t *scene, body_t *body, game_bounds_t bounds);
-
 void create_special_collision_force(body_t *ast, body_t *player, vector_t axis, void *aux);
 
-void create_aster_player_collision(scene_t *scene, body_t *ast, body_t *player);
-
-void create_aster_bullet_collision(scene_t *scene, body_t *ast, body_t *bullet, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list);
-
-void create_aster_laser_collision(scene_t *scene, body_t *ast, body_t *bullet, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list);
-
-void create_star_collision_force(body_t *star, body_t *bound, vector_t axis, void *aux);
+// aux is the game_context_t
+void create_aster_fragments(body_t *ast, body_t *bullet, vector_t axis, void *aux);
 
-void create_star_collision(scene_t *scene, body_t *star, body_t *bound);
+// aux is the game_context_t
+void create_aster_smaller(body_t *ast, body_t *laser, vector_t axis, void *aux);
 
-void init_boss_collisions(scene_t *scene, body_t *boss, body_t *movement_trigger, body_t *left_trigger, body_t *right_trigger, bool *tangible);
+void init_boss_collisions(game_context_t *ctx, body_t *boss);
 
 void create_boss_movement_init_collision(body_t *boss, body_t *trigger, vector_t axis, void *aux);
 
@@ -3,33 +3,47 @@
 
 #include "aster_blaster_imports.h"
 
-body_t *body_init_enemy_saw(vector_t pos, scene_t *scene, body_t *player, SDL_Texture *texture);
+void spawn_enemy_saw(game_context_t *ctx);
 
-body_t *body_init_enemy_shooter(vector_t pos, scene_t *scene, body_t *player, SDL_Texture *texture);
+void spawn_enemy_shooter(game_context_t *ctx);
 
-void spawn_enemy_saw(scene_t *scene, body_t *player, SDL_Texture *texture);
+// Tag force creators that move every saw or shooter towards its target
+void steer_saws(body_t **saws, size_t count, game_context_t *ctx);
 
-void spawn_enemy_shooter(scene_t *scene, body_t *player, SDL_Texture *texture);
+void steer_shooters(body_t **shooters, size_t count, game_context_t *ctx);
 
-void shooter_enemy_all_shoot(scene_t *scene, body_t *player, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list);
+/**
+ * Registers the steering of every enemy kind with the scene.
+ * Must be called once the player has spawned.
+ *
+ * @param ctx the game
+ */
+void wire_enemy_steering(game_context_t *ctx);
 
-body_t *body_init_enemy_shooter_bullet(scene_t *scene, body_t *player, body_t *shooter, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list);
+void shooter_enemy_all_shoot(game_context_t *ctx);
 
-void spawn_enemy_shooter_bullet(scene_t *scene, body_t *player, body_t *shooter, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list);
+void spawn_enemy_shooter_bullet(game_context_t *ctx, body_t *shooter);
 
-body_t *body_init_boss(scene_t *scene, body_t *movement_trigger, body_t *left_trigger, body_t *right_trigger, bool *tangible, SDL_Texture *texture);
+body_t *spawn_boss(game_context_t *ctx);
 
-void spawn_boss(scene_t *scene, body_t *movement_trigger, body_t *left_trigger, body_t *right_trigger, bool *tangible, SDL_Texture *texture);
+void boss_bomb_explode(game_context_t *ctx, body_t *bomb);
 
-void boss_bomb_explode(scene_t *scene, body_t *bomb, game_bounds_t bound, ast_sprites_list_t ast_sprites_list, list_t *bombs);
+// Drops a bomb from the boss that explodes once its fuse runs out
+void spawn_boss_bomb(game_context_t *ctx);
 
-void boss_bomb_tick(scene_t *scene, body_t *bomb, double dt, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list, list_t *bombs);
+// Timer callbacks for scene_schedule(); each returns the delay until it repeats
+double saw_wave(game_context_t *ctx);
 
-body_t *body_init_boss_bullet(scene_t *scene, body_t *bomb, game_bounds_t bound, ast_sprites_list_t ast_sprites_list);
+double shooter_wave(game_context_t *ctx);
 
-body_t *body_init_boss_bomb(scene_t *scene, body_t *boss, game_bounds_t bound, ast_sprites_list_t ast_sprites_list);
+double shooter_volley(game_context_t *ctx);
 
-void spawn_boss_bomb(scene_t *scene, game_bounds_t bound, ast_sprites_list_t ast_sprites_list, list_t *bombs);
+double boss_arrival(game_context_t *ctx);
+
+double boss_bomb_drop(game_context_t *ctx);
+
+// Schedules the enemy waves and the boss's arrival at the start of a game
+void schedule_enemy_waves(game_context_t *ctx);
 
 body_t *body_boss_health_bar_background_init();
 
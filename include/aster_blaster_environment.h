@@ -3,14 +3,33 @@
 
 #include "aster_blaster_imports.h"
 
-void spawn_asteroid_top(scene_t *scene, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list);
+// The radius of an asteroid of the given mass
+double asteroid_radius(double mass);
 
-body_t *spawn_asteroid_general(scene_t *scene, double mass, vector_t ast_center, vector_t ast_velocity, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list);
+/**
+ * Shrinks or grows an asteroid to the size of a new mass, in place.
+ * It keeps its shape, sprite, motion and scene registrations.
+ *
+ * @param asteroid the asteroid
+ * @param mass its new mass
+ */
+void resize_asteroid(body_t *asteroid, double mass);
 
-void create_background_stars(scene_t *scene, body_t *bound);
+void spawn_asteroid_top(game_context_t *ctx);
 
-body_t *body_init_black_hole(vector_t pos, scene_t *scene, game_bounds_t bounds, SDL_Texture *texture);
+body_t *spawn_asteroid_general(game_context_t *ctx, double mass, vector_t ast_center, vector_t ast_velocity);
 
-void spawn_black_hole(scene_t *scene, game_bounds_t bounds, SDL_Texture *texture);
+void create_background_stars(game_context_t *ctx);
+
+void spawn_black_hole(game_context_t *ctx);
+
+// Timer callbacks for scene_schedule(); each returns the delay until it repeats
+// A failed spawn chance comes round again in half the time
+double asteroid_wave(game_context_t *ctx);
+
+double black_hole_wave(game_context_t *ctx);
+
+// Schedules the asteroid and black hole waves at the start of a game
+void schedule_environment_waves(game_context_t *ctx);
 
 #endif // #ifndef __ASTER_BLASTER_ENVIRONMENT__
\ No newline at end of file
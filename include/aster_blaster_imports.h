@@ -3,33 +3,48 @@
 
 // C lib
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
+#include <time.h>
 // high level
 #include "scene.h"
+#include "backend.h"
+#include "profiler.h"
+#include "replay.h"
 #include "sdl_wrapper.h"
 // mid level
+#include "alloc_track.h"
+#include "atlas.h"
 #include "body.h"
+#include "body_pool.h"
 #include "collision.h"
 #include "forces.h"
+#include "frame_clock.h"
 #include "polygon.h"
+#include "shape_cache.h"
+#include "snapshot.h"
 #include "text_box.h"
 // low level
 #include "color.h"
 #include "list.h"
 #include "math.h"
+#include "rng.h"
 #include "utils.h"
 #include "vector.h"
 // aster_blaster modules
 #include "aster_blaster_settings.h"
 #include "aster_blaster_typedefs.h"
+#include "aster_blaster_archetypes.h"
 #include "aster_blaster_enemies.h"
 #include "aster_blaster_collisions.h"
 #include "aster_blaster_environment.h"
 #include "aster_blaster_player.h"
 #include "aster_blaster_utils.h"
 #include "aster_blaster_on_key.h"
+#include "aster_blaster_snapshot.h"
 
 // TODO: this should be factored out to sdl_wrapper
 #include <SDL2/SDL_image.h>
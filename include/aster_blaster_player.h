@@ -3,13 +3,11 @@
 
 #include "aster_blaster_imports.h"
 
-body_t *body_init_player(body_t *health_bar, render_info_t render_info);
+body_t *spawn_player(game_context_t *ctx, body_t *health_bar);
 
-body_t *body_init_bullet(body_t *player);
+void spawn_bullet(game_context_t *ctx);
 
-void spawn_bullet(scene_t *scene, body_t *player, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list, bool boss_tangible);
-
-void spawn_laser(scene_t *scene, body_t *player, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list, bool boss_tangible);
+void spawn_laser(game_context_t *ctx);
 
 body_t *body_health_bar_background_init();
 
@@ -6,6 +6,28 @@
 // SDL settings
 const vector_t SDL_MIN;
 const vector_t SDL_MAX;
+// Most frames per second the game runs at in a window, or 0 for no limit
+const double TARGET_FRAME_RATE;
+// Frames run by `--headless` when no frame count is given
+const size_t HEADLESS_DEFAULT_FRAMES;
+// Seed of `--headless` runs when no `--seed` is given, so they can be compared
+const uint64_t HEADLESS_DEFAULT_SEED;
+// Where builds with the profiler write its frame times and trace on exit,
+// and the collision counters of each pair of body types
+const char *const PROFILE_CSV_PATH;
+const char *const PROFILE_TRACE_PATH;
+const char *const PROFILE_PAIRS_CSV_PATH;
+// Builds that track allocations (`make ALLOC_TRACK=1`) fail an assertion
+// when a game frame after the warm-up makes more than ALLOC_FRAME_BUDGET
+// allocations, unless the frame is exempt (see ALLOC_FRAME_EXEMPT())
+const size_t ALLOC_BUDGET_WARM_UP_FRAMES;
+const size_t ALLOC_FRAME_BUDGET;
+// Frames between checks of whether to save a busier `--snapshot`
+const size_t SNAPSHOT_CHECK_FRAMES;
+// Room made up front for the game's bodies and its contacts per tick,
+// see scene_reserve()
+const size_t GAME_BODY_CAPACITY;
+const size_t GAME_CONTACT_CAPACITY;
 /**
  * Font designed by JoannaVu
  * Licensed for non-commercial use
@@ -61,11 +83,15 @@ const double BULLET_RADIUS;
 const double BULLET_SIDES;
 const rgb_color_t BULLET_COLOR;
 const double BULLET_COOLDOWN;
+const size_t BULLET_POOL_SIZE;
 
 const double LASER_MASS;
+const double LASER_WIDTH;
+const double LASER_LENGTH;
 const vector_t LASER_VELOCITY;
 const rgb_color_t LASER_COLOR;
 const double LASER_COOLDOWN;
+const size_t LASER_POOL_SIZE;
 const vector_t LASER_TRANSLATE;
 
 const double MIN_MASS;
@@ -73,9 +99,16 @@ const double MIN_MASS;
 // Asteroid settings
 const double ASTEROID_MIN_MASS;
 const double ASTEROID_MAX_MASS;
+const size_t ASTEROID_SIDES_MIN;
+const size_t ASTEROID_SIDES_MAX;
 const double ASTEROID_SPEED;
 const double ASTEROID_RADIUS_MIN;
 const double ASTEROID_RADIUS_MAX;
+const size_t ASTEROID_POOL_SIZE;
+
+// Cullable bodies are removed once they are entirely outside this box
+#define KILL_BOX_MIN ((vector_t){.x = SDL_MIN.x - ASTEROID_RADIUS_MAX, .y = SDL_MIN.y - ASTEROID_RADIUS_MAX})
+#define KILL_BOX_MAX ((vector_t){.x = SDL_MAX.x + ASTEROID_RADIUS_MAX, .y = SDL_MAX.y + ASTEROID_RADIUS_MAX})
 const rgb_color_t ASTEROID_COLOR;
 const double ASTEROID_SPAWN_CHANCE;
 const double ASTEROID_SPAWN_RATE;
@@ -90,6 +123,10 @@ const double STAR_POINTS_MAX;
 #define STAR_VELOCITY_2 ((vector_t){.x = 0, .y = -0.2 * SDL_MAX.y})
 #define STAR_VELOCITY_3 ((vector_t){.x = 0, .y = -0.4 * SDL_MAX.y})
 const rgb_color_t STAR_COLOR;
+// Stars that scroll out of this box come back on the other side,
+// far enough out that they are never seen jumping
+#define STAR_WRAP_MIN ((vector_t){.x = SDL_MIN.x - 2 * STAR_RADIUS_MAX, .y = SDL_MIN.y - 2 * STAR_RADIUS_MAX})
+#define STAR_WRAP_MAX ((vector_t){.x = SDL_MAX.x + 2 * STAR_RADIUS_MAX, .y = SDL_MAX.y + 2 * STAR_RADIUS_MAX})
 
 // Health bar settings
 #define HEALTH_BAR_BACKGROUND_POS ((vector_t){.x = 0.0125 * SDL_MAX.y, .y = 0.0125 * SDL_MAX.y})
@@ -118,6 +155,7 @@ const double ENEMY_SAW_A;
 const double ENEMY_SAW_SPAWN_RATE;
 const size_t ENEMY_SAW_SWARM_SIZE_MIN;
 const size_t ENEMY_SAW_SWARM_SIZE_MAX;
+const size_t ENEMY_SAW_POOL_SIZE;
 
 // Shooter enemy settings
 const double ENEMY_SHOOTER_RADIUS;
@@ -128,6 +166,7 @@ const double ENEMY_SHOOTER_MASS;
 const rgb_color_t ENEMY_SHOOTER_COLOR;
 const double ENEMY_SHOOTER_A;
 const double ENEMY_SHOOTER_SPAWN_RATE;
+const size_t ENEMY_SHOOTER_POOL_SIZE;
 
 // Shooter enemy bullet settings
 const double ENEMY_SHOOTER_SHOT_RATE;
@@ -137,6 +176,7 @@ const size_t ENEMY_SHOOTER_BULLET_POINTS;
 const double ENEMY_SHOOTER_BULLET_MASS;
 const rgb_color_t ENEMY_SHOOTER_BULLET_COLOR;
 const double ENEMY_SHOOTER_BULLET_SPEED;
+const size_t ENEMY_SHOOTER_BULLET_POOL_SIZE;
 
 // Boss settings
 const double BOSS_OUT_RADIUS;
@@ -157,6 +197,7 @@ const double BOSS_BOMB_FUSE;
 const double BOSS_BOMB_SPEED;
 const size_t BOSS_BOMB_POINTS;
 const rgb_color_t BOSS_BOMB_COLOR;
+const size_t BOSS_BOMB_POOL_SIZE;
 const size_t BOSS_BULLETS_PER_BOMB;
 const double BOSS_BULLET_OUT_RADIUS;
 const double BOSS_BULLET_IN_RADIUS;
@@ -164,6 +205,7 @@ const size_t BOSS_BULLET_POINTS;
 const double BOSS_BULLET_MASS;
 const rgb_color_t BOSS_BULLET_COLOR;
 const double BOSS_BULLET_SPEED;
+const size_t BOSS_BULLET_POOL_SIZE;
 
 // Boss Health bar settings
 #define BOSS_HEALTH_BAR_BACKGROUND_POS ((vector_t){.x = 0.0125 * SDL_MAX.y, .y = 0.925 * SDL_MAX.y})
@@ -184,6 +226,7 @@ const double BLACK_HOLE_SPEED;
 const rgb_color_t BLACK_HOLE_COLOR;
 const double BLACK_HOLE_SPAWN_CHANCE;
 const double BLACK_HOLE_SPAWN_RATE;
+const size_t BLACK_HOLE_POOL_SIZE;
 
 const double RATE_VARIANT_LOWER;
 const double RATE_VARIANT_UPPER;
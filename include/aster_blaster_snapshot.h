@@ -0,0 +1,31 @@
+#ifndef __ASTER_BLASTER_SNAPSHOT__
+#define __ASTER_BLASTER_SNAPSHOT__
+
+#include "aster_blaster_imports.h"
+
+/**
+ * Saves a game's scene with snapshot_save(): every body with its
+ * aster_aux_t, sprites by their sprite_id_e, and which bodies are the
+ * player, the boss, the bounds and the boss triggers.
+ * Timers, like the waves still to come, are not saved.
+ *
+ * @param ctx the game
+ * @param path the file to write
+ * @return whether the file was written
+ */
+bool game_snapshot_save(game_context_t *ctx, const char *path);
+
+/**
+ * Loads a snapshot saved by game_snapshot_save() into a game that has
+ * been set up without any bodies or force creators (its scene, atlas,
+ * shapes, pools and seed are needed). Sets the player, the boss,
+ * the bounds and the boss triggers, and wires the interactions and
+ * steering of the phase the game was in.
+ *
+ * @param ctx the game to load into, which must not move afterwards
+ * @param path a file written by game_snapshot_save()
+ * @return whether the file was a game snapshot
+ */
+bool game_snapshot_load(game_context_t *ctx, const char *path);
+
+#endif // #ifndef __ASTER_BLASTER_SNAPSHOT__
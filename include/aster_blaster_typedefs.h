@@ -22,7 +22,8 @@ typedef enum body_type {
     BLACK_HOLE,
     BOSS,
     BOSS_BULLET,
-    BOSS_BOMB
+    BOSS_BOMB,
+    BODY_TYPE_COUNT
 } body_type_e;
 
 typedef struct aster_aux {
@@ -30,7 +31,8 @@ typedef struct aster_aux {
     double health;
     body_t *health_bar;
     bool game_over;
-    double timer;
+    // where an enemy steers to, relative to the point it follows
+    vector_t steering_offset;
 } aster_aux_t;
 
 typedef struct menu_keypress_aux {
@@ -46,12 +48,28 @@ typedef struct game_bounds {
     body_t *bottom;
 } game_bounds_t;
 
+// Every image packed into the game's sprite atlas
+typedef enum sprite_id {
+    SPRITE_SHIP,
+    SPRITE_CIRCLE,
+    SPRITE_HEPTAGON,
+    SPRITE_HEXAGON,
+    SPRITE_PENTAGON,
+    SPRITE_BLACK_HOLE,
+    SPRITE_BOSS_ALIEN,
+    SPRITE_SAW_ALIEN,
+    SPRITE_SHOOTING_ALIEN,
+    SPRITE_COUNT
+} sprite_id_e;
+
+// Image file for each sprite_id_e, in order
+extern const char *const SPRITE_PATHS[SPRITE_COUNT];
+
 typedef struct ast_sprites_list {
-    SDL_Texture *circle;
-    SDL_Texture *heptagon;
-    SDL_Texture *hexagon;
-    SDL_Texture *pentagon;
-    // SDL_Texture *ship;
+    sprite_t circle;
+    sprite_t heptagon;
+    sprite_t hexagon;
+    sprite_t pentagon;
 } ast_sprites_list_t;
 
 typedef struct game_keypress_aux {
@@ -61,6 +79,54 @@ typedef struct game_keypress_aux {
     window_type_e window;
 } game_keypress_aux_t;
 
-void destroy_ast_sprite_list(ast_sprites_list_t list);
+// Offscreen bodies that steer the boss when it touches them
+typedef struct boss_triggers {
+    // where the boss stops coming down and starts moving sideways
+    body_t *movement;
+    body_t *left;
+    body_t *right;
+} boss_triggers_t;
+
+// When an interaction rule starts to apply, see wire_interactions()
+typedef enum game_phase {
+    PHASE_ALWAYS,
+    PHASE_BOSS_TANGIBLE
+} game_phase_e;
+
+// Each part of the game draws its random numbers from its own stream of the
+// game's seed, so a change to how one part spawns doesn't shift the others
+typedef enum rng_stream {
+    // when waves spawn and how big they are
+    RNG_WAVES,
+    // asteroids, black holes and stars
+    RNG_ENVIRONMENT,
+    RNG_ENEMIES,
+    RNG_STREAM_COUNT
+} rng_stream_e;
+
+// Everything spawners and collision handlers need to know about the running game
+typedef struct game_context {
+    scene_t *scene;
+    game_bounds_t bounds;
+    const sdl_atlas_t *atlas;
+    ast_sprites_list_t ast_sprites_list;
+    body_t *player;
+    // the player can shoot, i.e. the last shot's cooldown is over
+    bool weapon_ready;
+    boss_triggers_t boss_triggers;
+    // NULL until the boss arrives
+    body_t *boss;
+    bool boss_tangible;
+    // the bodies of each type, or NULL for types that aren't pooled
+    body_pool_t *pools[BODY_TYPE_COUNT];
+    // the boss's bombs whose fuses are lit, oldest first
+    list_t *armed_bombs;
+    // the shapes that archetypes are built from
+    shape_cache_t *shapes;
+    // see seed_game()
+    rng_t rngs[RNG_STREAM_COUNT];
+} game_context_t;
+
+ast_sprites_list_t ast_sprites_list_init(const sdl_atlas_t *atlas);
 
 #endif // #ifndef __ASTER_BLASTER_TYPEDEFS__
@@ -3,14 +3,30 @@
 
 #include "aster_blaster_imports.h"
 
-vector_t get_pos_radius_off_screen(double radius);
+vector_t get_pos_radius_off_screen(rng_t *rng, double radius);
 
 void print_bits(unsigned int num);
 
 void velocity_handle(body_t *body, size_t key_down, game_bounds_t bounds);
 
-void shoot_handle(scene_t *scene, body_t *player, double *bullet_time, size_t key_down, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list, bool boss_tangible);
+// Timer callback that lets the player shoot again
+double weapon_reload(game_context_t *ctx);
 
-double rate_variant(double rate);
+void shoot_handle(game_context_t *ctx, size_t key_down);
+
+double rate_variant(rng_t *rng, double rate);
+
+/**
+ * Seeds every random number stream of a game.
+ * All of a game's randomness is drawn from these streams,
+ * so two games with the same seed and input play out the same.
+ *
+ * @param ctx the game
+ * @param seed the seed of the game
+ */
+void seed_game(game_context_t *ctx, uint64_t seed);
+
+// Gets the random number stream that a part of the game draws from
+rng_t *game_rng(game_context_t *ctx, rng_stream_e stream);
 
 #endif // #ifndef __ASTER_BLASTER_UTILS__
@@ -0,0 +1,88 @@
+#ifndef __ATLAS_H__
+#define __ATLAS_H__
+
+#include <stddef.h>
+#include "color.h"
+
+/**
+ * A single texture holding several images packed side by side.
+ * Bodies drawn from the same atlas are batched into one draw call.
+ *
+ * The atlas only records where each image lives in the texture; packing
+ * the images and creating the texture is up to the backend
+ * (see sdl_atlas_init()), so the game can look up sprites without SDL.
+ */
+typedef struct sdl_atlas sdl_atlas_t;
+
+/**
+ * Allocates memory for an atlas with room for the given number of sprites.
+ * Every sprite starts out covering the whole texture.
+ *
+ * @param tex the texture the images are packed into
+ * @param count the number of images packed into tex
+ * @return a pointer to the newly allocated atlas
+ */
+sdl_atlas_t *atlas_init(SDL_Texture *tex, size_t count);
+
+/**
+ * Releases the memory allocated for an atlas.
+ * The texture is not destroyed; that is up to whoever created it.
+ *
+ * @param atlas a pointer to an atlas returned from atlas_init()
+ */
+void atlas_free(sdl_atlas_t *atlas);
+
+/**
+ * Records where one of the images is in the atlas texture.
+ * Asserts that the index is valid.
+ *
+ * @param atlas a pointer to an atlas returned from atlas_init()
+ * @param index the index of the image
+ * @param uv the normalized sub-rectangle of the texture covered by the image
+ */
+void atlas_set_sprite(sdl_atlas_t *atlas, size_t index, SDL_FRect uv);
+
+/**
+ * Gets the sprite for one of the images packed into an atlas.
+ * Asserts that the index is valid.
+ *
+ * @param atlas a pointer to an atlas returned from atlas_init()
+ * @param index the index of the image
+ * @return the sprite for the image
+ */
+sprite_t atlas_get(const sdl_atlas_t *atlas, size_t index);
+
+/**
+ * Gets the number of images packed into an atlas.
+ *
+ * @param atlas a pointer to an atlas returned from atlas_init()
+ * @return the number of sprites in the atlas
+ */
+size_t atlas_size(const sdl_atlas_t *atlas);
+
+/**
+ * Gets the texture the images of an atlas are packed into.
+ *
+ * @param atlas a pointer to an atlas returned from atlas_init()
+ * @return the texture passed to atlas_init()
+ */
+SDL_Texture *atlas_get_texture(const sdl_atlas_t *atlas);
+
+/**
+ * Records the texture coordinate of a pure white texel in the atlas,
+ * which colored polygons are drawn with so they batch with the sprites.
+ *
+ * @param atlas a pointer to an atlas returned from atlas_init()
+ * @param uv the normalized position of a white texel
+ */
+void atlas_set_white_uv(sdl_atlas_t *atlas, SDL_FPoint uv);
+
+/**
+ * Gets the texture coordinate of the atlas's white texel.
+ *
+ * @param atlas a pointer to an atlas returned from atlas_init()
+ * @return the position passed to atlas_set_white_uv(), or (0, 0) if unset
+ */
+SDL_FPoint atlas_get_white_uv(const sdl_atlas_t *atlas);
+
+#endif // #ifndef __ATLAS_H__
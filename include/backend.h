@@ -0,0 +1,170 @@
+#ifndef __BACKEND_H__
+#define __BACKEND_H__
+
+#include <stdbool.h>
+#include "atlas.h"
+#include "color.h"
+#include "frame_clock.h"
+#include "scene.h"
+#include "vector.h"
+
+// Values passed to a key handler when the given arrow key is pressed
+#define LEFT_ARROW 1
+#define UP_ARROW 2
+#define RIGHT_ARROW 3
+#define DOWN_ARROW 4
+#define ATTACK1_BUTTON 5
+#define ATTACK2_BUTTON 6
+#define ESCAPE 7
+
+/**
+ * The possible types of key events.
+ * Enum types in C are much more primitive than in Java; this is equivalent to:
+ * typedef unsigned int KeyEventType;
+ * #define KEY_PRESSED 0
+ * #define KEY_RELEASED 1
+ */
+typedef enum key_event_type {
+    KEY_PRESSED,
+    KEY_RELEASED
+} key_event_type_t;
+
+/**
+ * A keypress handler.
+ * When a key is pressed or released, the handler is passed its char value.
+ * Most keys are passed as their char value, e.g. 'a', '1', or '\r'.
+ * Arrow keys have the special values listed above.
+ *
+ * @param key a character indicating which key was pressed
+ * @param type the type of key event (KEY_PRESSED or KEY_RELEASED)
+ * @param held_time if a press event, the time the key has been held in seconds
+ */
+typedef void (*key_handler_t)(char key, key_event_type_t type, double held_time, void *data);
+
+/**
+ * The platform the game runs on: how it draws, reads input, loads images
+ * and measures time. The game only talks to the platform through the
+ * backend_*() functions below, which forward to the backend in use.
+ * See SDL_BACKEND and HEADLESS_BACKEND in sdl_wrapper.h.
+ */
+typedef struct backend {
+    const char *name;
+    void (*init)(vector_t min, vector_t max);
+    void (*set_background_color)(rgb_color_t color);
+    void (*set_font)(const char *font_path);
+    void (*on_key)(key_handler_t handler);
+    bool (*is_done)(void *aux);
+    void (*render_scene)(const scene_t *scene);
+    void (*run)(void (*game)(void));
+    sdl_atlas_t *(*atlas_init)(const char *const *files, size_t count);
+    void (*atlas_free)(sdl_atlas_t *atlas);
+    double (*time_since_last_tick)(void);
+    void (*set_frame_rate)(double fps);
+    const frame_clock_t *(*frame_clock)(void);
+} backend_t;
+
+/**
+ * Selects the backend that the backend_*() functions forward to.
+ * Must be called before backend_init().
+ *
+ * @param backend the backend to use, which must outlive its use
+ */
+void backend_use(const backend_t *backend);
+
+/**
+ * Gets the backend selected with backend_use().
+ * Asserts that one has been selected.
+ *
+ * @return the backend in use
+ */
+const backend_t *backend_current(void);
+
+/**
+ * Initializes the backend. Must be called once before the other functions.
+ *
+ * @param min the x and y coordinates of the bottom left of the scene
+ * @param max the x and y coordinates of the top right of the scene
+ */
+void backend_init(vector_t min, vector_t max);
+
+void backend_set_background_color(rgb_color_t color);
+
+/**
+ * Sets the font used to draw text boxes.
+ *
+ * @param font_path a char pointer to the file path of the .ttf file
+ */
+void backend_set_font(const char *font_path);
+
+/**
+ * Registers a function to be called every time a key is pressed or released.
+ * Overwrites any existing handler.
+ *
+ * @param handler the function to call with each key event
+ */
+void backend_on_key(key_handler_t handler);
+
+/**
+ * Processes all pending input and returns whether the game should stop.
+ * This function must be called in order to handle keypresses.
+ *
+ * @param aux the value passed to the key handler
+ * @return true if the game should stop, false otherwise
+ */
+bool backend_is_done(void *aux);
+
+/**
+ * Draws all bodies and text boxes in a scene.
+ *
+ * @param scene the scene to draw
+ */
+void backend_render_scene(const scene_t *scene);
+
+/**
+ * Runs a game until it returns. The backend may run it on a thread of its
+ * own, so that the calling thread can poll input and draw the frames the
+ * game renders. Must be called on the thread that called backend_init().
+ *
+ * @param game the game, which uses the other backend_*() functions
+ */
+void backend_run(void (*game)(void));
+
+/**
+ * Loads the given image files into one atlas.
+ * Must be called on the thread that called backend_init(),
+ * before or after backend_run().
+ *
+ * @param files the paths of the images to pack
+ * @param count the number of paths in files
+ * @return the new atlas, which must be freed with backend_atlas_free()
+ */
+sdl_atlas_t *backend_atlas_init(const char *const *files, size_t count);
+
+void backend_atlas_free(sdl_atlas_t *atlas);
+
+/**
+ * Gets the amount of game time that has passed since the last time
+ * this function was called, in seconds.
+ *
+ * @return the number of seconds that have elapsed
+ */
+double backend_time_since_last_tick(void);
+
+/**
+ * Limits how many frames per second the game loop runs at:
+ * backend_time_since_last_tick() waits until the frame has lasted long enough.
+ * Backends whose frames don't run in real time may ignore this.
+ *
+ * @param fps the most frames per second, or 0 for no limit
+ */
+void backend_set_frame_rate(double fps);
+
+/**
+ * Gets the clock that times the frames ended by backend_time_since_last_tick(),
+ * e.g. to read percentiles of the recent frame times.
+ *
+ * @return the frame clock, owned by the backend
+ */
+const frame_clock_t *backend_frame_clock(void);
+
+#endif // #ifndef __BACKEND_H__
@@ -0,0 +1,57 @@
+/** Common functions for benchmarks. */
+
+#ifndef __BENCH_UTIL_H__
+#define __BENCH_UTIL_H__
+
+#include <stddef.h>
+
+/**
+ * Runs the operation being measured a given number of times.
+ * Whatever the operation computes should be written to bench_sink,
+ * so the compiler cannot skip it.
+ *
+ * @param aux the value passed to bench_run()
+ * @param iterations how many times to run the operation
+ */
+typedef void (*bench_func_t)(void *aux, size_t iterations);
+
+/**
+ * A value for benchmarks to write their results to.
+ */
+extern volatile double bench_sink;
+
+/**
+ * Reads a monotonic clock, for benchmarks that time steps themselves.
+ *
+ * @return the time in nanoseconds since an arbitrary start
+ */
+double bench_now_ns(void);
+
+/**
+ * Starts a suite of benchmarks, printing the start of its JSON report.
+ * Must be called before bench_run().
+ *
+ * @param suite the name of the suite, e.g. "list"
+ */
+void bench_begin(const char *suite);
+
+/**
+ * Measures one benchmark and prints its result to the suite's report.
+ * The operation is first run untimed to warm up, and to find how many
+ * iterations make a sample long enough to time. Then several samples are
+ * timed and their mean, standard deviation and minimum are reported
+ * in nanoseconds per operation.
+ *
+ * @param name the name of the operation, e.g. "list_add"
+ * @param size the size it is measured at, e.g. the number of vertices
+ * @param func runs the operation
+ * @param aux an auxiliary value to pass to func
+ */
+void bench_run(const char *name, size_t size, bench_func_t func, void *aux);
+
+/**
+ * Ends the suite started by bench_begin(), finishing its JSON report.
+ */
+void bench_end(void);
+
+#endif // #ifndef __BENCH_UTIL_H__
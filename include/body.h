@@ -2,10 +2,32 @@
 #define __BODY_H__
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "color.h"
 #include "list.h"
+#include "shape_cache.h"
 #include "vector.h"
 
+/**
+ * The tag of a body that scene_add_pair_force_creator() should ignore.
+ */
+#define BODY_TAG_NONE SIZE_MAX
+
+/**
+ * The layers bodies are drawn in, from back to front.
+ * Bodies in the same layer are drawn in no particular order.
+ */
+typedef enum render_layer {
+    // things that are never meant to be seen, e.g. offscreen triggers
+    LAYER_BACKDROP,
+    LAYER_BACKGROUND,
+    LAYER_DEFAULT,
+    LAYER_FOREGROUND,
+    LAYER_HUD_BACKGROUND,
+    LAYER_HUD,
+    RENDER_LAYER_COUNT
+} render_layer_e;
+
 /**
  * A rigid body constrained to the plane.
  * Implemented as a polygon with uniform density.
@@ -14,6 +36,12 @@
  */
 typedef struct body body_t;
 
+/**
+ * A function that takes back a body instead of freeing it.
+ * See body_set_releaser().
+ */
+typedef void (*body_releaser_t)(void *owner, body_t *body);
+
 /**
  * Initializes a body without any info.
  * Acts like body_init_with_info() where info and info_freer are NULL.
@@ -51,6 +79,38 @@ body_t *body_init_texture_with_info(
     free_func_t info_freer
 );
 
+/**
+ * Allocates memory for a body whose shape is a shared template.
+ * The body keeps the template with its own scale, angle and position,
+ * and derives its vertices from them into a single buffer. Rotating or
+ * scaling the body recomputes them from the template.
+ * The template's cache must outlive the body.
+ *
+ * @param shape a template returned from a shape cache
+ * @param center where the template's origin is put, as with polygon_*()
+ * @param radius how many times bigger than the template the body is
+ * @param mass the mass of the body (if INFINITY, stops the body from moving)
+ * @param texture how the body is drawn
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_template(
+    const shape_template_t *shape,
+    vector_t center,
+    double radius,
+    double mass,
+    render_info_t texture
+);
+
+/**
+ * Gives a body built from a template another template, keeping its
+ * scale, angle and centroid, e.g. to reuse a pooled body as a new shape.
+ * Only allocates if the new template has more vertices than any before.
+ *
+ * @param body a pointer to a body returned from body_init_template()
+ * @param shape a template returned from a shape cache
+ */
+void body_set_template(body_t *body, const shape_template_t *shape);
+
 /**
  * Releases the memory allocated for a body.
  *
@@ -58,6 +118,34 @@ body_t *body_init_texture_with_info(
  */
 void body_free(body_t *body);
 
+/**
+ * Hands a body back to whoever owns it, e.g. a body_pool_t.
+ * Frees the body if it has no releaser.
+ * Scenes call this on the bodies they remove.
+ *
+ * @param body the body to release
+ */
+void body_release(body_t *body);
+
+/**
+ * Makes body_release() give the body to an owner instead of freeing it.
+ *
+ * @param body the body
+ * @param releaser the function called with the owner and the body
+ * @param owner the value passed to the releaser
+ */
+void body_set_releaser(body_t *body, body_releaser_t releaser, void *owner);
+
+/**
+ * Puts a body back at rest at the given position, so it can be used again
+ * after being removed. Clears the removal mark, velocity, acceleration,
+ * angle and angular velocity. Keeps the shape, mass, info and tag.
+ *
+ * @param body the body to reset
+ * @param centroid the new centroid of the body
+ */
+void body_reset(body_t *body, vector_t centroid);
+
 /**
  * Adds a decal to the body.
  * Contract: the decal body should be massless and not have any forces tied to it.
@@ -81,6 +169,8 @@ list_t *body_get_shape_cloned(const body_t *body);
 /**
  * Gets the pointer to the current shape of a body.
  * Don't free this one!
+ * Changes to the vertices of a body built from a template are lost
+ * the next time it rotates or is scaled.
  *
  * @param body a pointer to a body returned from body_init()
  * @return the polygon describing the body's current position
@@ -98,6 +188,24 @@ list_t *body_get_shape(body_t *body);
  */
 const list_t *body_borrow_shape(const body_t *body);
 
+/**
+ * Gets the template a body's shape is derived from.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the template passed to body_init_template(), or NULL
+ */
+const shape_template_t *body_get_template(const body_t *body);
+
+/**
+ * Gets how many times a body has been scaled since it was built.
+ * For a body built from a template, this is how many times bigger
+ * than the template it is.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the product of the radius it was built with and every body_scale()
+ */
+double body_get_scale(const body_t *body);
+
 /**
  * Gets the current center of mass of a body.
  * While this could be calculated with polygon_centroid(), that becomes too slow
@@ -151,6 +259,95 @@ double body_get_mass(const body_t *body);
  */
 render_info_t body_get_render_data(const body_t *body);
 
+/**
+ * Changes how a body is drawn, e.g. to resize its sprite.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param texture the body's new render information
+ */
+void body_set_render_data(body_t *body, render_info_t texture);
+
+/**
+ * Gets the layer a body is drawn in.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the layer set with body_set_layer(), LAYER_DEFAULT if never set
+ */
+render_layer_e body_get_layer(const body_t *body);
+
+/**
+ * Sets the layer a body is drawn in.
+ * Bodies in later layers are drawn on top of bodies in earlier ones,
+ * regardless of the order they were added to the scene.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param layer the layer to draw the body in
+ */
+void body_set_layer(body_t *body, render_layer_e layer);
+
+/**
+ * Gets the tag that a scene uses to match a body with pair force creators.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the tag set with body_set_tag(), BODY_TAG_NONE if never set
+ */
+size_t body_get_tag(const body_t *body);
+
+/**
+ * Sets the tag that a scene uses to match a body with pair force creators.
+ * See scene_add_pair_force_creator().
+ * The tag must not change while the body is in a scene.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param tag a small non-negative integer, or BODY_TAG_NONE
+ */
+void body_set_tag(body_t *body, size_t tag);
+
+/**
+ * Gets the distance from a body's centroid to its farthest vertex.
+ * It is measured when the body is created, and stays the same as the body
+ * moves and rotates. Changing the shape directly doesn't update it.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the radius of the circle around the centroid that holds the body
+ */
+double body_get_bounding_radius(const body_t *body);
+
+/**
+ * Gets whether a scene removes the body once it leaves the scene's kill box.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the value set with body_set_cullable(), false if never set
+ */
+bool body_is_cullable(const body_t *body);
+
+/**
+ * Sets whether a scene removes the body once it leaves the scene's kill box.
+ * See scene_set_kill_box().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param cullable whether the body can be culled
+ */
+void body_set_cullable(body_t *body, bool cullable);
+
+/**
+ * Gets whether a scene wraps the body around its wrap box.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the value set with body_set_wrapping(), false if never set
+ */
+bool body_is_wrapping(const body_t *body);
+
+/**
+ * Sets whether a scene wraps the body around its wrap box, so that it
+ * comes back on the opposite side after leaving it.
+ * See scene_set_wrap_box().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param wrapping whether the body wraps
+ */
+void body_set_wrapping(body_t *body, bool wrapping);
+
 /**
  * Gets the information associated with a body.
  *
@@ -159,6 +356,16 @@ render_info_t body_get_render_data(const body_t *body);
  */
 void *body_get_info(body_t *body);
 
+/**
+ * Replaces the information associated with a body.
+ * The old info is not freed.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param info the new info
+ * @param info_freer if non-NULL, a function call on the info to free it
+ */
+void body_set_info(body_t *body, void *info, free_func_t info_freer);
+
 /**
  * Translates all vertices in a body's polygon shape by the given vector.
  * Also changes the body's centroid by the given vector.
@@ -169,6 +376,15 @@ void *body_get_info(body_t *body);
  */
 void body_translate(body_t *body, vector_t translate);
 
+/**
+ * Scales a body's polygon shape about its centroid, in place.
+ * Also scales its bounding radius, but leaves its mass and sprite alone.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param factor how many times bigger the body becomes, must be positive
+ */
+void body_scale(body_t *body, double factor);
+
 /**
  * Translates a body to a new position.
  * The position is specified by the position of the body's center of mass.
@@ -214,6 +430,15 @@ void body_set_mass(body_t *body, double mass);
  */
 void body_set_rotation(body_t *body, double angle);
 
+/**
+ * Changes the angle a body reports without rotating its shape,
+ * e.g. to restore a body whose shape was saved already rotated.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param angle the angle the body's shape is at, in radians
+ */
+void body_set_angle(body_t *body, double angle);
+
 /**
  * Applies a force to a body over the current tick.
  * If multiple forces are applied in the same tick, they should be added.
@@ -0,0 +1,67 @@
+#ifndef __BODY_POOL_H__
+#define __BODY_POOL_H__
+
+#include <stddef.h>
+#include "body.h"
+
+/**
+ * A fixed number of prebuilt bodies that are handed out and taken back
+ * instead of being allocated and freed, for short-lived bodies that are
+ * spawned often, like projectiles.
+ * A body from the pool is added to a scene as usual; when the scene removes
+ * it, the body goes back to the pool (see body_release()).
+ */
+typedef struct body_pool body_pool_t;
+
+/**
+ * Allocates memory for an empty pool.
+ *
+ * @param capacity the number of bodies the pool can hold
+ * @return a pointer to the newly allocated pool
+ */
+body_pool_t *body_pool_init(size_t capacity);
+
+/**
+ * Releases the memory allocated for a pool and all the bodies in it.
+ * Asserts that every body has been given back, so the scenes using the
+ * pool's bodies must be freed first.
+ *
+ * @param pool a pointer to a pool returned from body_pool_init()
+ */
+void body_pool_free(body_pool_t *pool);
+
+/**
+ * Adds a body to the pool, which takes ownership of it.
+ * The body starts out idle. Asserts that the pool is not full.
+ *
+ * @param pool a pointer to a pool returned from body_pool_init()
+ * @param body the body to add
+ */
+void body_pool_add(body_pool_t *pool, body_t *body);
+
+/**
+ * Takes an idle body out of the pool and resets it (see body_reset()).
+ *
+ * @param pool a pointer to a pool returned from body_pool_init()
+ * @param centroid where to put the body
+ * @return the body, or NULL if every body is in use
+ */
+body_t *body_pool_acquire(body_pool_t *pool, vector_t centroid);
+
+/**
+ * Gets the number of bodies in the pool, in use or not.
+ *
+ * @param pool a pointer to a pool returned from body_pool_init()
+ * @return the number of bodies added to the pool
+ */
+size_t body_pool_size(const body_pool_t *pool);
+
+/**
+ * Gets the number of bodies that can still be acquired.
+ *
+ * @param pool a pointer to a pool returned from body_pool_init()
+ * @return the number of idle bodies
+ */
+size_t body_pool_idle(const body_pool_t *pool);
+
+#endif // #ifndef __BODY_POOL_H__
@@ -21,6 +21,24 @@ typedef struct {
     vector_t axis;
 } collision_info_t;
 
+/**
+ * The range of values covered by a polygon projected onto an axis.
+ * Intervals are well formed (low <= high).
+ */
+typedef struct interval {
+    double low;
+    double high;
+} interval_t;
+
+/**
+ * Projects a polygon onto an axis, as the separating axis test does.
+ *
+ * @param poly the polygon, with at least one vertex
+ * @param axis a unit vector
+ * @return the smallest and largest dot product of a vertex with the axis
+ */
+interval_t polygon_project(const list_t *poly, vector_t axis);
+
 /**
  * Computes the status of the collision between two convex polygons.
  * The shapes are given as lists of vertices in counterclockwise order.
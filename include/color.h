@@ -2,6 +2,11 @@
 #define __COLOR_H__
 
 #include <SDL2/SDL_render.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The atlas index of an image that is not part of an atlas
+#define NOT_IN_ATLAS SIZE_MAX
 
 /**
  * A color to display on the screen.
@@ -22,12 +27,27 @@ typedef enum render_type {
 
 typedef struct render_data_texture {
     SDL_Texture *tex;
+    // normalized sub-rectangle of tex to sample, (0, 0, 1, 1) is the whole texture
+    SDL_FRect uv;
+    // which image of its atlas tex is, or NOT_IN_ATLAS
+    size_t atlas_index;
     int dx;
     int dy;
     int w;
     int h;
 } render_data_texture_t;
 
+/**
+ * A sub-rectangle of a (possibly shared) texture, e.g. one entry of an atlas.
+ */
+typedef struct sprite {
+    SDL_Texture *tex;
+    // normalized sub-rectangle of tex covered by the sprite
+    SDL_FRect uv;
+    // which image of its atlas the sprite is, or NOT_IN_ATLAS
+    size_t atlas_index;
+} sprite_t;
+
 typedef union render_data {
     render_data_texture_t texture;
     rgb_color_t color;
@@ -54,6 +74,9 @@ render_info_t render_color(rgb_color_t color);
 // Create render information from SDL_Texture
 render_info_t render_texture(SDL_Texture *tex, int w, int h);
 
+// Create render information from a sprite (e.g. one returned by atlas_get())
+render_info_t render_sprite(sprite_t sprite, int w, int h);
+
 /**
  * Returns a rgb_color_t value made from the given arguments.
  * 
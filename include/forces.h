@@ -6,6 +6,8 @@
 
 /**
  * A function called when a collision occurs.
+ * It is a contact_handler_t, called after the scene's force creators
+ * have run (see scene_add_contact()).
  * @param body1 the first body passed to create_collision()
  * @param body2 the second body passed to create_collision()
  * @param axis a unit vector pointing from body1 towards body2
@@ -31,8 +33,31 @@ typedef void (*collision_handler_t)
  */
 void create_newtonian_gravity(scene_t *scene, double G, body_t *body1, body_t *body2, bool one_way);
 
+/**
+ * Like create_newtonian_gravity(), but for every pair of bodies
+ * with the given tags. See scene_add_pair_force_creator().
+ *
+ * @param scene the scene containing the bodies
+ * @param G the gravitational proportionality constant
+ * @param tag1 the tag of the first bodies
+ * @param tag2 the tag of the second bodies
+ * @param one_way true means that only the first bodies are affected
+ */
+void create_pair_newtonian_gravity(scene_t *scene, double G, size_t tag1, size_t tag2, bool one_way);
+
 // void create_super_gravity(scene_t *scene, double G, body_t *body1, body_t *body2, bool one_way);
 
+/**
+ * Gets the velocity that the attraction force creators give a body:
+ * straight towards its target, faster the further away it is.
+ *
+ * @param A the attraction constant, in 1/s
+ * @param position the centroid of the body
+ * @param target the point the body is attracted to
+ * @return the velocity of the body
+ */
+vector_t attraction_velocity(double A, vector_t position, vector_t target);
+
 void create_attraction(scene_t *scene, double A, body_t *body1, body_t *body2, bool one_way);
 
 void create_attraction_mirrored(scene_t *scene, double A, body_t *body_to_move, body_t *body_unaffected, vector_t sdl_max, vector_t offset);
@@ -72,6 +97,8 @@ void create_drag(scene_t *scene, double gamma, body_t *body);
  * allowing different things to happen on a collision.
  * The handler is passed the bodies, the collision axis, and an auxiliary value.
  * It should only be called once while the bodies are still colliding.
+ * Collisions are queued as contacts, so every collision of a tick is found
+ * before any handler runs; see scene_add_contact().
  *
  * @param scene the scene containing the bodies
  * @param body1 the first body
@@ -89,6 +116,27 @@ void create_collision(
     free_func_t freer
 );
 
+/**
+ * Like create_collision(), but for every pair of bodies with the given tags,
+ * including bodies added to the scene later.
+ * See scene_add_pair_force_creator().
+ *
+ * @param scene the scene containing the bodies
+ * @param tag1 the tag of the bodies passed to the handler as body1
+ * @param tag2 the tag of the bodies passed to the handler as body2
+ * @param handler a function to call whenever two such bodies collide
+ * @param aux an auxiliary value to pass to the handler
+ * @param freer if non-NULL, a function to call in order to free aux
+ */
+void create_pair_collision(
+    scene_t *scene,
+    size_t tag1,
+    size_t tag2,
+    collision_handler_t handler,
+    void *aux,
+    free_func_t freer
+);
+
 /**
  * Adds a force creator to a scene that destroys two bodies when they collide.
  * The bodies should be destroyed by calling body_remove().
@@ -101,6 +149,16 @@ void create_collision(
  */
 void create_destructive_collision(scene_t *scene, body_t *body1, body_t *body2);
 
+/**
+ * Like create_destructive_collision(), but for every pair of bodies
+ * with the given tags. See create_pair_collision().
+ *
+ * @param scene the scene containing the bodies
+ * @param tag1 the tag of the first bodies
+ * @param tag2 the tag of the second bodies
+ */
+void create_pair_destructive_collision(scene_t *scene, size_t tag1, size_t tag2);
+
 /**
  * Adds a force creator to a scene that applies impulses
  * to resolve collisions between two bodies in the scene.
@@ -125,4 +183,20 @@ void create_physics_collision(
     body_t *body2
 );
 
+/**
+ * Like create_physics_collision(), but for every pair of bodies
+ * with the given tags. See create_pair_collision().
+ *
+ * @param scene the scene containing the bodies
+ * @param elasticity the "coefficient of restitution" of the collisions
+ * @param tag1 the tag of the first bodies
+ * @param tag2 the tag of the second bodies
+ */
+void create_pair_physics_collision(
+    scene_t *scene,
+    double elasticity,
+    size_t tag1,
+    size_t tag2
+);
+
 #endif // #ifndef __FORCES_H__
@@ -0,0 +1,83 @@
+#ifndef __FRAME_CLOCK_H__
+#define __FRAME_CLOCK_H__
+
+#include <stddef.h>
+
+/**
+ * Measures the wall-clock time between frames with a monotonic clock,
+ * optionally waits so frames don't come faster than a target rate,
+ * and keeps a histogram of the most recent frame times.
+ */
+typedef struct frame_clock frame_clock_t;
+
+/**
+ * Allocates memory for a frame clock. Its first tick starts the first frame.
+ *
+ * @param target_rate the most frames per second to allow, or 0 for no limit
+ * @return a pointer to the newly allocated frame clock
+ */
+frame_clock_t *frame_clock_init(double target_rate);
+
+/**
+ * Releases the memory allocated for a frame clock.
+ *
+ * @param clock a pointer to a frame clock returned from frame_clock_init()
+ */
+void frame_clock_free(frame_clock_t *clock);
+
+/**
+ * Changes the most frames per second a frame clock allows.
+ *
+ * @param clock a pointer to a frame clock returned from frame_clock_init()
+ * @param target_rate the most frames per second to allow, or 0 for no limit
+ */
+void frame_clock_set_target(frame_clock_t *clock, double target_rate);
+
+/**
+ * Ends a frame and starts the next one.
+ * If the frame was shorter than the target rate allows, this first sleeps
+ * and then yields until it is long enough.
+ * The frame's length is added to the histogram.
+ *
+ * @param clock a pointer to a frame clock returned from frame_clock_init()
+ * @return the number of seconds since the last tick, or 0 the first time
+ */
+double frame_clock_tick(frame_clock_t *clock);
+
+/**
+ * Adds a frame time to the histogram, dropping the oldest one
+ * once it holds FRAME_CLOCK_WINDOW frames.
+ * Called by frame_clock_tick(), for clocks whose frames are timed elsewhere.
+ *
+ * @param clock a pointer to a frame clock returned from frame_clock_init()
+ * @param seconds the length of the frame
+ */
+void frame_clock_record(frame_clock_t *clock, double seconds);
+
+/**
+ * Gets the number of frame times in the histogram.
+ *
+ * @param clock a pointer to a frame clock returned from frame_clock_init()
+ * @return the number of recent frames the percentiles are taken over
+ */
+size_t frame_clock_frames(const frame_clock_t *clock);
+
+/**
+ * Gets a percentile of the recent frame times, e.g. 0.99 for the time
+ * that 99% of frames took at most. Frame times are rounded up to the
+ * histogram's resolution of FRAME_CLOCK_BUCKET_MS.
+ *
+ * @param clock a pointer to a frame clock returned from frame_clock_init()
+ * @param fraction the percentile, between 0 and 1
+ * @return the frame time in milliseconds, or 0 if there are no frames yet
+ */
+double frame_clock_percentile(const frame_clock_t *clock, double fraction);
+
+/**
+ * Reads the monotonic clock that frame clocks use.
+ *
+ * @return the time in seconds since an arbitrary start
+ */
+double frame_clock_now(void);
+
+#endif // #ifndef __FRAME_CLOCK_H__
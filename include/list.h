@@ -60,6 +60,15 @@ size_t list_size(const list_t *list);
  */
 size_t list_capacity(const list_t *list);
 
+/**
+ * Grows a list so it can hold at least the given number of elements
+ * without resizing. Does nothing if it already can.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @param capacity the number of elements to make room for
+ */
+void list_reserve(list_t *list, size_t capacity);
+
 /**
  * Gets the element at a given index in a list.
  * Asserts that the index is valid, given the list's current size.
@@ -91,6 +100,18 @@ const void *list_borrow(const list_t *list, size_t index);
  */
 void *list_remove(list_t *list, size_t index);
 
+/**
+ * Removes the element at a given index in a list and returns it,
+ * moving the last element of the list into its place.
+ * Unlike list_remove(), this takes constant time
+ * but does not preserve the order of the remaining elements.
+ * Asserts that the index is valid, given the list's current size.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @return the element at the given index in the list
+ */
+void *list_swap_remove(list_t *list, size_t index);
+
 /**
  * Removes the element that matches the pointer,
  * moving all subsequent elements towards the start of the list.
@@ -0,0 +1,237 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * The parts of a frame that are timed.
+ * Zones nest: e.g. ZONE_PAIR_FORCES runs inside ZONE_SCENE_TICK,
+ * and each zone's time includes the zones inside it.
+ */
+typedef enum profile_zone {
+    // the game loop's work for one frame, on the game thread
+    ZONE_FRAME,
+    ZONE_SCENE_TICK,
+    ZONE_TIMERS,
+    // resetting accelerations and removing bodies outside the kill box
+    ZONE_CULL,
+    ZONE_FORCE_CREATORS,
+    ZONE_TAG_FORCES,
+    ZONE_PAIR_FORCES,
+    // the handlers of the contacts the force creators queued,
+    // not the collision tests
+    ZONE_COLLISION_HANDLERS,
+    // the spawns and wiring the handlers deferred
+    ZONE_COMMANDS,
+    ZONE_REMOVAL,
+    ZONE_BODY_TICK,
+    // copying the scene into a render frame
+    ZONE_CAPTURE,
+    // drawing a frame, on the main thread while the game runs on its own
+    ZONE_RENDER,
+    ZONE_TEXT,
+    PROFILE_ZONE_COUNT
+} profile_zone_e;
+
+/**
+ * What the collision pipeline counts in each frame, from the pairs of
+ * bodies it visits down to the handlers of the ones that collided,
+ * to tell why a frame spent its time in ZONE_PAIR_FORCES.
+ */
+typedef enum profile_counter {
+    // pairs of bodies a pair force creator or a collision was run on
+    COUNTER_PAIRS_TESTED,
+    // pairs whose bounding boxes overlapped in find_collision(),
+    // which go on to the separating axis test
+    COUNTER_BOUNDING_BOX_PASSED,
+    // separating axis tests, one or two per pair that gets that far
+    COUNTER_SAT_TESTS,
+    COUNTER_HANDLERS_FIRED,
+    PROFILE_COUNTER_COUNT
+} profile_counter_e;
+
+// Counters are also kept per pair of tags below this, e.g. body types
+#define PROFILER_MAX_TAGS 16
+
+/**
+ * Timing zones are only compiled in when PROFILER is defined,
+ * e.g. with `make PROFILE=1`. Otherwise they expand to nothing.
+ * Every PROFILE_BEGIN() must be matched by a PROFILE_END() of the same
+ * zone on the same thread, so don't return or break out of a zone.
+ */
+#ifdef PROFILER
+#define PROFILE_BEGIN(zone) profiler_begin(zone)
+#define PROFILE_END(zone) profiler_end(zone)
+#define PROFILE_FRAME_END() profiler_frame_end()
+#define PROFILE_COUNT(counter) profiler_count(counter)
+#define PROFILE_PAIR_BEGIN(tag1, tag2) profiler_pair_begin(tag1, tag2)
+#define PROFILE_PAIR_END() profiler_pair_end()
+#else
+#define PROFILE_BEGIN(zone) ((void)0)
+#define PROFILE_END(zone) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_COUNT(counter) ((void)0)
+#define PROFILE_PAIR_BEGIN(tag1, tag2) ((void)0)
+#define PROFILE_PAIR_END() ((void)0)
+#endif
+
+/**
+ * Starts timing a zone on the calling thread.
+ * Use PROFILE_BEGIN() instead, so it is compiled out of normal builds.
+ *
+ * @param zone the zone that starts
+ */
+void profiler_begin(profile_zone_e zone);
+
+/**
+ * Stops timing the zone most recently started on the calling thread,
+ * adding its time to the current frame and recording it for the trace.
+ * Asserts that it is the given zone.
+ *
+ * @param zone the zone that ends
+ */
+void profiler_end(profile_zone_e zone);
+
+/**
+ * Adds one to a counter in the current frame, and to the counter of the
+ * pair of tags being run, if any. Only the game thread counts.
+ * Use PROFILE_COUNT() instead, so it is compiled out of normal builds.
+ *
+ * @param counter the counter
+ */
+void profiler_count(profile_counter_e counter);
+
+/**
+ * Counts everything until profiler_pair_end() for a pair of tags as well
+ * as for the frame. The order of the tags doesn't matter.
+ * Pairs with a tag of PROFILER_MAX_TAGS or more are only counted for the frame.
+ * Use PROFILE_PAIR_BEGIN() instead, so it is compiled out of normal builds.
+ *
+ * @param tag1 the tag of the first body of each pair
+ * @param tag2 the tag of the second body of each pair
+ */
+void profiler_pair_begin(size_t tag1, size_t tag2);
+
+/**
+ * Stops counting for the pair of tags given to profiler_pair_begin().
+ * Use PROFILE_PAIR_END() instead, so it is compiled out of normal builds.
+ */
+void profiler_pair_end(void);
+
+/**
+ * Ends the current frame: the time of each zone and the counts of each
+ * counter since the last call are stored as one frame of the history
+ * and a new frame starts.
+ * Zones still running are counted in the frame they end in.
+ */
+void profiler_frame_end(void);
+
+/**
+ * Forgets every frame and trace event recorded so far.
+ * Must not be called while zones are running.
+ */
+void profiler_reset(void);
+
+/**
+ * Gets the name of a zone, e.g. "scene_tick".
+ *
+ * @param zone the zone
+ * @return the name, which must not be freed
+ */
+const char *profile_zone_name(profile_zone_e zone);
+
+/**
+ * Gets how deep a zone was nested the last time it ran,
+ * 0 for a zone that ran inside no other zone.
+ *
+ * @param zone the zone
+ * @return the number of zones it ran inside of
+ */
+size_t profile_zone_depth(profile_zone_e zone);
+
+/**
+ * Gets the name of a counter, e.g. "pairs_tested".
+ *
+ * @param counter the counter
+ * @return the name, which must not be freed
+ */
+const char *profile_counter_name(profile_counter_e counter);
+
+/**
+ * Gets the count of a counter in the last frame that ended.
+ * Can be called from any thread, e.g. to draw an overlay.
+ *
+ * @param counter the counter
+ * @return the count, or 0 before the first frame ends
+ */
+size_t profiler_counter_frame(profile_counter_e counter);
+
+/**
+ * Gets the count of a counter for a pair of tags in the last frame that ended.
+ *
+ * @param tag1 one tag of the pair, less than PROFILER_MAX_TAGS
+ * @param tag2 the other tag, less than PROFILER_MAX_TAGS
+ * @param counter the counter
+ * @return the count, or 0 before the first frame ends
+ */
+size_t profiler_pair_frame(size_t tag1, size_t tag2, profile_counter_e counter);
+
+/**
+ * Gets the count of a counter for a pair of tags over every frame
+ * that ended since the profiler was last reset.
+ *
+ * @param tag1 one tag of the pair, less than PROFILER_MAX_TAGS
+ * @param tag2 the other tag, less than PROFILER_MAX_TAGS
+ * @param counter the counter
+ * @return the count
+ */
+size_t profiler_pair_total(size_t tag1, size_t tag2, profile_counter_e counter);
+
+/**
+ * Gets the average time a zone took per frame over the recent history.
+ * Can be called from any thread, e.g. to draw an overlay.
+ *
+ * @param zone the zone
+ * @return the average time in milliseconds, or 0 before the first frame ends
+ */
+double profiler_average_ms(profile_zone_e zone);
+
+/**
+ * Gets the number of frames in the history, which holds the most recent
+ * PROFILER_HISTORY_FRAMES frames.
+ *
+ * @return the number of frames that can be written by profiler_write_csv()
+ */
+size_t profiler_frames(void);
+
+/**
+ * Writes the time of every zone and the count of every counter in every
+ * frame of the history as CSV, one row per frame, with a column of
+ * milliseconds per zone followed by a column per counter.
+ *
+ * @param path the file to write
+ * @return whether the file could be written
+ */
+bool profiler_write_csv(const char *path);
+
+/**
+ * Writes the counters of every pair of tags that counted anything since
+ * the profiler was last reset as CSV, one row per pair with its tags,
+ * its total of each counter and the most pairs it tested in one frame.
+ *
+ * @param path the file to write
+ * @return whether the file could be written
+ */
+bool profiler_write_pairs_csv(const char *path);
+
+/**
+ * Writes the most recent zones as a Chrome trace,
+ * which can be opened in chrome://tracing or Perfetto.
+ *
+ * @param path the file to write
+ * @return whether the file could be written
+ */
+bool profiler_write_trace(const char *path);
+
+#endif // #ifndef __PROFILER_H__
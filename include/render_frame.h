@@ -0,0 +1,121 @@
+#ifndef __RENDER_FRAME_H__
+#define __RENDER_FRAME_H__
+
+#include "color.h"
+#include "scene.h"
+#include "text_box.h"
+#include "vector.h"
+
+/**
+ * A copy of everything needed to draw one frame of a scene.
+ * Once captured, a frame does not reference the scene's bodies or text boxes,
+ * so it can be drawn while the scene keeps ticking.
+ * The frame's buffers are reused by later captures, so capturing a scene of
+ * a similar size does not allocate.
+ */
+typedef struct render_frame render_frame_t;
+
+/**
+ * How to draw a single body of a captured frame.
+ */
+typedef struct render_item {
+    render_info_t render;
+    vector_t centroid;
+    double angle;
+    /** Index into render_frame_vertices() of the first vertex of the shape */
+    size_t first_vertex;
+    /** Number of vertices of the shape, 0 for textured bodies */
+    size_t vertex_count;
+} render_item_t;
+
+/**
+ * How to draw a single text box of a captured frame.
+ * The text is borrowed from the text box, which does not own it either.
+ */
+typedef struct render_text {
+    const char *text;
+    size_t font_size;
+    vector_t origin;
+    justification_e justification;
+} render_text_t;
+
+/**
+ * Allocates memory for an empty frame.
+ *
+ * @return the new frame
+ */
+render_frame_t *render_frame_init(void);
+
+/**
+ * Releases the memory allocated for a frame.
+ *
+ * @param frame a frame returned from render_frame_init()
+ */
+void render_frame_free(render_frame_t *frame);
+
+/**
+ * Replaces the contents of a frame with the current state of a scene.
+ * Only solid-colored bodies have their vertices copied;
+ * textured bodies are fully described by their centroid and angle.
+ * The bodies are sorted by layer (see body_set_layer()), back to front,
+ * and keep their scene order within a layer.
+ *
+ * @param frame a frame returned from render_frame_init()
+ * @param scene the scene to capture
+ */
+void render_frame_capture(render_frame_t *frame, const scene_t *scene);
+
+/**
+ * Gets the number of bodies captured in a frame.
+ *
+ * @param frame a frame returned from render_frame_init()
+ * @return the number of bodies, in drawing order
+ */
+size_t render_frame_items(const render_frame_t *frame);
+
+/**
+ * Gets a captured body of a frame.
+ * Asserts that the index is valid.
+ *
+ * @param frame a frame returned from render_frame_init()
+ * @param index the index of the body (starting at 0)
+ * @return a pointer to the captured body, valid until the next capture
+ */
+const render_item_t *render_frame_get_item(const render_frame_t *frame, size_t index);
+
+/**
+ * Gets the number of vertices of all captured shapes of a frame.
+ *
+ * @param frame a frame returned from render_frame_init()
+ * @return the length of the array returned by render_frame_vertices()
+ */
+size_t render_frame_vertex_count(const render_frame_t *frame);
+
+/**
+ * Gets the vertices of all captured shapes of a frame.
+ * The vertices of an item start at item->first_vertex.
+ *
+ * @param frame a frame returned from render_frame_init()
+ * @return the vertex array, valid until the next capture
+ */
+const vector_t *render_frame_vertices(const render_frame_t *frame);
+
+/**
+ * Gets the number of text boxes captured in a frame.
+ *
+ * @param frame a frame returned from render_frame_init()
+ * @return the number of text boxes
+ */
+size_t render_frame_texts(const render_frame_t *frame);
+
+/**
+ * Gets a captured text box of a frame.
+ * Asserts that the index is valid.
+ *
+ * @param frame a frame returned from render_frame_init()
+ * @param index the index of the text box (starting at 0)
+ * @return a pointer to the captured text box, valid until the next capture
+ */
+const render_text_t *render_frame_get_text(const render_frame_t *frame, size_t index);
+
+#endif // #ifndef __RENDER_FRAME_H__
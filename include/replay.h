@@ -0,0 +1,81 @@
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * A recording of the input to a series of games: each game's seed and,
+ * for every tick, the keys that were held and the time that passed.
+ * Since the game is deterministic for a given seed, replaying the
+ * recording plays the same games again.
+ *
+ * The file starts with REPLAY_MAGIC and REPLAY_VERSION, followed by
+ * records of a one-byte type and a value, in the machine's byte order:
+ * a game's seed, the held keys whenever they change, and each tick's time.
+ */
+typedef struct replay replay_t;
+
+/**
+ * Starts recording to a file, replacing it if it exists.
+ *
+ * @param path the file to write
+ * @return the new recording, or NULL if the file can't be opened
+ */
+replay_t *replay_record(const char *path);
+
+/**
+ * Reads a recording from a file to be replayed.
+ *
+ * @param path a file written by a recording
+ * @return the replay, positioned before its first game,
+ *         or NULL if the file can't be read or isn't a recording
+ */
+replay_t *replay_load(const char *path);
+
+/**
+ * Finishes writing a recording or releases a replay.
+ *
+ * @param replay a replay returned from replay_record() or replay_load()
+ * @return whether a recording was completely written
+ */
+bool replay_free(replay_t *replay);
+
+/**
+ * Records the start of a game. Its ticks follow.
+ *
+ * @param replay a replay returned from replay_record()
+ * @param seed the game's seed
+ */
+void replay_record_game(replay_t *replay, uint64_t seed);
+
+/**
+ * Records one tick of the current game.
+ *
+ * @param replay a replay returned from replay_record()
+ * @param key_down the bitmask of the keys held during the tick
+ * @param dt the time the tick advanced the game by
+ */
+void replay_record_tick(replay_t *replay, size_t key_down, double dt);
+
+/**
+ * Moves to the start of the next game, skipping the rest of the current one.
+ *
+ * @param replay a replay returned from replay_load()
+ * @param seed set to the game's seed
+ * @return whether there is another game
+ */
+bool replay_next_game(replay_t *replay, uint64_t *seed);
+
+/**
+ * Reads the next tick of the current game.
+ *
+ * @param replay a replay returned from replay_load()
+ * @param key_down set to the bitmask of the keys held during the tick
+ * @param dt set to the time the tick advanced the game by
+ * @return whether the game has another tick; if not, nothing is set
+ */
+bool replay_next_tick(replay_t *replay, size_t *key_down, double *dt);
+
+#endif // #ifndef __REPLAY_H__
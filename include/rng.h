@@ -0,0 +1,74 @@
+#ifndef __RNG_H__
+#define __RNG_H__
+
+#include <stdint.h>
+#include "vector.h"
+
+/**
+ * A seedable pseudo-random number generator (xoshiro256**).
+ * Two generators made with the same seed and stream always produce the same
+ * numbers, so a run that draws all of its randomness from them can be replayed.
+ * rng_t is defined here instead of rng.c because it is passed *by value*.
+ */
+typedef struct {
+    uint64_t state[4];
+} rng_t;
+
+/**
+ * Returns a generator for one stream of a seed.
+ * Different streams of the same seed produce unrelated numbers, so each part of
+ * a program can have its own stream without drawing numbers from the others.
+ *
+ * @param seed the seed of the whole run
+ * @param stream which stream of the seed to use
+ * @return a generator in its starting state
+ */
+rng_t rng_init(uint64_t seed, uint64_t stream);
+
+/**
+ * Returns the next 64 random bits of a generator.
+ *
+ * @param rng a pointer to a generator returned from rng_init()
+ * @return a uniformly random 64-bit number
+ */
+uint64_t rng_next(rng_t *rng);
+
+/**
+ * Returns a random double in the range [0, 1)
+ *
+ * @param rng a pointer to a generator returned from rng_init()
+ * @return a uniformly random double in the range [0, 1)
+ */
+double rng_double(rng_t *rng);
+
+/**
+ * Returns a random double in the range [min, max)
+ *
+ * @param rng a pointer to a generator returned from rng_init()
+ * @param min the minimum value desired
+ * @param max the maximum value desired, max must be > min
+ * @return a random double in the range [min, max)
+ */
+double rng_range(rng_t *rng, double min, double max);
+
+/**
+ * Returns a random integer in the range [min, max]
+ *
+ * @param rng a pointer to a generator returned from rng_init()
+ * @param min the minimum value desired
+ * @param max the maximum value desired, max must be >= min
+ * @return a random integer in the range [min, max]
+ */
+int rng_int_range(rng_t *rng, int min, int max);
+
+/**
+ * Returns a random vector in the range between the two given vectors
+ *
+ * @param rng a pointer to a generator returned from rng_init()
+ * @param min the min vector
+ * @param max the max vector
+ * @return a random vector generated with given min and max
+ */
+vector_t rng_vec(rng_t *rng, vector_t min, vector_t max);
+
+#endif // #ifndef __RNG_H__
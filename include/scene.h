@@ -4,6 +4,7 @@
 #include "body.h"
 #include "text_box.h"
 #include "list.h"
+#include "scheduler.h"
 
 /**
  * A collection of bodies and force creators.
@@ -19,6 +20,34 @@ typedef struct scene scene_t;
  */
 typedef void (*force_creator_t)(void *aux);
 
+/**
+ * A force creator that acts on one pair of bodies at a time.
+ * See scene_add_pair_force_creator().
+ */
+typedef void (*pair_force_creator_t)(body_t *body1, body_t *body2, void *aux);
+
+/**
+ * A force creator that acts on every body with one tag in a single call.
+ * See scene_add_tag_force_creator().
+ */
+typedef void (*tag_force_creator_t)(body_t **bodies, size_t count, void *aux);
+
+/**
+ * Handles a contact between two bodies, e.g. a collision.
+ * See scene_add_contact().
+ */
+typedef void (*contact_handler_t)(body_t *body1, body_t *body2, vector_t axis, void *aux);
+
+/**
+ * A change to a scene that a contact handler defers, e.g. spawning a body.
+ * Takes the auxiliary value and a copy of the args it was queued with.
+ * See scene_defer().
+ */
+typedef void (*scene_command_t)(void *aux, const void *args);
+
+// The most bytes of args a command can be queued with
+#define SCENE_COMMAND_ARGS_SIZE 64
+
 /**
  * Allocates memory for an empty scene.
  * Makes a reasonable guess of the number of bodies to allocate space for.
@@ -31,11 +60,77 @@ scene_t *scene_init(void);
 /**
  * Releases memory allocated for a given scene
  * and all the bodies and force creators it contains.
+ * Bodies are given to body_release(), so pooled bodies go back to their pool,
+ * which must be freed after the scene.
  *
  * @param scene a pointer to a scene returned from scene_init()
  */
 void scene_free(scene_t *scene);
 
+/**
+ * Sets the rectangle that cullable bodies must stay in.
+ * At the start of each tick, a cullable body whose bounding circle is
+ * entirely outside the rectangle is marked for removal.
+ * See body_set_cullable() and body_get_bounding_radius().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param min the bottom left corner of the rectangle
+ * @param max the top right corner of the rectangle
+ */
+void scene_set_kill_box(scene_t *scene, vector_t min, vector_t max);
+
+/**
+ * Gets the rectangle set by scene_set_kill_box(), if there is one.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param min set to the bottom left corner of the rectangle, if there is one
+ * @param max set to the top right corner of the rectangle, if there is one
+ * @return whether the scene has a kill box
+ */
+bool scene_get_kill_box(const scene_t *scene, vector_t *min, vector_t *max);
+
+/**
+ * Sets the rectangle that wrapping bodies loop around.
+ * After moving in a tick, a wrapping body whose bounding circle is entirely
+ * past one side of the rectangle is moved by the rectangle's width or height
+ * so it comes back from the opposite side.
+ * See body_set_wrapping().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param min the bottom left corner of the rectangle
+ * @param max the top right corner of the rectangle
+ */
+void scene_set_wrap_box(scene_t *scene, vector_t min, vector_t max);
+
+/**
+ * Gets the rectangle set by scene_set_wrap_box(), if there is one.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param min set to the bottom left corner of the rectangle, if there is one
+ * @param max set to the top right corner of the rectangle, if there is one
+ * @return whether the scene has a wrap box
+ */
+bool scene_get_wrap_box(const scene_t *scene, vector_t *min, vector_t *max);
+
+/**
+ * Adds a timer that goes off during scene_tick(), before any forces are
+ * applied, once the scene's clock reaches it. See scheduler_add().
+ * The timer is freed with the scene.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param delay the number of seconds of ticks until the timer first goes off
+ * @param callback the function to call when the timer goes off
+ * @param aux the value passed to callback
+ * @param freer if non-NULL, a function to call on aux once the timer stops
+ */
+void scene_schedule(
+    scene_t *scene,
+    double delay,
+    timer_callback_t callback,
+    void *aux,
+    free_func_t freer
+);
+
 /**
  * Gets the number of bodies in a given scene.
  *
@@ -54,6 +149,8 @@ size_t scene_text_boxes(const scene_t *scene);
 
 /**
  * Gets the body at a given index in a scene.
+ * Removing bodies in scene_tick() moves the last body into the freed index,
+ * so indices are only stable between ticks.
  * Asserts that the index is valid.
  *
  * @param scene a pointer to a scene returned from scene_init()
@@ -94,8 +191,55 @@ text_box_t *scene_get_text_box(scene_t *scene, size_t index);
  */
 const text_box_t *scene_borrow_text_box(const scene_t *scene, size_t index);
 
+/**
+ * Gets the number of bodies in a scene with a given tag.
+ * The scene keeps an index of its bodies by body_get_tag(),
+ * so this takes constant time.
+ * Bodies marked for removal are counted until the end of the tick.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param tag the tag to look up
+ * @return the number of bodies with that tag
+ */
+size_t scene_tagged_bodies(const scene_t *scene, size_t tag);
+
+/**
+ * Gets one of the bodies in a scene with a given tag.
+ * Like scene_get_body(), indices are only stable between ticks.
+ * Asserts that the index is valid.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param tag the tag to look up
+ * @param index the index of the body among those with the tag (starting at 0)
+ * @return a pointer to the body at the given index
+ */
+body_t *scene_get_tagged_body(scene_t *scene, size_t tag, size_t index);
+
+/**
+ * Makes room for the given number of bodies and of queued contacts
+ * (see scene_add_contact()), so a scene that stays within them
+ * never reallocates while it ticks. A handler queues at most a command or
+ * so (see scene_defer()), so room is made for as many commands as contacts.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param bodies the number of bodies to make room for
+ * @param contacts the number of contacts per tick to make room for
+ */
+void scene_reserve(scene_t *scene, size_t bodies, size_t contacts);
+
+/**
+ * Makes room in the index of bodies with a tag for the given number of them.
+ * See scene_tagged_bodies().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param tag the tag, which must not be BODY_TAG_NONE
+ * @param bodies the number of bodies with that tag to make room for
+ */
+void scene_reserve_tag(scene_t *scene, size_t tag, size_t bodies);
+
 /**
  * Adds a body to a scene.
+ * Its tag must be set first, see body_set_tag().
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param body a pointer to the body to add to the scene
@@ -164,12 +308,134 @@ void scene_add_bodies_force_creator(
     free_func_t freer
 );
 
+/**
+ * Adds a force creator that acts on every pair of bodies with the given tags,
+ * to be invoked for each pair every time scene_tick() is called.
+ * Bodies are matched by body_get_tag(), so the force creator applies to
+ * bodies added after it as well, and removing a body never removes it.
+ * If both tags are equal, each unordered pair of distinct bodies is passed once.
+ * A pair force creator that finds contacts, like a collision, should queue
+ * them with scene_add_contact() rather than change the scene itself.
+ * Bodies added while a pair force creator runs are only matched
+ * by the force creators that start after they were added.
+ * Bodies marked for removal are skipped.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param tag1 the tag of the bodies passed as body1
+ * @param tag2 the tag of the bodies passed as body2
+ * @param forcer a pair force creator function
+ * @param aux an auxiliary value to pass to forcer when it is called
+ * @param freer if non-NULL, a function to call in order to free aux
+ */
+void scene_add_pair_force_creator(
+    scene_t *scene,
+    size_t tag1,
+    size_t tag2,
+    pair_force_creator_t forcer,
+    void *aux,
+    free_func_t freer
+);
+
+/**
+ * Adds a force creator that acts on all the bodies with the given tag at once,
+ * to be invoked every time scene_tick() is called.
+ * The bodies are passed as one array (see scene_get_tagged_body()),
+ * so a behaviour shared by many bodies can update all of them in a single loop.
+ * The array includes bodies marked for removal during this tick,
+ * and forcer must not add bodies with the same tag while using it.
+ * Tag force creators run before the pair force creators.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param tag the tag of the bodies to pass
+ * @param forcer a tag force creator function
+ * @param aux an auxiliary value to pass to forcer when it is called
+ * @param freer if non-NULL, a function to call in order to free aux
+ */
+void scene_add_tag_force_creator(
+    scene_t *scene,
+    size_t tag,
+    tag_force_creator_t forcer,
+    void *aux,
+    free_func_t freer
+);
+
+/**
+ * Queues a contact between two bodies found by a force creator, e.g. a
+ * collision found by create_collision(). The handler is called once all the
+ * force creators, tag force creators and pair force creators of the tick
+ * have run, so it can add bodies and force creators without changing what
+ * the force creators iterate over.
+ * The contacts are handled in the order they were queued. A contact is
+ * skipped if either of its bodies was removed by then, e.g. by the handler
+ * of an earlier contact, unless it is queued with handle_removed.
+ * Contacts queued outside of scene_tick() are handled in the next tick.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body1 the first body of the contact
+ * @param body2 the second body of the contact
+ * @param axis the axis of the contact, passed to the handler
+ * @param handler the function to call with the bodies, the axis and aux
+ * @param aux an auxiliary value to pass to handler, owned by the caller
+ * @param handle_removed whether to call handler even if a body was removed
+ */
+void scene_add_contact(
+    scene_t *scene,
+    body_t *body1,
+    body_t *body2,
+    vector_t axis,
+    contact_handler_t handler,
+    void *aux,
+    bool handle_removed
+);
+
+/**
+ * Gets the number of contacts queued with scene_add_contact()
+ * that haven't been handled yet.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the number of contacts waiting to be handled
+ */
+size_t scene_contacts(const scene_t *scene);
+
+/**
+ * Queues a command to run once every contact of the tick has been handled,
+ * before removed bodies are reaped. Contact handlers queue the bodies they
+ * spawn and the force creators they add this way, so each handler only
+ * changes the bodies it was given, and every contact of a tick sees the
+ * same set of bodies and force creators.
+ * Commands run in the order they were queued; a command queued by another
+ * runs in the same batch. Commands queued outside of scene_tick() run
+ * in the next tick, and ones still queued when the scene is freed never run.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param run the function to call with aux and the copy of args
+ * @param aux an auxiliary value to pass to run, owned by the caller
+ * @param args copied into the queue, so it may point to the caller's stack
+ * @param args_size the size of args, at most SCENE_COMMAND_ARGS_SIZE
+ */
+void scene_defer(scene_t *scene, scene_command_t run, void *aux, const void *args, size_t args_size);
+
+/**
+ * Gets the number of commands queued with scene_defer() that haven't run yet.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the number of commands waiting to run
+ */
+size_t scene_commands(const scene_t *scene);
+
 /**
  * Executes a tick of a given scene over a small time interval.
- * This requires executing all the force creators
- * and then ticking each body (see body_tick()).
+ * This requires firing the timers that are due (see scene_schedule()),
+ * removing cullable bodies outside the kill box
+ * (see scene_set_kill_box()), executing all the force creators, then the tag and pair
+ * force creators, then handling the contacts they queued (see scene_add_contact()),
+ * then running the commands the handlers queued (see scene_defer()),
+ * and then ticking each body (see body_tick()) and wrapping it
+ * if needed (see scene_set_wrap_box()).
  * If any bodies are marked for removal, they should be removed from the scene
- * and freed, along with any force creators acting on them.
+ * and released (see body_release()), and any force creators acting on them freed.
+ * Removal does not preserve the order of the remaining bodies;
+ * use body_set_layer() to control the order bodies are drawn in.
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param dt the time elapsed since the last tick, in seconds
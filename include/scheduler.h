@@ -0,0 +1,87 @@
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+
+#include <stddef.h>
+#include "list.h"
+
+/**
+ * Returned by a timer callback to stop the timer instead of repeating it.
+ */
+#define TIMER_STOP (-1.0)
+
+/**
+ * A function called when a timer goes off.
+ *
+ * @param aux the value passed to scheduler_add()
+ * @return the number of seconds until the timer should go off again,
+ *   or TIMER_STOP to remove it
+ */
+typedef double (*timer_callback_t)(void *aux);
+
+/**
+ * A set of timers kept in a min-heap ordered by when they go off,
+ * so adding a timer and firing the next one take O(log n) time.
+ * Timers that go off at the same time fire in the order they were added.
+ */
+typedef struct scheduler scheduler_t;
+
+/**
+ * Allocates memory for an empty scheduler whose clock starts at 0.
+ *
+ * @return a pointer to the newly allocated scheduler
+ */
+scheduler_t *scheduler_init(void);
+
+/**
+ * Releases the memory allocated for a scheduler and frees the aux
+ * of every timer that has not stopped.
+ *
+ * @param scheduler a pointer to a scheduler returned from scheduler_init()
+ */
+void scheduler_free(scheduler_t *scheduler);
+
+/**
+ * Adds a timer. A callback that returns a delay makes the timer repeat,
+ * measured from when it was due rather than from when it fired.
+ * Timers can be added from inside a callback.
+ *
+ * @param scheduler a pointer to a scheduler returned from scheduler_init()
+ * @param delay the number of seconds from now until the timer first goes off
+ * @param callback the function to call when the timer goes off
+ * @param aux the value passed to callback
+ * @param freer if non-NULL, a function to call on aux once the timer stops
+ */
+void scheduler_add(
+    scheduler_t *scheduler,
+    double delay,
+    timer_callback_t callback,
+    void *aux,
+    free_func_t freer
+);
+
+/**
+ * Moves the scheduler's clock forward and fires every timer that is due,
+ * in the order they are due.
+ *
+ * @param scheduler a pointer to a scheduler returned from scheduler_init()
+ * @param dt the number of seconds to move forward
+ */
+void scheduler_advance(scheduler_t *scheduler, double dt);
+
+/**
+ * Gets the number of timers that have not stopped.
+ *
+ * @param scheduler a pointer to a scheduler returned from scheduler_init()
+ * @return the number of timers waiting to go off
+ */
+size_t scheduler_timers(const scheduler_t *scheduler);
+
+/**
+ * Gets the total time the scheduler has been advanced by.
+ *
+ * @param scheduler a pointer to a scheduler returned from scheduler_init()
+ * @return the scheduler's clock, in seconds
+ */
+double scheduler_time(const scheduler_t *scheduler);
+
+#endif // #ifndef __SCHEDULER_H__
@@ -7,49 +7,47 @@
 #include "scene.h"
 #include "vector.h"
 #include "text_box.h"
+#include "render_frame.h"
+#include "backend.h"
 #include <SDL2/SDL_render.h>
 
-// Values passed to a key handler when the given arrow key is pressed
-#define LEFT_ARROW 1
-#define UP_ARROW 2
-#define RIGHT_ARROW 3
-#define DOWN_ARROW 4
-#define ATTACK1_BUTTON 5
-#define ATTACK2_BUTTON 6
-#define ESCAPE 7
-
 /**
- * The possible types of key events.
- * Enum types in C are much more primitive than in Java; this is equivalent to:
- * typedef unsigned int KeyEventType;
- * #define KEY_PRESSED 0
- * #define KEY_RELEASED 1
+ * Initializes the SDL window and renderer.
+ * Must be called once before any of the other SDL functions.
+ *
+ * @param min the x and y coordinates of the bottom left of the scene
+ * @param max the x and y coordinates of the top right of the scene
  */
-typedef enum key_event_type {
-    KEY_PRESSED,
-    KEY_RELEASED
-} key_event_type_t;
+void sdl_init(vector_t min, vector_t max);
 
 /**
- * A keypress handler.
- * When a key is pressed or released, the handler is passed its char value.
- * Most keys are passed as their char value, e.g. 'a', '1', or '\r'.
- * Arrow keys have the special values listed above.
+ * Initializes a renderer that draws into an offscreen surface
+ * the size of the window, so no display is needed.
+ * Use this instead of sdl_init(), not in addition to it.
  *
- * @param key a character indicating which key was pressed
- * @param type the type of key event (KEY_PRESSED or KEY_RELEASED)
- * @param held_time if a press event, the time the key has been held in seconds
+ * @param min the x and y coordinates of the bottom left of the scene
+ * @param max the x and y coordinates of the top right of the scene
  */
-typedef void (*key_handler_t)(char key, key_event_type_t type, double held_time, void *data);
+void sdl_init_headless(vector_t min, vector_t max);
 
 /**
- * Initializes the SDL window and renderer.
- * Must be called once before any of the other SDL functions.
+ * Configures runs that use HEADLESS_BACKEND.
+ * A headless run stops after a fixed number of frames, each of which
+ * advances the game by the same amount of time, and prints how long
+ * the frames took in real time.
  *
- * @param min the x and y coordinates of the bottom left of the scene
- * @param max the x and y coordinates of the top right of the scene
+ * @param frame_limit the number of frames to run before stopping
+ * @param rasterize whether frames are drawn into the offscreen surface;
+ *        otherwise they are only captured and then discarded
  */
-void sdl_init(vector_t min, vector_t max);
+void sdl_configure_headless(size_t frame_limit, bool rasterize);
+
+/**
+ * Prints how long the frames of a headless run took, if it hasn't yet.
+ * Runs report when they reach their frame limit; this reports
+ * a run that ends before it. Does nothing if no headless frames have run.
+ */
+void sdl_headless_report(void);
 
 void sdl_set_background_color(rgb_color_t color);
 
@@ -64,6 +62,8 @@ void sdl_set_font(const char *font_path);
 /**
  * Processes all SDL events and returns whether the window has been closed.
  * This function must be called in order to handle keypresses.
+ * While sdl_run() runs the game, the main thread polls the events,
+ * and this passes the ones it has read to the key handler.
  *
  * @return true if the window was closed, false otherwise
  */
@@ -75,28 +75,54 @@ bool sdl_is_done(void *data);
 void sdl_clear(void);
 
 /**
- * Draws a polygon from the given list of vertices and a color.
+ * Draws one captured body of a frame.
+ * Solid-colored shapes are filled with their color,
+ * textured bodies are drawn as a rotated sprite.
  *
- * @param points the list of vertices of the polygon
- * @param color the color used to fill in the polygon
+ * @param item the captured body to draw
+ * @param pixels the vertices of the item's frame, already mapped to pixels
  */
-void sdl_draw_polygon(const body_t *body, vector_t window_center);
+void sdl_draw_item(const render_item_t *item, const SDL_FPoint *pixels);
 
 /**
  * Displays the rendered frame on the SDL window.
  * Must be called after drawing the polygons in order to show them.
  */
-void sdl_show(vector_t window_center);
+void sdl_show(void);
 
 /**
- * Draws all bodies in a scene.
- * This internally calls sdl_clear(), sdl_draw_polygon(), and sdl_show(),
+ * Draws all bodies and text boxes of a captured frame.
+ * This internally calls sdl_clear(), sdl_draw_item(), and sdl_show(),
  * so those functions should not be called directly.
+ * All vertices are mapped to pixels in a single pass before drawing,
+ * using a transform that is only recomputed when the window is resized.
+ *
+ * @param frame the frame to draw
+ */
+void sdl_render_frame(const render_frame_t *frame);
+
+/**
+ * Draws all bodies in a scene.
+ * The scene is captured into a render_frame_t first. If sdl_run() is
+ * running the game, the frame is handed to the main thread and this returns
+ * without drawing, so the caller can tick the scene again while it is drawn.
  *
  * @param scene the scene to draw
  */
 void sdl_render_scene(const scene_t *scene);
 
+/**
+ * Runs a game on a thread of its own until it returns, while the calling
+ * thread polls events and draws the frames published by sdl_render_scene().
+ * Frames that are published faster than they can be drawn are skipped.
+ * Must be called on the main thread, which sdl_init() created the window
+ * and renderer on. The game must not call the other SDL functions that
+ * draw or load textures, e.g. sdl_atlas_init(); call them before or after.
+ *
+ * @param game the game, which ticks and draws its scenes
+ */
+void sdl_run(void (*game)(void));
+
 /**
  * Registers a function to be called every time a key is pressed.
  * Overwrites any existing handler.
@@ -128,11 +154,57 @@ void sdl_on_key(key_handler_t handler);
 SDL_Texture *sdl_load_texture(char *file);
 
 /**
- * Gets the amount of time that has passed since the last time
- * this function was called, in seconds.
+ * Loads the given image files and packs them into one texture.
+ * The atlas also reserves a white texel so that solid-colored polygons
+ * can be drawn in the same batch as the sprites.
+ * Only one atlas is active at a time; the newest one is used for batching.
+ *
+ * @param files the paths of the images to pack
+ * @param count the number of paths in files
+ * @return the new atlas, which must be freed with sdl_atlas_free()
+ */
+sdl_atlas_t *sdl_atlas_init(const char *const *files, size_t count);
+
+/**
+ * Releases an atlas and its texture.
  *
- * @return the number of seconds that have elapsed
+ * @param atlas an atlas returned from sdl_atlas_init()
+ */
+void sdl_atlas_free(sdl_atlas_t *atlas);
+
+/**
+ * Gets the amount of wall-clock time that has passed since the last time
+ * this function was called, in seconds, measured with a monotonic clock.
+ * If a frame rate is set with sdl_set_frame_rate(), first waits until
+ * the frame has lasted long enough.
+ *
+ * @return the number of seconds that have elapsed, or 0 the first time
  */
 double time_since_last_tick(void);
 
+/**
+ * Limits how often time_since_last_tick() lets frames end.
+ *
+ * @param fps the most frames per second, or 0 for no limit
+ */
+void sdl_set_frame_rate(double fps);
+
+/**
+ * Gets the clock that times the frames ended by time_since_last_tick().
+ *
+ * @return the frame clock, which holds the recent frame times
+ */
+const frame_clock_t *sdl_frame_clock(void);
+
+/**
+ * Draws into a window and reads input from the keyboard and mouse.
+ */
+extern const backend_t SDL_BACKEND;
+
+/**
+ * Runs without a display, as configured by sdl_configure_headless().
+ * Input comes from a scripted player instead of the keyboard.
+ */
+extern const backend_t HEADLESS_BACKEND;
+
 #endif // #ifndef __SDL_WRAPPER_H__
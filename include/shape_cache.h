@@ -0,0 +1,108 @@
+#ifndef __SHAPE_CACHE_H__
+#define __SHAPE_CACHE_H__
+
+#include <stddef.h>
+#include "list.h"
+#include "vector.h"
+
+/**
+ * The vertices of one polygon_*() shape with radius 1 centered at the origin,
+ * shared by every body built from it (see body_init_template()).
+ * Such a body keeps only its scale, angle and position, and derives its
+ * vertices from the template's, so no trigonometry is done per body.
+ */
+typedef struct shape_template shape_template_t;
+
+/**
+ * A set of shape templates, each built the first time it is asked for.
+ */
+typedef struct shape_cache shape_cache_t;
+
+/**
+ * Allocates memory for an empty shape cache.
+ *
+ * @return a pointer to the newly allocated cache
+ */
+shape_cache_t *shape_cache_init(void);
+
+/**
+ * Releases the memory allocated for a shape cache and all its templates.
+ *
+ * @param cache a pointer to a cache returned from shape_cache_init()
+ */
+void shape_cache_free(shape_cache_t *cache);
+
+/**
+ * Gets the template of a regular polygon. See polygon_reg_ngon().
+ *
+ * @param cache a pointer to a cache returned from shape_cache_init()
+ * @param n the number of vertices
+ * @return the template, owned by the cache
+ */
+const shape_template_t *shape_cache_ngon(shape_cache_t *cache, size_t n);
+
+/**
+ * Gets the template of a star. See polygon_star().
+ *
+ * @param cache a pointer to a cache returned from shape_cache_init()
+ * @param ratio the inner radius divided by the outer radius
+ * @param degree the number of points of the star
+ * @return the template, owned by the cache
+ */
+const shape_template_t *shape_cache_star(shape_cache_t *cache, double ratio, size_t degree);
+
+/**
+ * Gets the template of a regular polygon with a sector cut out.
+ * See polygon_ngon_sector().
+ *
+ * @param cache a pointer to a cache returned from shape_cache_init()
+ * @param N the number of vertices of the whole polygon
+ * @param n the number of vertices cut out
+ * @param theta the angle the cut out sector is centered on
+ * @return the template, owned by the cache
+ */
+const shape_template_t *shape_cache_sector(shape_cache_t *cache, size_t N, size_t n, double theta);
+
+/**
+ * Gets the number of templates a cache has built.
+ *
+ * @param cache a pointer to a cache returned from shape_cache_init()
+ * @return the number of distinct shapes asked for so far
+ */
+size_t shape_cache_size(const shape_cache_t *cache);
+
+/**
+ * Gets the number of vertices of a template.
+ *
+ * @param shape a template returned from a shape cache
+ * @return the number of vertices
+ */
+size_t shape_template_size(const shape_template_t *shape);
+
+/**
+ * Gets the vertices of a template, as polygon_*() would build them
+ * with radius 1 at the origin.
+ *
+ * @param shape a template returned from a shape cache
+ * @return an array of shape_template_size() vertices, owned by the template
+ */
+const vector_t *shape_template_vertices(const shape_template_t *shape);
+
+/**
+ * Gets the centroid of a template, which is not the origin for every shape,
+ * e.g. a polygon with a sector cut out.
+ *
+ * @param shape a template returned from a shape cache
+ * @return the centroid of the template's vertices
+ */
+vector_t shape_template_centroid(const shape_template_t *shape);
+
+/**
+ * Gets how far the template's farthest vertex is from its centroid.
+ *
+ * @param shape a template returned from a shape cache
+ * @return the bounding radius of the template about its centroid
+ */
+double shape_template_radius(const shape_template_t *shape);
+
+#endif // #ifndef __SHAPE_CACHE_H__
@@ -0,0 +1,101 @@
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "body.h"
+#include "color.h"
+#include "scene.h"
+
+/**
+ * How the game's own state is saved alongside a scene's bodies.
+ * The engine saves each body's shape, motion, flags and how it is drawn,
+ * but not what its info or the scene's force creators mean; the game
+ * writes those into fixed-size records of its own, field by field with
+ * the snapshot_put_*() functions so they load on any machine.
+ */
+typedef struct snapshot_codec {
+    // bytes saved with each body, e.g. for its info, or 0 for none
+    size_t info_size;
+    // bytes saved with the scene, e.g. which force creators it has, or 0
+    size_t scene_size;
+    // passed to every function below
+    void *aux;
+
+    // Writes a body's record of info_size bytes, which starts zeroed,
+    // with the snapshot_put_*() functions so it loads on any machine.
+    // The body is at index in the scene.
+    void (*save_info)(scene_t *scene, size_t index, void *out, void *aux);
+    // Restores a body's info from its record. bodies holds every loaded
+    // body in the order they were saved, to resolve references between them.
+    void (*load_info)(body_t *body, const void *in, body_t *const *bodies, void *aux);
+    // Writes the scene's record of scene_size bytes
+    void (*save_scene)(scene_t *scene, void *out, void *aux);
+    // Restores the scene's state, e.g. its force creators, from its record
+    void (*load_scene)(scene_t *scene, const void *in, body_t *const *bodies, size_t count, void *aux);
+
+    // Gets the atlas image with the given index, which is how textured
+    // bodies are saved. Needed if any body has a texture.
+    sprite_t (*asset_sprite)(uint32_t asset, void *aux);
+} snapshot_codec_t;
+
+/**
+ * Saves every body in a scene, including ones that are removed
+ * but not yet freed, in the order they are in the scene,
+ * and the scene's kill box and wrap box.
+ * The file starts with SNAPSHOT_MAGIC and SNAPSHOT_VERSION. Every field
+ * is written on its own in little-endian order, with no padding,
+ * so the file loads on any machine.
+ * Textures are saved by their place in their atlas, so nothing is written
+ * if a body's texture isn't in one.
+ *
+ * @param scene the scene to save
+ * @param codec how to save the game's state, or NULL to save only the bodies
+ * @param path the file to write
+ * @return whether the file was written
+ */
+bool snapshot_save(scene_t *scene, const snapshot_codec_t *codec, const char *path);
+
+/**
+ * Adds the bodies saved by snapshot_save() to a scene, after any it has,
+ * sets the kill box and wrap box the saved scene had,
+ * and restores the game's state with the codec.
+ * The file is read with a single read, and its bodies are built
+ * straight from its fixed-size records. A file that is cut short or
+ * has extra bytes is rejected.
+ *
+ * @param scene the scene to add the bodies to, usually an empty one
+ * @param codec the codec the snapshot was saved with, or NULL if none was
+ * @param path a file written by snapshot_save()
+ * @return whether the file was a snapshot saved with the same codec sizes;
+ *         if not, the scene is unchanged
+ */
+bool snapshot_load(scene_t *scene, const snapshot_codec_t *codec, const char *path);
+
+/**
+ * Writes a value into a codec's record in the snapshot's byte order,
+ * and moves out past it: 4 bytes for a u32, 8 for a u64 or f64
+ * and 16 for a vector. Signed values are written as their unsigned bits.
+ *
+ * @param out where to write, moved past the value
+ * @param value the value to write
+ */
+void snapshot_put_u32(uint8_t **out, uint32_t value);
+void snapshot_put_u64(uint8_t **out, uint64_t value);
+void snapshot_put_f64(uint8_t **out, double value);
+void snapshot_put_vec(uint8_t **out, vector_t value);
+
+/**
+ * Reads a value written by the matching snapshot_put_*() function,
+ * and moves in past it.
+ *
+ * @param in where to read, moved past the value
+ * @return the value
+ */
+uint32_t snapshot_get_u32(const uint8_t **in);
+uint64_t snapshot_get_u64(const uint8_t **in);
+double snapshot_get_f64(const uint8_t **in);
+vector_t snapshot_get_vec(const uint8_t **in);
+
+#endif // #ifndef __SNAPSHOT_H__
@@ -0,0 +1,129 @@
+#include "alloc_track.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+const char *const ALLOC_SITE_NAMES[ALLOC_SITE_COUNT] = {
+    [ALLOC_BODY] = "body",
+    [ALLOC_SHAPE] = "shape",
+    [ALLOC_VERTEX] = "vertex",
+    [ALLOC_BUNDLE] = "bundle",
+    [ALLOC_AUX] = "aux",
+    [ALLOC_LIST] = "list",
+    [ALLOC_OTHER] = "other",
+};
+
+// What each site did in the frame that hasn't ended yet
+alloc_stats_t current_frame[ALLOC_SITE_COUNT];
+alloc_stats_t last_frame[ALLOC_SITE_COUNT];
+alloc_stats_t totals[ALLOC_SITE_COUNT];
+// The most allocations each site made in one frame
+size_t peak_allocs[ALLOC_SITE_COUNT];
+size_t frames_ended = 0;
+size_t frame_budget = SIZE_MAX;
+bool frame_exempt = false;
+
+void alloc_count(alloc_site_e site, size_t size) {
+    assert(site < ALLOC_SITE_COUNT);
+    current_frame[site].allocs++;
+    current_frame[site].bytes += size;
+    totals[site].allocs++;
+    totals[site].bytes += size;
+}
+
+void *alloc_track_malloc(alloc_site_e site, size_t size) {
+    alloc_count(site, size);
+    return malloc(size);
+}
+
+void *alloc_track_realloc(alloc_site_e site, void *ptr, size_t size) {
+    alloc_count(site, size);
+    return realloc(ptr, size);
+}
+
+void alloc_track_free(alloc_site_e site, void *ptr) {
+    assert(site < ALLOC_SITE_COUNT);
+    if (ptr != NULL) {
+        current_frame[site].frees++;
+        totals[site].frees++;
+    }
+    free(ptr);
+}
+
+void alloc_track_frame_end(void) {
+    size_t frame_allocs = 0;
+    for (size_t site = 0; site < ALLOC_SITE_COUNT; site++) {
+        last_frame[site] = current_frame[site];
+        current_frame[site] = (alloc_stats_t){0};
+        frame_allocs += last_frame[site].allocs;
+        if (last_frame[site].allocs > peak_allocs[site]) {
+            peak_allocs[site] = last_frame[site].allocs;
+        }
+    }
+    frames_ended++;
+    bool exempt = frame_exempt;
+    frame_exempt = false;
+    if (exempt) {
+        return;
+    }
+    if (frame_allocs > frame_budget) {
+        printf("Frame %zu made %zu allocations, over the budget of %zu:\n",
+               frames_ended, frame_allocs, frame_budget);
+        for (size_t site = 0; site < ALLOC_SITE_COUNT; site++) {
+            printf("  %-8s %zu\n", ALLOC_SITE_NAMES[site], last_frame[site].allocs);
+        }
+    }
+    assert(frame_allocs <= frame_budget);
+}
+
+void alloc_track_exempt_frame(void) {
+    frame_exempt = true;
+}
+
+void alloc_track_set_budget(size_t max_allocs) {
+    frame_budget = max_allocs;
+}
+
+alloc_stats_t alloc_track_frame(alloc_site_e site) {
+    assert(site < ALLOC_SITE_COUNT);
+    return last_frame[site];
+}
+
+alloc_stats_t alloc_track_total(alloc_site_e site) {
+    assert(site < ALLOC_SITE_COUNT);
+    return totals[site];
+}
+
+size_t alloc_track_frames(void) {
+    return frames_ended;
+}
+
+void alloc_track_reset(void) {
+    for (size_t site = 0; site < ALLOC_SITE_COUNT; site++) {
+        current_frame[site] = (alloc_stats_t){0};
+        last_frame[site] = (alloc_stats_t){0};
+        totals[site] = (alloc_stats_t){0};
+        peak_allocs[site] = 0;
+    }
+    frames_ended = 0;
+    frame_budget = SIZE_MAX;
+    frame_exempt = false;
+}
+
+const char *alloc_site_name(alloc_site_e site) {
+    assert(site < ALLOC_SITE_COUNT);
+    return ALLOC_SITE_NAMES[site];
+}
+
+void alloc_track_report(void) {
+    size_t frames = frames_ended > 0 ? frames_ended : 1;
+    printf("allocations over %zu frames:\n", frames_ended);
+    printf("  %-8s %10s %12s %10s %12s %10s\n",
+           "site", "allocs", "bytes", "frees", "allocs/frame", "peak");
+    for (size_t site = 0; site < ALLOC_SITE_COUNT; site++) {
+        alloc_stats_t total = totals[site];
+        printf("  %-8s %10zu %12zu %10zu %12.2f %10zu\n",
+               ALLOC_SITE_NAMES[site], total.allocs, total.bytes, total.frees,
+               (double)total.allocs / frames, peak_allocs[site]);
+    }
+}
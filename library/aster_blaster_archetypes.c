@@ -0,0 +1,331 @@
+#include "aster_blaster_imports.h"
+
+archetype_t archetype_get(const game_context_t *ctx, body_type_e type) {
+    archetype_t archetype = {
+        .shape = SHAPE_NGON,
+        .layer = LAYER_DEFAULT,
+        .elasticity = 1.0,
+    };
+    switch (type) {
+    case PLAYER:
+        archetype.shape = SHAPE_SECTOR;
+        archetype.radius = PLAYER_RADIUS;
+        archetype.points = PLAYER_SIDES;
+        archetype.sector_points = PLAYER_SECTOR_SIDES;
+        archetype.sector_angle = PLAYER_ANGLE;
+        archetype.mass = PLAYER_MASS;
+        archetype.health = HEALTH_TOTAL;
+        archetype.render = render_sprite(atlas_get(ctx->atlas, SPRITE_SHIP), PLAYER_RADIUS * 1.5, PLAYER_RADIUS * 1.2);
+        break;
+    case BULLET:
+        archetype.radius = BULLET_RADIUS;
+        archetype.points = 3;
+        archetype.mass = BULLET_MASS;
+        archetype.render = render_color(BULLET_COLOR);
+        archetype.pool_size = BULLET_POOL_SIZE;
+        archetype.cullable = true;
+        break;
+    case LASER:
+        archetype.shape = SHAPE_RECT;
+        archetype.radius = LASER_WIDTH;
+        archetype.inner_radius = LASER_LENGTH;
+        archetype.mass = LASER_MASS;
+        archetype.render = render_color(LASER_COLOR);
+        archetype.pool_size = LASER_POOL_SIZE;
+        archetype.cullable = true;
+        break;
+    case ASTEROID:
+        // spawn_asteroid_general() picks the size, shape and sprite of each
+        // asteroid. Pooled ones start with the most sides an asteroid has,
+        // so changing their shape never grows their vertex buffer.
+        archetype.radius = ASTEROID_RADIUS_MIN;
+        archetype.points = 10;
+        archetype.mass = ASTEROID_MIN_MASS;
+        archetype.render = render_sprite(ctx->ast_sprites_list.circle, 2 * ASTEROID_RADIUS_MIN, 2 * ASTEROID_RADIUS_MIN);
+        archetype.pool_size = ASTEROID_POOL_SIZE;
+        archetype.cullable = true;
+        break;
+    case ENEMY_SAW:
+        archetype.shape = SHAPE_STAR;
+        archetype.radius = ENEMY_SAW_OUT_RADIUS;
+        archetype.inner_radius = ENEMY_SAW_IN_RADIUS;
+        archetype.points = ENEMY_SAW_POINTS;
+        archetype.mass = ENEMY_SAW_MASS;
+        archetype.omega = ENEMY_SAW_OMEGA;
+        archetype.elasticity = ENEMY_SAW_ELASTICITY;
+        archetype.render = render_sprite(atlas_get(ctx->atlas, SPRITE_SAW_ALIEN), 2.0 * ENEMY_SAW_OUT_RADIUS, 2.0 * ENEMY_SAW_OUT_RADIUS);
+        archetype.pool_size = ENEMY_SAW_POOL_SIZE;
+        break;
+    case ENEMY_SHOOTER:
+        archetype.radius = ENEMY_SHOOTER_RADIUS;
+        archetype.points = ENEMY_SHOOTER_POINTS;
+        archetype.mass = ENEMY_SHOOTER_MASS;
+        archetype.render = render_sprite(atlas_get(ctx->atlas, SPRITE_SHOOTING_ALIEN), 2.0 * ENEMY_SHOOTER_RADIUS, 2.0 * ENEMY_SHOOTER_RADIUS);
+        archetype.pool_size = ENEMY_SHOOTER_POOL_SIZE;
+        break;
+    case ENEMY_SHOOTER_BULLET:
+        archetype.shape = SHAPE_STAR;
+        archetype.radius = ENEMY_SHOOTER_BULLET_OUT_RADIUS;
+        archetype.inner_radius = ENEMY_SHOOTER_BULLET_IN_RADIUS;
+        archetype.points = ENEMY_SHOOTER_BULLET_POINTS;
+        archetype.mass = ENEMY_SHOOTER_BULLET_MASS;
+        archetype.render = render_color(ENEMY_SHOOTER_BULLET_COLOR);
+        archetype.pool_size = ENEMY_SHOOTER_BULLET_POOL_SIZE;
+        archetype.cullable = true;
+        break;
+    case BLACK_HOLE:
+        archetype.radius = BLACK_HOLE_RADIUS;
+        archetype.points = BLACK_HOLE_POINTS;
+        archetype.mass = BLACK_HOLE_MASS;
+        archetype.omega = -2 * M_PI;
+        archetype.render = render_sprite(atlas_get(ctx->atlas, SPRITE_BLACK_HOLE), 2.0 * BLACK_HOLE_RADIUS, 2.0 * BLACK_HOLE_RADIUS);
+        archetype.pool_size = BLACK_HOLE_POOL_SIZE;
+        archetype.cullable = true;
+        break;
+    case BOSS:
+        archetype.shape = SHAPE_STAR;
+        archetype.radius = BOSS_OUT_RADIUS;
+        archetype.inner_radius = BOSS_IN_RADIUS;
+        archetype.points = BOSS_POINTS;
+        archetype.mass = BOSS_MASS;
+        archetype.omega = BOSS_OMEGA;
+        archetype.health = BOSS_HEALTH;
+        archetype.render = render_sprite(atlas_get(ctx->atlas, SPRITE_BOSS_ALIEN), 2 * BOSS_OUT_RADIUS, 2 * BOSS_OUT_RADIUS);
+        break;
+    case BOSS_BULLET:
+        archetype.shape = SHAPE_STAR;
+        archetype.radius = BOSS_BULLET_OUT_RADIUS;
+        archetype.inner_radius = BOSS_BULLET_IN_RADIUS;
+        archetype.points = BOSS_BULLET_POINTS;
+        archetype.mass = BOSS_BULLET_MASS;
+        archetype.render = render_color(BOSS_BULLET_COLOR);
+        archetype.pool_size = BOSS_BULLET_POOL_SIZE;
+        archetype.cullable = true;
+        break;
+    case BOSS_BOMB:
+        archetype.radius = BOSS_BOMB_RADIUS;
+        archetype.points = BOSS_BOMB_POINTS;
+        archetype.render = render_color(BOSS_BOMB_COLOR);
+        archetype.pool_size = BOSS_BOMB_POOL_SIZE;
+        break;
+    default:
+        abort();
+    }
+    return archetype;
+}
+
+/** Gets the cached shape of an archetype, or NULL for a rect, which isn't cached */
+const shape_template_t *archetype_shape(game_context_t *ctx, const archetype_t *archetype) {
+    switch (archetype->shape) {
+    case SHAPE_NGON:
+        return shape_cache_ngon(ctx->shapes, archetype->points);
+    case SHAPE_STAR:
+        return shape_cache_star(ctx->shapes, archetype->inner_radius / archetype->radius, archetype->points);
+    case SHAPE_RECT:
+        return NULL;
+    case SHAPE_SECTOR:
+        return shape_cache_sector(ctx->shapes, archetype->points, archetype->sector_points, archetype->sector_angle);
+    default:
+        abort();
+    }
+}
+
+body_t *archetype_body(game_context_t *ctx, const archetype_t *archetype, vector_t center) {
+    const shape_template_t *shape = archetype_shape(ctx, archetype);
+    if (shape == NULL) {
+        // rectangles aren't cached, so the body owns its vertices
+        vector_t origin = vec(center.x - archetype->radius / 2, center.y - archetype->inner_radius / 2);
+        list_t *rect = polygon_rect(origin, archetype->radius, archetype->inner_radius);
+        return body_init_texture(rect, archetype->mass, archetype->render);
+    }
+    return body_init_template(shape, center, archetype->radius, archetype->mass, archetype->render);
+}
+
+void archetype_aux_reset(aster_aux_t *aster_aux, body_type_e type, const archetype_t *archetype) {
+    aster_aux->body_type = type;
+    aster_aux->health = archetype->health;
+    aster_aux->health_bar = NULL;
+    aster_aux->game_over = false;
+    aster_aux->steering_offset = VEC_ZERO;
+}
+
+body_t *archetype_build(game_context_t *ctx, body_type_e type, const archetype_t *archetype, vector_t center) {
+    aster_aux_t *aster_aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(aster_aux_t));
+    archetype_aux_reset(aster_aux, type, archetype);
+
+    body_t *body = archetype_body(ctx, archetype, center);
+    body_set_info(body, aster_aux, free);
+    body_set_omega(body, archetype->omega);
+    body_set_layer(body, archetype->layer);
+    body_set_tag(body, type);
+    body_set_cullable(body, archetype->cullable);
+    return body;
+}
+
+body_t *spawn_archetype(game_context_t *ctx, body_type_e type, const archetype_t *archetype, vector_t center) {
+    body_t *body = archetype_build(ctx, type, archetype, center);
+    scene_add_body(ctx->scene, body);
+    return body;
+}
+
+body_t *spawn_entity(game_context_t *ctx, body_type_e type, vector_t center) {
+    archetype_t archetype = archetype_get(ctx, type);
+    body_pool_t *pool = ctx->pools[type];
+    body_t *body = pool != NULL ? body_pool_acquire(pool, center) : NULL;
+    if (body == NULL) {
+        return spawn_archetype(ctx, type, &archetype, center);
+    }
+    archetype_aux_reset(body_get_info(body), type, &archetype);
+    // lasers erode the mass of the bodies they hit
+    body_set_mass(body, archetype.mass);
+    body_set_omega(body, archetype.omega);
+    scene_add_body(ctx->scene, body);
+    return body;
+}
+
+void archetype_pools_init(game_context_t *ctx) {
+    for (body_type_e type = 0; type < BODY_TYPE_COUNT; type++) {
+        ctx->pools[type] = NULL;
+        archetype_t archetype = archetype_get(ctx, type);
+        // so that spawning the first body of a type doesn't build its shape
+        archetype_shape(ctx, &archetype);
+        if (archetype.pool_size == 0) {
+            continue;
+        }
+        body_pool_t *pool = body_pool_init(archetype.pool_size);
+        for (size_t i = 0; i < archetype.pool_size; i++) {
+            body_pool_add(pool, archetype_build(ctx, type, &archetype, VEC_ZERO));
+        }
+        ctx->pools[type] = pool;
+        scene_reserve_tag(ctx->scene, type, archetype.pool_size);
+    }
+    // spawn_asteroid_general() reshapes asteroids to any of these
+    for (size_t sides = ASTEROID_SIDES_MIN; sides <= ASTEROID_SIDES_MAX; sides++) {
+        shape_cache_ngon(ctx->shapes, sides);
+    }
+    ctx->armed_bombs = list_init(BOSS_BOMB_POOL_SIZE, NULL);
+}
+
+void archetype_pools_free(game_context_t *ctx) {
+    for (body_type_e type = 0; type < BODY_TYPE_COUNT; type++) {
+        if (ctx->pools[type] != NULL) {
+            body_pool_free(ctx->pools[type]);
+            ctx->pools[type] = NULL;
+        }
+    }
+    list_free(ctx->armed_bombs);
+    ctx->armed_bombs = NULL;
+}
+
+// What happens when two types of body meet
+typedef enum interaction {
+    // the first asteroid splits in two and the projectile is destroyed
+    FRAGMENT,
+    // the first asteroid loses mass to the laser
+    SHRINK,
+    // the first body damages the player
+    HURT,
+    // the first body damages the boss
+    HURT_BOSS,
+    // the bodies bounce, with the elasticity of the first archetype
+    BOUNCE,
+    DESTROY_BOTH,
+    DESTROY_FIRST,
+    // the first body is pulled towards the second
+    GRAVITY,
+    // the first body loses mass to the laser and is pushed back
+    ERODE
+} interaction_e;
+
+typedef struct interaction_rule {
+    body_type_e first;
+    body_type_e second;
+    interaction_e interaction;
+    game_phase_e phase;
+} interaction_rule_t;
+
+// Handlers of the same pair run in this order, so a body is hurt before it is destroyed
+const interaction_rule_t INTERACTION_RULES[] = {
+    {ASTEROID, BULLET, FRAGMENT, PHASE_ALWAYS},
+    {ASTEROID, ENEMY_SHOOTER_BULLET, FRAGMENT, PHASE_ALWAYS},
+    {ASTEROID, BOSS_BULLET, FRAGMENT, PHASE_ALWAYS},
+    {ASTEROID, LASER, SHRINK, PHASE_ALWAYS},
+    {ASTEROID, PLAYER, HURT, PHASE_ALWAYS},
+    {PLAYER, ASTEROID, BOUNCE, PHASE_ALWAYS},
+    {ASTEROID, ASTEROID, BOUNCE, PHASE_ALWAYS},
+
+    {ENEMY_SAW, PLAYER, BOUNCE, PHASE_ALWAYS},
+    {ENEMY_SAW, PLAYER, HURT, PHASE_ALWAYS},
+    {ENEMY_SAW, BULLET, DESTROY_BOTH, PHASE_ALWAYS},
+    {ENEMY_SHOOTER, BULLET, DESTROY_BOTH, PHASE_ALWAYS},
+    {ENEMY_SAW, LASER, ERODE, PHASE_ALWAYS},
+    {ENEMY_SHOOTER, LASER, ERODE, PHASE_ALWAYS},
+    {ENEMY_SHOOTER_BULLET, PLAYER, HURT, PHASE_ALWAYS},
+    {ENEMY_SHOOTER_BULLET, PLAYER, DESTROY_FIRST, PHASE_ALWAYS},
+    {BOSS_BULLET, PLAYER, HURT, PHASE_ALWAYS},
+    {BOSS_BULLET, PLAYER, DESTROY_FIRST, PHASE_ALWAYS},
+
+    {ASTEROID, BLACK_HOLE, GRAVITY, PHASE_ALWAYS},
+    {ENEMY_SAW, BLACK_HOLE, GRAVITY, PHASE_ALWAYS},
+    {ENEMY_SHOOTER, BLACK_HOLE, GRAVITY, PHASE_ALWAYS},
+    {ENEMY_SHOOTER_BULLET, BLACK_HOLE, GRAVITY, PHASE_ALWAYS},
+    {BOSS_BULLET, BLACK_HOLE, GRAVITY, PHASE_ALWAYS},
+    {BULLET, BLACK_HOLE, GRAVITY, PHASE_ALWAYS},
+    {LASER, BLACK_HOLE, GRAVITY, PHASE_ALWAYS},
+    {PLAYER, BLACK_HOLE, GRAVITY, PHASE_ALWAYS},
+    {ASTEROID, BLACK_HOLE, DESTROY_FIRST, PHASE_ALWAYS},
+    {ENEMY_SAW, BLACK_HOLE, DESTROY_FIRST, PHASE_ALWAYS},
+    {ENEMY_SHOOTER, BLACK_HOLE, DESTROY_FIRST, PHASE_ALWAYS},
+    {ENEMY_SHOOTER_BULLET, BLACK_HOLE, DESTROY_FIRST, PHASE_ALWAYS},
+    {BOSS_BULLET, BLACK_HOLE, DESTROY_FIRST, PHASE_ALWAYS},
+    {BULLET, BLACK_HOLE, DESTROY_FIRST, PHASE_ALWAYS},
+    {LASER, BLACK_HOLE, DESTROY_FIRST, PHASE_ALWAYS},
+    {BLACK_HOLE, PLAYER, HURT, PHASE_ALWAYS},
+
+    {BULLET, BOSS, HURT_BOSS, PHASE_BOSS_TANGIBLE},
+    {BULLET, BOSS, DESTROY_FIRST, PHASE_BOSS_TANGIBLE},
+    {LASER, BOSS, HURT_BOSS, PHASE_BOSS_TANGIBLE},
+    {LASER, BOSS, DESTROY_FIRST, PHASE_BOSS_TANGIBLE},
+};
+
+void wire_interaction(game_context_t *ctx, const interaction_rule_t *rule) {
+    scene_t *scene = ctx->scene;
+    switch (rule->interaction) {
+    case FRAGMENT:
+        create_pair_collision(scene, rule->first, rule->second, create_aster_fragments, ctx, NULL);
+        break;
+    case SHRINK:
+        create_pair_collision(scene, rule->first, rule->second, create_aster_smaller, ctx, NULL);
+        break;
+    case HURT:
+        create_pair_collision(scene, rule->first, rule->second, create_health_collision, NULL, NULL);
+        break;
+    case HURT_BOSS:
+        create_pair_collision(scene, rule->first, rule->second, create_boss_health_collision, NULL, NULL);
+        break;
+    case BOUNCE:
+        create_pair_physics_collision(scene, archetype_get(ctx, rule->first).elasticity, rule->first, rule->second);
+        break;
+    case DESTROY_BOTH:
+        create_pair_destructive_collision(scene, rule->first, rule->second);
+        break;
+    case DESTROY_FIRST:
+        create_pair_collision(scene, rule->first, rule->second, create_destructive_collision_force_single, NULL, NULL);
+        break;
+    case GRAVITY:
+        create_pair_newtonian_gravity(scene, G, rule->first, rule->second, true);
+        break;
+    case ERODE:
+        create_pair_collision(scene, rule->first, rule->second, create_mass_laser_collision_force, NULL, NULL);
+        break;
+    }
+}
+
+void wire_interactions(game_context_t *ctx, game_phase_e phase) {
+    size_t rule_count = sizeof(INTERACTION_RULES) / sizeof(INTERACTION_RULES[0]);
+    for (size_t i = 0; i < rule_count; i++) {
+        if (INTERACTION_RULES[i].phase == phase) {
+            wire_interaction(ctx, &INTERACTION_RULES[i]);
+        }
+    }
+}
@@ -1,241 +1,151 @@
 #include "aster_blaster_imports.h"
 #include "aster_blaster_collisions.h"
 
-body_t *body_init_enemy_saw(vector_t pos, scene_t *scene, body_t *player, SDL_Texture *texture) {
-    list_t *shape = polygon_star(pos, ENEMY_SAW_OUT_RADIUS, ENEMY_SAW_IN_RADIUS, ENEMY_SAW_POINTS);
-
-    aster_aux_t *aster_aux = malloc(sizeof(aster_aux_t));
-    aster_aux->body_type = ENEMY_SAW;
-
-    body_t *saw_enemy = body_init_texture_with_info(shape, ENEMY_SAW_MASS, render_texture(texture, 2.0 * ENEMY_SAW_OUT_RADIUS, 2.0 * ENEMY_SAW_OUT_RADIUS), aster_aux, free);
-
-    body_set_omega(saw_enemy, ENEMY_SAW_OMEGA);
-
-    create_attraction(scene, ENEMY_SAW_A, saw_enemy, player, true);
-    create_physics_collision(scene, ENEMY_SAW_ELASTICITY, saw_enemy, player);
-    create_collision(scene, saw_enemy, player, create_health_collision, NULL, NULL);
-
-    // TODO: similar code in spawn_asteroid, can factor out
-    for (size_t i = 0; i < scene_bodies(scene); i++) {
-        body_t *other_body = scene_get_body(scene, i);
-        aster_aux_t *other_aux = body_get_info(other_body);
-        if (other_aux != NULL) {
-            if (other_aux->body_type == BULLET) {
-                create_destructive_collision(scene, saw_enemy, other_body);
-            } else if (other_aux->body_type == BLACK_HOLE) {
-                create_newtonian_gravity(scene, G, saw_enemy, other_body, true);
-                create_destructive_collision_single(scene, saw_enemy, other_body);
-            }
-        }
-    }
-
-    return saw_enemy;
+// TODO: offsets so they don't stack
+void spawn_enemy_saw(game_context_t *ctx) {
+    spawn_entity(ctx, ENEMY_SAW, get_pos_radius_off_screen(game_rng(ctx, RNG_ENEMIES), ENEMY_SAW_OUT_RADIUS));
 }
 
-body_t *body_init_enemy_shooter(vector_t pos, scene_t *scene, body_t *player, SDL_Texture *texture) {
-    list_t *shape = polygon_reg_ngon(pos, ENEMY_SHOOTER_RADIUS, ENEMY_SHOOTER_POINTS);
-
-    aster_aux_t *aster_aux = malloc(sizeof(aster_aux_t));
-    aster_aux->body_type = ENEMY_SHOOTER;
-
-    body_t *shooter_enemy = body_init_texture_with_info(shape, ENEMY_SHOOTER_MASS, render_texture(texture, 2.0 * ENEMY_SHOOTER_RADIUS, 2.0 * ENEMY_SHOOTER_RADIUS), aster_aux, free);
-
-    create_attraction_mirrored(scene, ENEMY_SHOOTER_A, shooter_enemy, player, SDL_MAX, rand_vec(vec(-3 * ENEMY_SHOOTER_RADIUS, -3 * ENEMY_SHOOTER_RADIUS), vec(3 * ENEMY_SHOOTER_RADIUS, 3 * ENEMY_SHOOTER_RADIUS)));
-    create_pointing_force(scene, shooter_enemy, player);
+void spawn_enemy_shooter(game_context_t *ctx) {
+    rng_t *rng = game_rng(ctx, RNG_ENEMIES);
+    body_t *shooter_enemy = spawn_entity(ctx, ENEMY_SHOOTER, get_pos_radius_off_screen(rng, ENEMY_SHOOTER_RADIUS));
+    // so shooters don't stack on the same spot
+    aster_aux_t *aux = body_get_info(shooter_enemy);
+    aux->steering_offset = rng_vec(rng, vec(-3 * ENEMY_SHOOTER_RADIUS, -3 * ENEMY_SHOOTER_RADIUS), vec(3 * ENEMY_SHOOTER_RADIUS, 3 * ENEMY_SHOOTER_RADIUS));
+}
 
-    // TODO: similar code in spawn_asteroid, can factor out
-    for (size_t i = 0; i < scene_bodies(scene); i++) {
-        body_t *other_body = scene_get_body(scene, i);
-        aster_aux_t *other_aux = body_get_info(other_body);
-        if (other_aux != NULL) {
-            if (other_aux->body_type == BULLET) {
-                create_destructive_collision(scene, shooter_enemy, other_body);
-            } else if (other_aux->body_type == BLACK_HOLE) {
-                create_newtonian_gravity(scene, G, shooter_enemy, other_body, true);
-                create_destructive_collision_single(scene, shooter_enemy, other_body);
-            }
+void steer_saws(body_t **saws, size_t count, game_context_t *ctx) {
+    vector_t target = body_get_centroid(ctx->player);
+    for (size_t i = 0; i < count; i++) {
+        if (body_is_removed(saws[i])) {
+            continue;
         }
+        body_set_velocity(saws[i], attraction_velocity(ENEMY_SAW_A, body_get_centroid(saws[i]), target));
     }
-
-    return shooter_enemy;
 }
 
-// TODO: offsets so they don't stack
-void spawn_enemy_saw(scene_t *scene, body_t *player, SDL_Texture *texture) {
-    body_t *saw_enemy = body_init_enemy_saw(get_pos_radius_off_screen(ENEMY_SAW_OUT_RADIUS), scene, player, texture);
-    scene_add_body(scene, saw_enemy);
+void steer_shooters(body_t **shooters, size_t count, game_context_t *ctx) {
+    // shooters keep to the point across the screen from the player, and face them
+    vector_t player_pos = body_get_centroid(ctx->player);
+    vector_t anti_center = vec_subtract(SDL_MAX, player_pos);
+    for (size_t i = 0; i < count; i++) {
+        body_t *shooter = shooters[i];
+        if (body_is_removed(shooter)) {
+            continue;
+        }
+        aster_aux_t *aux = body_get_info(shooter);
+        vector_t pos = body_get_centroid(shooter);
+        vector_t target = vec_add(anti_center, aux->steering_offset);
+        body_set_velocity(shooter, attraction_velocity(ENEMY_SHOOTER_A, pos, target));
+        body_set_rotation(shooter, angle_to(pos, player_pos));
+    }
 }
 
-void spawn_enemy_shooter(scene_t *scene, body_t *player, SDL_Texture *texture) {
-    body_t *shooter_enemy = body_init_enemy_shooter(get_pos_radius_off_screen(ENEMY_SHOOTER_RADIUS), scene, player, texture);
-    scene_add_body(scene, shooter_enemy);
+void wire_enemy_steering(game_context_t *ctx) {
+    scene_add_tag_force_creator(ctx->scene, ENEMY_SAW, (tag_force_creator_t)steer_saws, ctx, NULL);
+    scene_add_tag_force_creator(ctx->scene, ENEMY_SHOOTER, (tag_force_creator_t)steer_shooters, ctx, NULL);
 }
 
-void shooter_enemy_all_shoot(scene_t *scene, body_t *player, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list) {
-    for (size_t i = 0; i < scene_bodies(scene); i++) {
-        body_t *body = scene_get_body(scene, i);
-        aster_aux_t *aux = body_get_info(body);
-        if (aux && aux->body_type == ENEMY_SHOOTER) {
-            spawn_enemy_shooter_bullet(scene, player, body, bounds, ast_sprites_list);
+void shooter_enemy_all_shoot(game_context_t *ctx) {
+    scene_t *scene = ctx->scene;
+    for (size_t i = 0; i < scene_tagged_bodies(scene, ENEMY_SHOOTER); i++) {
+        body_t *shooter = scene_get_tagged_body(scene, ENEMY_SHOOTER, i);
+        if (!body_is_removed(shooter)) {
+            spawn_enemy_shooter_bullet(ctx, shooter);
         }
     }
 }
 
-body_t *body_init_enemy_shooter_bullet(scene_t *scene, body_t *player, body_t *shooter, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list) {
+void spawn_enemy_shooter_bullet(game_context_t *ctx, body_t *shooter) {
     vector_t bullet_center = body_get_centroid(shooter); // calculate pos
     vector_t direction = vec_x(1);
-    direction = vec_rotate(direction, angle_to(bullet_center, body_get_centroid(player)));
+    direction = vec_rotate(direction, angle_to(bullet_center, body_get_centroid(ctx->player)));
     bullet_center = vec_add(bullet_center, vec_multiply(ENEMY_SHOOTER_RADIUS, direction));
 
-    list_t *shape = polygon_star(bullet_center, ENEMY_SHOOTER_BULLET_OUT_RADIUS, ENEMY_SHOOTER_BULLET_IN_RADIUS, ENEMY_SHOOTER_BULLET_POINTS);
-    aster_aux_t *aux = malloc(sizeof(aster_aux_t));
-    aux->body_type = ENEMY_SHOOTER_BULLET;
-    body_t *bullet = body_init_with_info(shape, ENEMY_SHOOTER_BULLET_MASS, ENEMY_SHOOTER_BULLET_COLOR, aux, free);
-
+    body_t *bullet = spawn_entity(ctx, ENEMY_SHOOTER_BULLET, bullet_center);
     body_set_velocity(bullet, vec_multiply(ENEMY_SHOOTER_BULLET_SPEED, direction));
-
-    create_collision(scene, bullet, player, create_health_collision, NULL, NULL);
-    create_destructive_collision_single(scene, bullet, player);
-
-    // TODO: partial code duplication from palyer bullet
-    for (size_t i = 0; i < scene_bodies(scene); i++) {
-        body_t *other_body = scene_get_body(scene, i);
-        aster_aux_t *other_aux = body_get_info(other_body);
-        if (other_aux != NULL) {
-            if (other_aux->body_type == ASTEROID) {
-                create_aster_bullet_collision(scene, other_body, bullet, bounds, ast_sprites_list);
-            } else if (other_aux->body_type == BLACK_HOLE) {
-                create_newtonian_gravity(scene, G, bullet, other_body, true);
-                create_destructive_collision_single(scene, bullet, other_body);
-            }
-        }
-    }
-
-    destroy_at_bounds(scene, bullet, bounds);
-
-    return bullet;
-}
-
-void spawn_enemy_shooter_bullet(scene_t *scene, body_t *player, body_t *shooter, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list) {
-    body_t *bullet = body_init_enemy_shooter_bullet(scene, player, shooter, bounds, ast_sprites_list);
-    scene_add_body(scene, bullet);
 }
 
-
-body_t *body_init_boss(scene_t *scene, body_t *movement_trigger, body_t *left_trigger, body_t *right_trigger, bool *tangible, SDL_Texture *texture) {
-    list_t *boss_shape =  polygon_star(BOSS_INIT_POS, BOSS_OUT_RADIUS, BOSS_IN_RADIUS, BOSS_POINTS);
-
-    aster_aux_t *aster_aux = malloc(sizeof(aster_aux_t));
-    aster_aux->body_type = BOSS;
-    aster_aux->health = BOSS_HEALTH;
-    aster_aux->game_over= false;
-
-    body_t *boss = body_init_texture_with_info(boss_shape, BOSS_MASS, render_texture(texture, 2 * BOSS_OUT_RADIUS, 2 * BOSS_OUT_RADIUS), aster_aux, free);
-
+body_t *spawn_boss(game_context_t *ctx) {
+    body_t *boss = spawn_entity(ctx, BOSS, BOSS_INIT_POS);
     body_set_velocity(boss, vec_y(-BOSS_SPEED));
-
-    body_set_omega(boss, BOSS_OMEGA);
-
-    init_boss_collisions(scene, boss, movement_trigger, left_trigger, right_trigger, tangible);
-
+    init_boss_collisions(ctx, boss);
+    ctx->boss = boss;
     return boss;
 }
 
-void spawn_boss(scene_t *scene, body_t *movement_trigger, body_t *left_trigger, body_t *right_trigger, bool *tangible, SDL_Texture *texture) {
-    body_t *boss = body_init_boss(scene, movement_trigger, left_trigger, right_trigger, tangible, texture);
-    scene_add_body(scene, boss);
-}
-
-void boss_bomb_explode(scene_t *scene, body_t *bomb, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list, list_t *bombs) {
+void boss_bomb_explode(game_context_t *ctx, body_t *bomb) {
     double angle = 2 * M_PI / BOSS_BULLETS_PER_BOMB;
     for (size_t i = 0; i < BOSS_BULLETS_PER_BOMB; i++) {
-        body_t *bullet = body_init_boss_bullet(scene, bomb, bounds, ast_sprites_list);
-        scene_add_body(scene, bullet);
+        body_t *bullet = spawn_entity(ctx, BOSS_BULLET, body_get_centroid(bomb));
         vector_t vel = vec(BOSS_BULLET_SPEED * cos(i * angle), BOSS_BULLET_SPEED * sin(i * angle));
         body_set_velocity(bullet, vel);
     }
     body_remove(bomb);
-    list_remove_item(bombs, bomb);
 }
 
-void boss_bomb_tick(scene_t *scene, body_t *bomb, double dt, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list, list_t *bombs) {
-    aster_aux_t *aux = body_get_info(bomb);
-    aux->timer -= dt;
-    if (aux->timer <= 0) {
-        boss_bomb_explode(scene, bomb, bounds, ast_sprites_list, bombs);
-    }
+// Every fuse is as long, so the bomb whose fuse runs out is the oldest one.
+// Bombs have no interactions, so they are still in the scene when this goes off.
+double boss_bomb_fuse(game_context_t *ctx) {
+    boss_bomb_explode(ctx, list_remove(ctx->armed_bombs, 0));
+    return TIMER_STOP;
 }
 
+void spawn_boss_bomb(game_context_t *ctx) {
+    body_t *bomb = spawn_entity(ctx, BOSS_BOMB, body_get_centroid(ctx->boss));
+    body_set_velocity(bomb, vec_y(rng_range(game_rng(ctx, RNG_ENEMIES), -1.1 * BOSS_BOMB_SPEED, -0.9 * BOSS_BOMB_SPEED)));
+    list_add(ctx->armed_bombs, bomb);
+    scene_schedule(ctx->scene, BOSS_BOMB_FUSE, (timer_callback_t)boss_bomb_fuse, ctx, NULL);
+}
 
-body_t *body_init_boss_bullet(scene_t *scene, body_t *bomb, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list) {
-    vector_t bullet_center = body_get_centroid(bomb);
-    list_t *shape = polygon_star(bullet_center, BOSS_BULLET_OUT_RADIUS, BOSS_BULLET_IN_RADIUS, BOSS_BULLET_POINTS);
-    aster_aux_t *aux = malloc(sizeof(aster_aux_t));
-    aux->body_type = BOSS_BULLET;
-    body_t *bullet = body_init_with_info(shape, BOSS_BULLET_MASS, BOSS_BULLET_COLOR, aux, free);
-
-    for (size_t i = 0; i < scene_bodies(scene); i++) {
-        body_t *other_body = scene_get_body(scene, i);
-        aster_aux_t *other_aux = body_get_info(other_body);
-        if (other_aux != NULL) {
-            if (other_aux->body_type == ASTEROID) {
-                create_aster_bullet_collision(scene, other_body, bullet, bounds, ast_sprites_list);
-            } else if (other_aux->body_type == BLACK_HOLE) {
-                create_newtonian_gravity(scene, G, bullet, other_body, true);
-                create_destructive_collision_single(scene, bullet, other_body);
-            } else if (other_aux->body_type == PLAYER) {
-                create_collision(scene, bullet, other_body, create_health_collision, NULL, NULL);
-                create_destructive_collision_single(scene, bullet, other_body);
-            }
-        }
+double saw_wave(game_context_t *ctx) {
+    size_t to_spawn = rng_int_range(game_rng(ctx, RNG_WAVES), ENEMY_SAW_SWARM_SIZE_MIN, ENEMY_SAW_SWARM_SIZE_MAX);
+    for (size_t i = 0; i < to_spawn; i++) {
+        spawn_enemy_saw(ctx);
     }
-
-    destroy_at_bounds(scene, bullet, bounds);
-
-    return bullet;
+    return rate_variant(game_rng(ctx, RNG_WAVES), ENEMY_SAW_SPAWN_RATE);
 }
 
-body_t *body_init_boss_bomb(scene_t *scene, body_t *boss, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list) {
-    vector_t bomb_center = body_get_centroid(boss);
-    list_t *shape = polygon_reg_ngon(bomb_center, BOSS_BOMB_RADIUS, BOSS_BOMB_POINTS);
-    aster_aux_t *aux = malloc(sizeof(aster_aux_t));
-    aux->body_type = BOSS_BOMB;
-    aux->timer = BOSS_BOMB_FUSE;
-    body_t *bomb = body_init_with_info(shape, 0, BOSS_BOMB_COLOR, aux, free);
-    body_set_velocity(bomb, vec_y(drand_range(-1.1 * BOSS_BOMB_SPEED, -0.9 * BOSS_BOMB_SPEED)));
+double shooter_wave(game_context_t *ctx) {
+    spawn_enemy_shooter(ctx);
+    return rate_variant(game_rng(ctx, RNG_WAVES), ENEMY_SHOOTER_SPAWN_RATE);
+}
 
-    // create_boss_bomb_tick_force(scene, bomb, bounds, ast_sprites_list);
+double shooter_volley(game_context_t *ctx) {
+    shooter_enemy_all_shoot(ctx);
+    return rate_variant(game_rng(ctx, RNG_WAVES), ENEMY_SHOOTER_SHOT_RATE);
+}
 
-    destroy_at_bounds(scene, bomb, bounds);
+double boss_arrival(game_context_t *ctx) {
+    // there is one boss a game, so it isn't pooled
+    ALLOC_FRAME_EXEMPT();
+    spawn_boss(ctx);
+    return TIMER_STOP;
+}
 
-    return bomb;
+double boss_bomb_drop(game_context_t *ctx) {
+    spawn_boss_bomb(ctx);
+    return BOSS_SHOT_RATE;
 }
 
-void spawn_boss_bomb(scene_t *scene, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list, list_t *bombs) {
-    body_t *boss = NULL;
-    for (size_t i = 0; i < scene_bodies(scene); i++) {
-        body_t *body = scene_get_body(scene, i);
-        aster_aux_t *body_aux = body_get_info(body);
-        if (body_aux != NULL) {
-            if (body_aux->body_type == BOSS) {
-                boss = body;
-                break;
-            }
-        }
-    }
-    body_t *bomb = body_init_boss_bomb(scene, boss, bounds, ast_sprites_list);
-    list_add(bombs, bomb);
-    scene_add_body(scene, bomb);
+void schedule_enemy_waves(game_context_t *ctx) {
+    scene_t *scene = ctx->scene;
+    scene_schedule(scene, rate_variant(game_rng(ctx, RNG_WAVES), ENEMY_SAW_SPAWN_RATE), (timer_callback_t)saw_wave, ctx, NULL);
+    scene_schedule(scene, rate_variant(game_rng(ctx, RNG_WAVES), ENEMY_SHOOTER_SPAWN_RATE), (timer_callback_t)shooter_wave, ctx, NULL);
+    scene_schedule(scene, rate_variant(game_rng(ctx, RNG_WAVES), ENEMY_SHOOTER_SHOT_RATE), (timer_callback_t)shooter_volley, ctx, NULL);
+    scene_schedule(scene, BOSS_SPAWN_TIME, (timer_callback_t)boss_arrival, ctx, NULL);
 }
 
 body_t *body_boss_health_bar_background_init() {
     list_t *shape = polygon_rect(BOSS_HEALTH_BAR_BACKGROUND_POS, BOSS_HEALTH_BAR_BACKGROUND_W, BOSS_HEALTH_BAR_BACKGROUND_H);
     body_t *health_bar_background = body_init(shape, 0, BOSS_HEALTH_BAR_BACKGROUND_COLOR);
+    body_set_layer(health_bar_background, LAYER_HUD_BACKGROUND);
     return health_bar_background;
 }
 
 body_t *body_boss_health_bar_init() {
     list_t *shape = polygon_rect(BOSS_HEALTH_BAR_POS, BOSS_HEALTH_BAR_W, BOSS_HEALTH_BAR_H);
     body_t *health_bar_background = body_init(shape, 0, BOSS_HEALTH_BAR_COLOR);
+    body_set_layer(health_bar_background, LAYER_HUD);
     return health_bar_background;
 }
@@ -1,105 +1,102 @@
 #include "aster_blaster_imports.h"
 
-void spawn_asteroid_top(scene_t *scene, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list) {
+double asteroid_radius(double mass) {
+    return (mass - ASTEROID_MIN_MASS) / (ASTEROID_MAX_MASS - ASTEROID_MIN_MASS) * (ASTEROID_RADIUS_MAX - ASTEROID_RADIUS_MIN) + ASTEROID_RADIUS_MIN;
+}
+
+void resize_asteroid(body_t *asteroid, double mass) {
+    double radius = asteroid_radius(mass);
+    // every vertex of an asteroid is on its circle, so that is its bounding radius
+    body_scale(asteroid, radius / body_get_bounding_radius(asteroid));
+    body_set_mass(asteroid, mass);
+
+    render_data_texture_t texture = body_get_render_data(asteroid).data.texture;
+    sprite_t sprite = {.tex = texture.tex, .uv = texture.uv, .atlas_index = texture.atlas_index};
+    body_set_render_data(asteroid, render_sprite(sprite, radius * 2, radius * 2));
+}
+
+void spawn_asteroid_top(game_context_t *ctx) {
+    rng_t *rng = game_rng(ctx, RNG_ENVIRONMENT);
     // TODO: random later
     // TODO: magic number
     // TODO: split into spawn() and body_init() like everything else
     // TODO: image rendering should be factored out to sdl_wrapper
-    double mass = drand_range(ASTEROID_MIN_MASS, ASTEROID_MAX_MASS);
-    double ast_radius = (mass - ASTEROID_MIN_MASS) / (ASTEROID_MAX_MASS - ASTEROID_MIN_MASS) * (ASTEROID_RADIUS_MAX - ASTEROID_RADIUS_MIN) + ASTEROID_RADIUS_MIN;
-    double ast_x = drand_range(SDL_MIN.x, SDL_MAX.x);
+    double mass = rng_range(rng, ASTEROID_MIN_MASS, ASTEROID_MAX_MASS);
+    double ast_radius = asteroid_radius(mass);
+    double ast_x = rng_range(rng, SDL_MIN.x, SDL_MAX.x);
     vector_t ast_center = vec(ast_x, SDL_MAX.y + ast_radius);
 
     double theta = 0;
     double midpoint = (SDL_MAX.x - SDL_MIN.x) / 2;
     if (ast_x < midpoint) {
-        theta = drand_range(3 * M_PI / 2, 2 * M_PI);
+        theta = rng_range(rng, 3 * M_PI / 2, 2 * M_PI);
     } else {
-        theta = drand_range(M_PI, 3 * M_PI / 2);
+        theta = rng_range(rng, M_PI, 3 * M_PI / 2);
     }
     vector_t ast_velocity = vec(ASTEROID_SPEED * cos(theta), ASTEROID_SPEED * sin(theta));
 
-    spawn_asteroid_general(scene, mass, ast_center, ast_velocity, bounds, ast_sprites_list);
+    spawn_asteroid_general(ctx, mass, ast_center, ast_velocity);
 }
 
-body_t *spawn_asteroid_general(scene_t *scene, double mass, vector_t ast_center, vector_t ast_velocity, game_bounds_t bounds, ast_sprites_list_t ast_sprites_list) {
+body_t *spawn_asteroid_general(game_context_t *ctx, double mass, vector_t ast_center, vector_t ast_velocity) {
+    rng_t *rng = game_rng(ctx, RNG_ENVIRONMENT);
+    ast_sprites_list_t ast_sprites_list = ctx->ast_sprites_list;
     size_t num_sides;
-    SDL_Texture *tex;
+    sprite_t sprite;
 
-    switch (irand_range(0, 3)) {
+    switch (rng_int_range(rng, 0, 3)) {
     case 0:
         num_sides = 5;
-        tex = ast_sprites_list.pentagon;
+        sprite = ast_sprites_list.pentagon;
         break;
     case 1:
         num_sides = 6;
-        tex = ast_sprites_list.hexagon;
+        sprite = ast_sprites_list.hexagon;
     case 2:
         num_sides = 7;
-        tex = ast_sprites_list.heptagon;
+        sprite = ast_sprites_list.heptagon;
         break;
     case 3:
         num_sides = 10;
-        tex = ast_sprites_list.circle;
+        sprite = ast_sprites_list.circle;
         break;
     default:
         abort();
     }
-    assert(tex != NULL);
-
-    double ast_radius = (mass - ASTEROID_MIN_MASS) / (ASTEROID_MAX_MASS - ASTEROID_MIN_MASS) * (ASTEROID_RADIUS_MAX - ASTEROID_RADIUS_MIN) + ASTEROID_RADIUS_MIN;
 
-    double ast_omega = drand_range(-2.0 * M_PI, 2.0 * M_PI);
+    double ast_radius = asteroid_radius(mass);
 
-    aster_aux_t *asteroid_aux = malloc(sizeof(aster_aux_t));
-    asteroid_aux->body_type = ASTEROID;
-
-    render_info_t texture = render_texture(tex, ast_radius * 2, ast_radius * 2);
-
-    list_t *aster_shape = polygon_reg_ngon(ast_center, ast_radius, num_sides);
-    body_t *asteroid = body_init_texture_with_info(aster_shape, mass, texture, asteroid_aux, free);
+    // the pooled body is reshaped to this asteroid's sides and size
+    body_t *asteroid = spawn_entity(ctx, ASTEROID, ast_center);
+    body_set_template(asteroid, shape_cache_ngon(ctx->shapes, num_sides));
+    body_scale(asteroid, ast_radius / body_get_scale(asteroid));
+    body_set_mass(asteroid, mass);
+    body_set_omega(asteroid, rng_range(rng, -2.0 * M_PI, 2.0 * M_PI));
+    body_set_render_data(asteroid, render_sprite(sprite, ast_radius * 2, ast_radius * 2));
     body_set_velocity(asteroid, ast_velocity);
-    body_set_omega(asteroid, ast_omega);
-
-    for (size_t i = 0; i < scene_bodies(scene); i++) {
-        body_t *other_body = scene_get_body(scene, i);
-        aster_aux_t *other_aux = body_get_info(other_body);
-        if (other_aux != NULL) {
-            if (other_aux->body_type == BULLET) {
-                create_aster_bullet_collision(scene, asteroid, other_body, bounds, ast_sprites_list);
-            } else if (other_aux->body_type == PLAYER) { // TODO: is this different from health collision?
-                create_aster_player_collision(scene, asteroid, other_body);
-            } else if (other_aux->body_type == BLACK_HOLE) {
-                create_newtonian_gravity(scene, G, asteroid, other_body, true);
-                create_destructive_collision_single(scene, asteroid, other_body);
-            } else if (other_aux->body_type == ASTEROID) {
-                create_physics_collision(scene, 1.0, asteroid, other_body);
-            }
-        }
-    }
-
-    destroy_at_bounds(scene, asteroid, bounds);
-    scene_add_body(scene, asteroid);
     return asteroid;
 }
 
 /**
-  * Creates all of the background stars and adds them to the scene. It is
-  * important that this is called before any other bodies are added to the
-  * scene so the stars go in the background.
+  * Creates all of the background stars and adds them to the scene. They are
+  * drawn in the background layer, and scroll down the screen forever by
+  * wrapping around STAR_WRAP_MIN and STAR_WRAP_MAX.
   */
-void create_background_stars(scene_t *scene, body_t *bound) {
+void create_background_stars(game_context_t *ctx) {
+    scene_t *scene = ctx->scene;
+    rng_t *rng = game_rng(ctx, RNG_ENVIRONMENT);
+    scene_set_wrap_box(scene, STAR_WRAP_MIN, STAR_WRAP_MAX);
     for (int i = 0; i < NUM_STARS; i++) {
-        double r = drand_range(STAR_RADIUS_MIN, STAR_RADIUS_MAX);
-        size_t degree = (size_t)irand_range(STAR_POINTS_MIN, STAR_POINTS_MAX);
-        vector_t center = rand_vec(SDL_MIN, SDL_MAX);
-        list_t *shape = polygon_reg_ngon(center, r, degree);
+        double r = rng_range(rng, STAR_RADIUS_MIN, STAR_RADIUS_MAX);
+        size_t degree = (size_t)rng_int_range(rng, STAR_POINTS_MIN, STAR_POINTS_MAX);
+        vector_t center = rng_vec(rng, SDL_MIN, SDL_MAX);
         // list_t *shape = polygon_star(center, r, r / 2, degree);
-        body_t *star = body_init(shape, 0, STAR_COLOR);
+        body_t *star = body_init_template(shape_cache_ngon(ctx->shapes, degree), center, r, 0, render_color(STAR_COLOR));
+        body_set_layer(star, LAYER_BACKGROUND);
 
         // Gives the star one of three velocities to create the illusion of
         // parallax.
-        int which_velocity = irand_range(1, 3);
+        int which_velocity = rng_int_range(rng, 1, 3);
         switch (which_velocity) {
         case 1:
             body_set_velocity(star, STAR_VELOCITY_1);
@@ -111,17 +108,17 @@ void create_background_stars(scene_t *scene, body_t *bound) {
             body_set_velocity(star, STAR_VELOCITY_3);
             break;
         }
-        create_star_collision(scene, star, bound);
+        body_set_wrapping(star, true);
 
         scene_add_body(scene, star);
     }
 }
 
-body_t *body_init_black_hole(vector_t pos, scene_t *scene, game_bounds_t bounds, SDL_Texture *texture) {
-    list_t *shape = polygon_reg_ngon(pos, BLACK_HOLE_RADIUS, BLACK_HOLE_POINTS);
-    aster_aux_t *aster_aux = malloc(sizeof(aster_aux_t));
-    aster_aux->body_type = BLACK_HOLE;
-    body_t *black_hole = body_init_texture_with_info(shape, BLACK_HOLE_MASS, render_texture(texture, 2.0 * BLACK_HOLE_RADIUS, 2.0 * BLACK_HOLE_RADIUS), aster_aux, free);
+void spawn_black_hole(game_context_t *ctx) {
+    rng_t *rng = game_rng(ctx, RNG_ENVIRONMENT);
+    double bh_x = rng_range(rng, SDL_MIN.x, SDL_MAX.x);
+    vector_t bh_center = vec(bh_x, SDL_MAX.y + BLACK_HOLE_RADIUS);
+    body_t *black_hole = spawn_entity(ctx, BLACK_HOLE, bh_center);
 
     //if the black hole spawns at the left of the screen, x velocity should be
     //positive, so theta between 3*pi/2 and 2*pi
@@ -129,40 +126,41 @@ body_t *body_init_black_hole(vector_t pos, scene_t *scene, game_bounds_t bounds,
     double theta = 0;
     double midpoint = (SDL_MAX.x - SDL_MIN.x) / 2;
     if (body_get_centroid(black_hole).x < midpoint) {
-        theta = drand_range(3 * M_PI / 2, 2 * M_PI);
+        theta = rng_range(rng, 3 * M_PI / 2, 2 * M_PI);
     } else {
-        theta = drand_range(M_PI, 3 * M_PI / 2);
+        theta = rng_range(rng, M_PI, 3 * M_PI / 2);
     }
     vector_t bh_velocity = vec(BLACK_HOLE_SPEED * cos(theta), BLACK_HOLE_SPEED * sin(theta));
     body_set_velocity(black_hole, bh_velocity);
-    body_set_omega(black_hole, - 2 * M_PI);
-
-    for (size_t i = 0; i < scene_bodies(scene); i++) {
-        body_t *other_body = scene_get_body(scene, i);
-        aster_aux_t *other_aux = body_get_info(other_body);
-        if (other_aux != NULL) {
-            if (other_aux->body_type == BULLET || other_aux->body_type == ENEMY_SHOOTER_BULLET) {
-                create_newtonian_gravity(scene, G, other_body, black_hole, true);
-                create_destructive_collision_single(scene, other_body, black_hole);
-            } else if (other_aux->body_type != BLACK_HOLE && other_aux->body_type != PLAYER
-                       && other_aux->body_type != BOSS) {
-                create_newtonian_gravity(scene, G, other_body, black_hole, true);
-                create_destructive_collision_single(scene, other_body, black_hole);
-            } else if (other_aux->body_type == PLAYER) {
-                create_newtonian_gravity(scene, G, other_body, black_hole, true);
-                create_collision(scene, black_hole, other_body, create_health_collision, NULL, NULL);
-            }
-        }
-    }
+}
 
-    destroy_at_bounds(scene, black_hole, bounds);
+double asteroid_wave(game_context_t *ctx) {
+    double spawn_chance = rng_double(game_rng(ctx, RNG_WAVES));
+    // If boss is present the chance of spawning is halved and the next
+    // chance doesn't come any sooner when an asteroid doesn't spawn
+    if (ctx->boss_tangible) {
+        spawn_chance *= 2;
+    }
+    if (spawn_chance < ASTEROID_SPAWN_CHANCE) {
+        spawn_asteroid_top(ctx);
+        return ASTEROID_SPAWN_RATE;
+    }
+    return ctx->boss_tangible ? ASTEROID_SPAWN_RATE : ASTEROID_SPAWN_RATE / 2;
+}
 
-    return black_hole;
+double black_hole_wave(game_context_t *ctx) {
+    // Black holes don't spawn when the boss is present.
+    if (ctx->boss_tangible) {
+        return BLACK_HOLE_SPAWN_RATE;
+    }
+    if (rng_double(game_rng(ctx, RNG_WAVES)) < BLACK_HOLE_SPAWN_CHANCE) {
+        spawn_black_hole(ctx);
+        return BLACK_HOLE_SPAWN_RATE;
+    }
+    return BLACK_HOLE_SPAWN_RATE / 2;
 }
 
-void spawn_black_hole(scene_t *scene, game_bounds_t bounds, SDL_Texture *texture) {
-    double bh_x = drand_range(SDL_MIN.x, SDL_MAX.x);
-    vector_t bh_center = vec(bh_x, SDL_MAX.y + BLACK_HOLE_RADIUS);
-    body_t *black_hole = body_init_black_hole(bh_center, scene, bounds, texture);
-    scene_add_body(scene, black_hole);
+void schedule_environment_waves(game_context_t *ctx) {
+    scene_schedule(ctx->scene, ASTEROID_SPAWN_RATE, (timer_callback_t)asteroid_wave, ctx, NULL);
+    scene_schedule(ctx->scene, BLACK_HOLE_SPAWN_RATE, (timer_callback_t)black_hole_wave, ctx, NULL);
 }
@@ -3,6 +3,29 @@
 // SDL settings
 const vector_t SDL_MIN = ((vector_t){.x = 0, .y = 0});
 const vector_t SDL_MAX = ((vector_t){.x = 1200, .y = 800});
+// Most frames per second the game runs at in a window, or 0 for no limit
+const double TARGET_FRAME_RATE = 120;
+// Frames run by `--headless` when no frame count is given
+const size_t HEADLESS_DEFAULT_FRAMES = 3600;
+// Seed of `--headless` runs when no `--seed` is given, so they can be compared
+const uint64_t HEADLESS_DEFAULT_SEED = 0;
+// Where builds with the profiler write its frame times and trace on exit,
+// and the collision counters of each pair of body types
+const char *const PROFILE_CSV_PATH = "profile.csv";
+const char *const PROFILE_TRACE_PATH = "profile_trace.json";
+const char *const PROFILE_PAIRS_CSV_PATH = "profile_pairs.csv";
+// Builds that track allocations (`make ALLOC_TRACK=1`) fail an assertion
+// when a game frame after the warm-up makes more than ALLOC_FRAME_BUDGET
+// allocations, unless the frame is exempt (see ALLOC_FRAME_EXEMPT()).
+// Every spawn after the warm-up comes from a pool, so the budget is none.
+const size_t ALLOC_BUDGET_WARM_UP_FRAMES = 120;
+const size_t ALLOC_FRAME_BUDGET = 0;
+// Frames between checks of whether to save a busier `--snapshot`
+const size_t SNAPSHOT_CHECK_FRAMES = 60;
+// Room made up front for the game's bodies and its contacts per tick,
+// see scene_reserve()
+const size_t GAME_BODY_CAPACITY = 1024;
+const size_t GAME_CONTACT_CAPACITY = 512;
 /**
  * Font designed by JoannaVu
  * Licensed for non-commercial use
@@ -58,11 +81,15 @@ const double BULLET_RADIUS = 12;
 const double BULLET_SIDES = 30;
 const rgb_color_t BULLET_COLOR = ((rgb_color_t){1, 1, 0});
 const double BULLET_COOLDOWN = 0.2;
+const size_t BULLET_POOL_SIZE = 16;
 
 const double LASER_MASS = 5;
+const double LASER_WIDTH = 2;
+const double LASER_LENGTH = 100;
 const vector_t LASER_VELOCITY = ((vector_t){.x = 0, .y = 3000});
 const rgb_color_t LASER_COLOR = ((rgb_color_t){1, 0, 0});
 const double LASER_COOLDOWN = 0.075;
+const size_t LASER_POOL_SIZE = 16;
 const vector_t LASER_TRANSLATE = ((vector_t){.x = 0, .y = 2});
 
 const double MIN_MASS = 20;
@@ -70,11 +97,16 @@ const double MIN_MASS = 20;
 // Asteroid settings
 const double ASTEROID_MIN_MASS = 20;
 const double ASTEROID_MAX_MASS = 300;
-const double ASTEROID_SIDES_MIN = 5;
-const double ASTEROID_SIDES_MAX = 10;
+const size_t ASTEROID_SIDES_MIN = 5;
+const size_t ASTEROID_SIDES_MAX = 10;
 const double ASTEROID_SPEED = 200;
 const double ASTEROID_RADIUS_MIN = 30.0;
 const double ASTEROID_RADIUS_MAX = 80.0;
+const size_t ASTEROID_POOL_SIZE = 32;
+
+// Cullable bodies are removed once they are entirely outside this box
+#define KILL_BOX_MIN ((vector_t){.x = SDL_MIN.x - ASTEROID_RADIUS_MAX, .y = SDL_MIN.y - ASTEROID_RADIUS_MAX})
+#define KILL_BOX_MAX ((vector_t){.x = SDL_MAX.x + ASTEROID_RADIUS_MAX, .y = SDL_MAX.y + ASTEROID_RADIUS_MAX})
 const rgb_color_t ASTEROID_COLOR = (rgb_color_t){0.7, 0.7, 0.7};
 const double ASTEROID_SPAWN_CHANCE = 0.33;
 const double ASTEROID_SPAWN_RATE = 0.5;
@@ -89,6 +121,10 @@ const double STAR_POINTS_MAX = 4;
 #define STAR_VELOCITY_2 ((vector_t){.x = 0, .y = -0.2 * SDL_MAX.y})
 #define STAR_VELOCITY_3 ((vector_t){.x = 0, .y = -0.4 * SDL_MAX.y})
 const rgb_color_t STAR_COLOR = ((rgb_color_t){1.0, 1.0, 1.0});
+// Stars that scroll out of this box come back on the other side,
+// far enough out that they are never seen jumping
+#define STAR_WRAP_MIN ((vector_t){.x = SDL_MIN.x - 2 * STAR_RADIUS_MAX, .y = SDL_MIN.y - 2 * STAR_RADIUS_MAX})
+#define STAR_WRAP_MAX ((vector_t){.x = SDL_MAX.x + 2 * STAR_RADIUS_MAX, .y = SDL_MAX.y + 2 * STAR_RADIUS_MAX})
 
 // Health bar settings
 #define HEALTH_BAR_BACKGROUND_POS ((vector_t){.x = 0.0125 * SDL_MAX.y, .y = 0.0125 * SDL_MAX.y})
@@ -117,6 +153,8 @@ const double ENEMY_SAW_A = 1;
 const double ENEMY_SAW_SPAWN_RATE = 7;
 const size_t ENEMY_SAW_SWARM_SIZE_MIN = 2;
 const size_t ENEMY_SAW_SWARM_SIZE_MAX = 5;
+// Saws chase the player until they are shot, so they pile up over a game
+const size_t ENEMY_SAW_POOL_SIZE = 128;
 
 // Shooter enemy settings
 const double ENEMY_SHOOTER_RADIUS = 40;
@@ -127,6 +165,7 @@ const double ENEMY_SHOOTER_MASS = 150;
 const rgb_color_t ENEMY_SHOOTER_COLOR = (rgb_color_t){0.8, 0.8, 0.3};
 const double ENEMY_SHOOTER_A = 0.65;
 const double ENEMY_SHOOTER_SPAWN_RATE = 7;
+const size_t ENEMY_SHOOTER_POOL_SIZE = 32;
 
 // Shooter enemy bullet settings
 const double ENEMY_SHOOTER_SHOT_RATE = 1;
@@ -136,6 +175,7 @@ const size_t ENEMY_SHOOTER_BULLET_POINTS = 4;
 const double ENEMY_SHOOTER_BULLET_MASS = 200;
 const rgb_color_t ENEMY_SHOOTER_BULLET_COLOR = (rgb_color_t){0.8, 0.8, 0.3};
 const double ENEMY_SHOOTER_BULLET_SPEED = 300;
+const size_t ENEMY_SHOOTER_BULLET_POOL_SIZE = 64;
 
 // Boss settings
 const double BOSS_OUT_RADIUS = 100;
@@ -157,6 +197,8 @@ const double BOSS_BOMB_SPEED = 130;
 const size_t BOSS_BOMB_POINTS = 30;
 // const rgb_color_t BOSS_BOMB_COLOR = (rgb_color_t){0.376, 0.376, 0.376};
 const rgb_color_t BOSS_BOMB_COLOR = (rgb_color_t){0.2, 0, 0};
+// Fuses are longer than the time between bombs, so a few are out at once
+const size_t BOSS_BOMB_POOL_SIZE = 4;
 const size_t BOSS_BULLETS_PER_BOMB = 8;
 const double BOSS_BULLET_OUT_RADIUS = 10;
 const double BOSS_BULLET_IN_RADIUS = 5;
@@ -164,6 +206,7 @@ const size_t BOSS_BULLET_POINTS = 4;
 const double BOSS_BULLET_MASS = 400;
 const rgb_color_t BOSS_BULLET_COLOR = (rgb_color_t){1, 0, 0};
 const double BOSS_BULLET_SPEED = 300;
+const size_t BOSS_BULLET_POOL_SIZE = 64;
 
 // Boss Health bar settings
 #define BOSS_HEALTH_BAR_BACKGROUND_POS ((vector_t){.x = 0.0125 * SDL_MAX.y, .y = 0.925 * SDL_MAX.y})
@@ -184,6 +227,7 @@ const double BLACK_HOLE_SPEED = 100;
 const rgb_color_t BLACK_HOLE_COLOR = (rgb_color_t){0.2, 0.2, 0.2};
 const double BLACK_HOLE_SPAWN_CHANCE = 0.5;
 const double BLACK_HOLE_SPAWN_RATE = 15;
+const size_t BLACK_HOLE_POOL_SIZE = 4;
 
 const double RATE_VARIANT_LOWER = 0.8;
 const double RATE_VARIANT_UPPER = 1.2;
@@ -0,0 +1,119 @@
+#include "aster_blaster_imports.h"
+
+// Bodies are referred to by their index in the snapshot, or this if none
+const int64_t SNAPSHOT_NO_BODY = -1;
+
+// A body's aster_aux_t, if it has one: whether it has one, its body_type,
+// health, health_bar, game_over and steering_offset
+const size_t ASTER_AUX_RECORD_SIZE = 4 + 4 + 8 + 8 + 4 + 16;
+
+// Which bodies the game_context_t points to: the player, the boss,
+// boss_tangible, the four bounds and the three boss triggers
+const size_t GAME_RECORD_SIZE = 8 + 8 + 4 + 4 * 8 + 3 * 8;
+
+int64_t snapshot_index_of(scene_t *scene, const body_t *body) {
+    for (size_t i = 0; body != NULL && i < scene_bodies(scene); i++) {
+        if (scene_get_body(scene, i) == body) {
+            return i;
+        }
+    }
+    return SNAPSHOT_NO_BODY;
+}
+
+body_t *snapshot_body_at(body_t *const *bodies, int64_t index) {
+    return index != SNAPSHOT_NO_BODY ? bodies[index] : NULL;
+}
+
+void save_aster_aux(scene_t *scene, size_t index, uint8_t *out, game_context_t *ctx) {
+    aster_aux_t *aster_aux = body_get_info(scene_get_body(scene, index));
+    if (aster_aux == NULL) {
+        // the record was zeroed, so has_aux is false
+        return;
+    }
+    snapshot_put_u32(&out, true);
+    snapshot_put_u32(&out, aster_aux->body_type);
+    snapshot_put_f64(&out, aster_aux->health);
+    snapshot_put_u64(&out, snapshot_index_of(scene, aster_aux->health_bar));
+    snapshot_put_u32(&out, aster_aux->game_over);
+    snapshot_put_vec(&out, aster_aux->steering_offset);
+}
+
+void load_aster_aux(body_t *body, const uint8_t *in, body_t *const *bodies, game_context_t *ctx) {
+    if (!snapshot_get_u32(&in)) {
+        return;
+    }
+    aster_aux_t *aster_aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(aster_aux_t));
+    aster_aux->body_type = snapshot_get_u32(&in);
+    aster_aux->health = snapshot_get_f64(&in);
+    aster_aux->health_bar = snapshot_body_at(bodies, snapshot_get_u64(&in));
+    aster_aux->game_over = snapshot_get_u32(&in);
+    aster_aux->steering_offset = snapshot_get_vec(&in);
+    body_set_info(body, aster_aux, free);
+}
+
+void save_game(scene_t *scene, uint8_t *out, game_context_t *ctx) {
+    snapshot_put_u64(&out, snapshot_index_of(scene, ctx->player));
+    snapshot_put_u64(&out, snapshot_index_of(scene, ctx->boss));
+    snapshot_put_u32(&out, ctx->boss_tangible);
+    snapshot_put_u64(&out, snapshot_index_of(scene, ctx->bounds.left));
+    snapshot_put_u64(&out, snapshot_index_of(scene, ctx->bounds.right));
+    snapshot_put_u64(&out, snapshot_index_of(scene, ctx->bounds.top));
+    snapshot_put_u64(&out, snapshot_index_of(scene, ctx->bounds.bottom));
+    snapshot_put_u64(&out, snapshot_index_of(scene, ctx->boss_triggers.movement));
+    snapshot_put_u64(&out, snapshot_index_of(scene, ctx->boss_triggers.left));
+    snapshot_put_u64(&out, snapshot_index_of(scene, ctx->boss_triggers.right));
+}
+
+void load_game(scene_t *scene, const uint8_t *in, body_t *const *bodies, size_t count, game_context_t *ctx) {
+    ctx->player = snapshot_body_at(bodies, snapshot_get_u64(&in));
+    ctx->boss = snapshot_body_at(bodies, snapshot_get_u64(&in));
+    ctx->boss_tangible = snapshot_get_u32(&in);
+    ctx->bounds.left = snapshot_body_at(bodies, snapshot_get_u64(&in));
+    ctx->bounds.right = snapshot_body_at(bodies, snapshot_get_u64(&in));
+    ctx->bounds.top = snapshot_body_at(bodies, snapshot_get_u64(&in));
+    ctx->bounds.bottom = snapshot_body_at(bodies, snapshot_get_u64(&in));
+    ctx->boss_triggers.movement = snapshot_body_at(bodies, snapshot_get_u64(&in));
+    ctx->boss_triggers.left = snapshot_body_at(bodies, snapshot_get_u64(&in));
+    ctx->boss_triggers.right = snapshot_body_at(bodies, snapshot_get_u64(&in));
+
+    // the same rules as game_loop() and the boss's collisions wire up
+    wire_interactions(ctx, PHASE_ALWAYS);
+    wire_enemy_steering(ctx);
+    if (ctx->boss == NULL) {
+        return;
+    }
+    if (!ctx->boss_tangible) {
+        init_boss_collisions(ctx, ctx->boss);
+        return;
+    }
+    wire_interactions(ctx, PHASE_BOSS_TANGIBLE);
+    create_collision(scene, ctx->boss, ctx->boss_triggers.left, create_boss_movement_left_collision, NULL, NULL);
+    create_collision(scene, ctx->boss, ctx->boss_triggers.right, create_boss_movement_right_collision, NULL, NULL);
+}
+
+sprite_t sprite_asset(uint32_t asset, game_context_t *ctx) {
+    assert(asset < SPRITE_COUNT);
+    return atlas_get(ctx->atlas, asset);
+}
+
+snapshot_codec_t game_snapshot_codec(game_context_t *ctx) {
+    return (snapshot_codec_t){
+        .info_size = ASTER_AUX_RECORD_SIZE,
+        .scene_size = GAME_RECORD_SIZE,
+        .aux = ctx,
+        .save_info = (void (*)(scene_t *, size_t, void *, void *))save_aster_aux,
+        .load_info = (void (*)(body_t *, const void *, body_t *const *, void *))load_aster_aux,
+        .save_scene = (void (*)(scene_t *, void *, void *))save_game,
+        .load_scene = (void (*)(scene_t *, const void *, body_t *const *, size_t, void *))load_game,
+        .asset_sprite = (sprite_t(*)(uint32_t, void *))sprite_asset};
+}
+
+bool game_snapshot_save(game_context_t *ctx, const char *path) {
+    snapshot_codec_t codec = game_snapshot_codec(ctx);
+    return snapshot_save(ctx->scene, &codec, path);
+}
+
+bool game_snapshot_load(game_context_t *ctx, const char *path) {
+    snapshot_codec_t codec = game_snapshot_codec(ctx);
+    return snapshot_load(ctx->scene, &codec, path);
+}
@@ -1,9 +1,22 @@
 #include "aster_blaster_imports.h"
 
-void destroy_ast_sprite_list(ast_sprites_list_t list) {
-    SDL_DestroyTexture(list.circle);
-    SDL_DestroyTexture(list.heptagon);
-    SDL_DestroyTexture(list.hexagon);
-    SDL_DestroyTexture(list.pentagon);
-    // SDL_DestroyTexture(list.ship);
-}
\ No newline at end of file
+const char *const SPRITE_PATHS[SPRITE_COUNT] = {
+    [SPRITE_SHIP] = "./assets/ship.png",
+    [SPRITE_CIRCLE] = "./assets/circle.png",
+    [SPRITE_HEPTAGON] = "./assets/heptagon.png",
+    [SPRITE_HEXAGON] = "./assets/hexagon.png",
+    [SPRITE_PENTAGON] = "./assets/pentagon.png",
+    [SPRITE_BLACK_HOLE] = "./assets/blackhole.png",
+    [SPRITE_BOSS_ALIEN] = "./assets/boss_alien.png",
+    [SPRITE_SAW_ALIEN] = "./assets/saw_alien.png",
+    [SPRITE_SHOOTING_ALIEN] = "./assets/shooting_alien.png",
+};
+
+ast_sprites_list_t ast_sprites_list_init(const sdl_atlas_t *atlas) {
+    return (ast_sprites_list_t){
+        .circle = atlas_get(atlas, SPRITE_CIRCLE),
+        .heptagon = atlas_get(atlas, SPRITE_HEPTAGON),
+        .hexagon = atlas_get(atlas, SPRITE_HEXAGON),
+        .pentagon = atlas_get(atlas, SPRITE_PENTAGON),
+    };
+}
@@ -1,26 +1,26 @@
 #include "aster_blaster_imports.h"
 
-vector_t get_pos_radius_off_screen(double radius) {
-    size_t direction = irand_range(1, 4);
+vector_t get_pos_radius_off_screen(rng_t *rng, double radius) {
+    size_t direction = rng_int_range(rng, 1, 4);
     double x, y;
     switch (direction) {
     case 1: { // left
         x = SDL_MIN.x - radius;
-        y = drand_range(SDL_MIN.y, SDL_MAX.y);
+        y = rng_range(rng, SDL_MIN.y, SDL_MAX.y);
         break;
     }
     case 2: { // right
         x = SDL_MAX.x + radius;
-        y = drand_range(SDL_MIN.y, SDL_MAX.y);
+        y = rng_range(rng, SDL_MIN.y, SDL_MAX.y);
         break;
     }
     case 3: { // up
-        x = drand_range(SDL_MIN.x, SDL_MAX.x);
+        x = rng_range(rng, SDL_MIN.x, SDL_MAX.x);
         y = SDL_MAX.y + radius;
         break;
     }
     case 4: { // down
-        x = drand_range(SDL_MIN.x, SDL_MAX.x);
+        x = rng_range(rng, SDL_MIN.x, SDL_MAX.x);
         y = SDL_MIN.y - radius;
         break;
     }
@@ -76,26 +76,39 @@ void velocity_handle(body_t *body, size_t key_down, game_bounds_t bounds) {
     }
 }
 
-void shoot_handle(scene_t *scene,
-                  body_t *player,
-                  double *bullet_time,
-                  size_t key_down,
-                  game_bounds_t bounds,
-                  ast_sprites_list_t ast_sprites_list,
-                  bool boss_tangible) {
+double weapon_reload(game_context_t *ctx) {
+    ctx->weapon_ready = true;
+    return TIMER_STOP;
+}
+
+void shoot_handle(game_context_t *ctx, size_t key_down) {
+    if (!ctx->weapon_ready) {
+        return;
+    }
+    double cooldown;
     if (get_nth_bit(key_down, ATTACK1_BUTTON)) {
-        if (*bullet_time > BULLET_COOLDOWN) {
-            spawn_bullet(scene, player, bounds, ast_sprites_list, boss_tangible);
-            *bullet_time = 0;
-        }
+        spawn_bullet(ctx);
+        cooldown = BULLET_COOLDOWN;
     } else if (get_nth_bit(key_down, ATTACK2_BUTTON)) {
-        if (*bullet_time > LASER_COOLDOWN) {
-            spawn_laser(scene, player, bounds, ast_sprites_list, boss_tangible);
-            *bullet_time = 0;
-        }
+        spawn_laser(ctx);
+        cooldown = LASER_COOLDOWN;
+    } else {
+        return;
+    }
+    ctx->weapon_ready = false;
+    scene_schedule(ctx->scene, cooldown, (timer_callback_t)weapon_reload, ctx, NULL);
+}
+
+double rate_variant(rng_t *rng, double rate) {
+    return rate * rng_range(rng, RATE_VARIANT_LOWER, RATE_VARIANT_UPPER);
+}
+
+void seed_game(game_context_t *ctx, uint64_t seed) {
+    for (size_t i = 0; i < RNG_STREAM_COUNT; i++) {
+        ctx->rngs[i] = rng_init(seed, i);
     }
 }
 
-double rate_variant(double rate) {
-    return rate * drand_range(RATE_VARIANT_LOWER, RATE_VARIANT_UPPER);
+rng_t *game_rng(game_context_t *ctx, rng_stream_e stream) {
+    return &ctx->rngs[stream];
 }
@@ -0,0 +1,57 @@
+#include "atlas.h"
+#include "alloc_track.h"
+#include <assert.h>
+#include <stdlib.h>
+
+typedef struct sdl_atlas {
+    SDL_Texture *tex;
+    size_t count;
+    sprite_t *sprites;
+    // texture coordinate of a pure white texel, used for colored polygons
+    SDL_FPoint white_uv;
+} sdl_atlas_t;
+
+sdl_atlas_t *atlas_init(SDL_Texture *tex, size_t count) {
+    sdl_atlas_t *atlas = TRACKED_MALLOC(ALLOC_OTHER, sizeof(sdl_atlas_t));
+    assert(atlas != NULL);
+    atlas->sprites = TRACKED_MALLOC(ALLOC_OTHER, count * sizeof(sprite_t));
+    assert(count == 0 || atlas->sprites != NULL);
+    atlas->tex = tex;
+    atlas->count = count;
+    for (size_t i = 0; i < count; i++) {
+        atlas->sprites[i] = (sprite_t){.tex = tex, .uv = {0, 0, 1, 1}, .atlas_index = i};
+    }
+    atlas->white_uv = (SDL_FPoint){0, 0};
+    return atlas;
+}
+
+void atlas_free(sdl_atlas_t *atlas) {
+    TRACKED_FREE(ALLOC_OTHER, atlas->sprites);
+    TRACKED_FREE(ALLOC_OTHER, atlas);
+}
+
+void atlas_set_sprite(sdl_atlas_t *atlas, size_t index, SDL_FRect uv) {
+    assert(index < atlas->count);
+    atlas->sprites[index].uv = uv;
+}
+
+sprite_t atlas_get(const sdl_atlas_t *atlas, size_t index) {
+    assert(index < atlas->count);
+    return atlas->sprites[index];
+}
+
+size_t atlas_size(const sdl_atlas_t *atlas) {
+    return atlas->count;
+}
+
+SDL_Texture *atlas_get_texture(const sdl_atlas_t *atlas) {
+    return atlas->tex;
+}
+
+void atlas_set_white_uv(sdl_atlas_t *atlas, SDL_FPoint uv) {
+    atlas->white_uv = uv;
+}
+
+SDL_FPoint atlas_get_white_uv(const sdl_atlas_t *atlas) {
+    return atlas->white_uv;
+}
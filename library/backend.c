@@ -0,0 +1,66 @@
+#include "backend.h"
+#include <assert.h>
+#include <stdlib.h>
+
+/**
+ * The backend that the backend_*() functions forward to.
+ */
+const backend_t *current_backend = NULL;
+
+void backend_use(const backend_t *backend) {
+    assert(backend != NULL);
+    current_backend = backend;
+}
+
+const backend_t *backend_current(void) {
+    assert(current_backend != NULL);
+    return current_backend;
+}
+
+void backend_init(vector_t min, vector_t max) {
+    backend_current()->init(min, max);
+}
+
+void backend_set_background_color(rgb_color_t color) {
+    backend_current()->set_background_color(color);
+}
+
+void backend_set_font(const char *font_path) {
+    backend_current()->set_font(font_path);
+}
+
+void backend_on_key(key_handler_t handler) {
+    backend_current()->on_key(handler);
+}
+
+bool backend_is_done(void *aux) {
+    return backend_current()->is_done(aux);
+}
+
+void backend_render_scene(const scene_t *scene) {
+    backend_current()->render_scene(scene);
+}
+
+void backend_run(void (*game)(void)) {
+    backend_current()->run(game);
+}
+
+sdl_atlas_t *backend_atlas_init(const char *const *files, size_t count) {
+    return backend_current()->atlas_init(files, count);
+}
+
+void backend_atlas_free(sdl_atlas_t *atlas) {
+    backend_current()->atlas_free(atlas);
+}
+
+double backend_time_since_last_tick(void) {
+    return backend_current()->time_since_last_tick();
+}
+
+void backend_set_frame_rate(double fps) {
+    backend_current()->set_frame_rate(fps);
+}
+
+const frame_clock_t *backend_frame_clock(void) {
+    return backend_current()->frame_clock();
+}
@@ -0,0 +1,68 @@
+#include "bench_util.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Number of timed samples per benchmark
+#define BENCH_SAMPLES 10
+// Shortest time one sample may take, so the clock's resolution doesn't matter
+const double BENCH_MIN_SAMPLE_NS = 5e6;
+const double NS_PER_S = 1e9;
+
+volatile double bench_sink = 0;
+
+// Whether a result has been printed in the current suite, to place commas
+bool bench_printed = false;
+
+double bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * NS_PER_S + now.tv_nsec;
+}
+
+double bench_time_ns(bench_func_t func, void *aux, size_t iterations) {
+    double start = bench_now_ns();
+    func(aux, iterations);
+    return bench_now_ns() - start;
+}
+
+void bench_begin(const char *suite) {
+    printf("{\"suite\": \"%s\", \"results\": [", suite);
+    bench_printed = false;
+}
+
+void bench_run(const char *name, size_t size, bench_func_t func, void *aux) {
+    // warm up, doubling the iterations until a sample is long enough
+    size_t iterations = 1;
+    while (bench_time_ns(func, aux, iterations) < BENCH_MIN_SAMPLE_NS) {
+        iterations *= 2;
+    }
+
+    double samples[BENCH_SAMPLES];
+    double mean = 0;
+    double min = INFINITY;
+    for (size_t i = 0; i < BENCH_SAMPLES; i++) {
+        samples[i] = bench_time_ns(func, aux, iterations) / iterations;
+        mean += samples[i] / BENCH_SAMPLES;
+        min = fmin(min, samples[i]);
+    }
+    double variance = 0;
+    for (size_t i = 0; i < BENCH_SAMPLES; i++) {
+        variance += (samples[i] - mean) * (samples[i] - mean) / (BENCH_SAMPLES - 1);
+    }
+
+    printf("%s\n  {\"name\": \"%s\", \"size\": %zu, \"iterations\": %zu, \"samples\": %d, "
+           "\"ns_per_op\": %.3f, \"stddev_ns\": %.3f, \"min_ns\": %.3f}",
+           bench_printed ? "," : "", name, size, iterations, BENCH_SAMPLES,
+           mean, sqrt(variance), min);
+    fflush(stdout);
+    bench_printed = true;
+}
+
+void bench_end(void) {
+    printf("\n]}\n");
+}
@@ -1,4 +1,5 @@
 #include "body.h"
+#include "alloc_track.h"
 #include "color.h"
 #include "list.h"
 #include "math.h"
@@ -15,6 +16,13 @@ typedef struct body {
     double mass;
     list_t *shape;
 
+    // the shared shape the vertices are derived from, or NULL if the body
+    // owns its vertices. shape then points into the vertices buffer.
+    const shape_template_t *shape_template;
+    vector_t *vertices;
+    size_t vertex_capacity;
+    double scale;
+
     vector_t centroid;
     vector_t velocity;
     vector_t acceleration;
@@ -25,21 +33,39 @@ typedef struct body {
     bool manual_acceleration;
 
     render_info_t texture;
+    render_layer_e layer;
+    size_t tag;
+
+    double bounding_radius;
+    bool cullable;
+    bool wrapping;
 
     bool destroy;
 
     void *aux;
     free_func_t freer;
+
+    // who body_release() gives the body to, if anyone
+    body_releaser_t releaser;
+    void *owner;
 } body_t;
 
-body_t *body_init_texture(list_t *shape, double mass, render_info_t texture) {
-    body_t *body = malloc(sizeof(body_t));
+/**
+ * Allocates a body with every field at its default, except its centroid
+ * and bounding radius, which depend on how its shape is stored.
+ */
+body_t *body_alloc(list_t *shape, double mass, render_info_t texture) {
+    body_t *body = TRACKED_MALLOC(ALLOC_BODY, sizeof(body_t));
     assert(body != NULL);
 
     body->mass = mass;
-    body->centroid = polygon_centroid(shape);
     body->shape = shape;
 
+    body->shape_template = NULL;
+    body->vertices = NULL;
+    body->vertex_capacity = 0;
+    body->scale = 1;
+
     body->velocity = VEC_ZERO;
     body->acceleration = VEC_ZERO;
 
@@ -49,11 +75,77 @@ body_t *body_init_texture(list_t *shape, double mass, render_info_t texture) {
     body->manual_acceleration = false;
 
     body->texture = texture;
+    body->layer = LAYER_DEFAULT;
+    body->tag = BODY_TAG_NONE;
+
+    body->cullable = false;
+    body->wrapping = false;
 
     body->destroy = false;
     body->aux = NULL;
     body->freer = NULL;
 
+    body->releaser = NULL;
+    body->owner = NULL;
+
+    return body;
+}
+
+body_t *body_init_texture(list_t *shape, double mass, render_info_t texture) {
+    body_t *body = body_alloc(shape, mass, texture);
+    body->centroid = polygon_centroid(shape);
+    body->bounding_radius = 0;
+    for (size_t i = 0; i < list_size(shape); i++) {
+        vector_t *vertex = list_get(shape, i);
+        body->bounding_radius = fmax(body->bounding_radius, vec_norm(vec_subtract(*vertex, body->centroid)));
+    }
+    return body;
+}
+
+/**
+ * Recomputes a template body's vertices from its template, scale,
+ * angle and centroid.
+ */
+void body_derive_vertices(body_t *body) {
+    const shape_template_t *shape = body->shape_template;
+    const vector_t *unit = shape_template_vertices(shape);
+    vector_t center = shape_template_centroid(shape);
+    double c = cos(body->theta) * body->scale;
+    double s = sin(body->theta) * body->scale;
+    for (size_t i = 0; i < shape_template_size(shape); i++) {
+        vector_t v = vec_subtract(unit[i], center);
+        body->vertices[i] = (vector_t){
+            body->centroid.x + c * v.x - s * v.y,
+            body->centroid.y + s * v.x + c * v.y};
+    }
+}
+
+body_t *body_init_template(
+    const shape_template_t *shape,
+    vector_t center,
+    double radius,
+    double mass,
+    render_info_t texture
+) {
+    assert(radius > 0);
+    size_t size = shape_template_size(shape);
+    vector_t *vertices = TRACKED_MALLOC(ALLOC_VERTEX, size * sizeof(vector_t));
+    assert(vertices != NULL);
+    // the list only points into the buffer, so it frees nothing
+    list_t *view = list_init(size, NULL);
+    for (size_t i = 0; i < size; i++) {
+        vertices[i] = vec_add(center, vec_multiply(radius, shape_template_vertices(shape)[i]));
+        list_add(view, &vertices[i]);
+    }
+
+    // the template knows its centroid and radius, so the vertices aren't scanned
+    body_t *body = body_alloc(view, mass, texture);
+    body->shape_template = shape;
+    body->vertices = vertices;
+    body->vertex_capacity = size;
+    body->scale = radius;
+    body->centroid = vec_add(center, vec_multiply(radius, shape_template_centroid(shape)));
+    body->bounding_radius = radius * shape_template_radius(shape);
     return body;
 }
 
@@ -87,13 +179,58 @@ body_t *body_init_with_info(
     return body_init_texture_with_info(shape, mass, render_color(color), info, info_freer);
 }
 
+void body_set_template(body_t *body, const shape_template_t *shape) {
+    assert(body->shape_template != NULL);
+    size_t size = shape_template_size(shape);
+    if (size > body->vertex_capacity) {
+        body->vertices = TRACKED_REALLOC(ALLOC_VERTEX, body->vertices, size * sizeof(vector_t));
+        assert(body->vertices != NULL);
+        body->vertex_capacity = size;
+    }
+    // the buffer may have moved, so point the whole list at it again
+    while (list_size(body->shape) > 0) {
+        list_remove(body->shape, list_size(body->shape) - 1);
+    }
+    for (size_t i = 0; i < size; i++) {
+        list_add(body->shape, &body->vertices[i]);
+    }
+    body->shape_template = shape;
+    body->bounding_radius = body->scale * shape_template_radius(shape);
+    body_derive_vertices(body);
+}
+
 void body_free(body_t *body) {
     list_free(body->shape);
+    if (body->vertices != NULL) {
+        TRACKED_FREE(ALLOC_VERTEX, body->vertices);
+    }
     // list_free(body->decals);
     if (body->aux != NULL && body->freer != NULL) {
         body->freer(body->aux);
     }
-    free(body);
+    TRACKED_FREE(ALLOC_BODY, body);
+}
+
+void body_release(body_t *body) {
+    if (body->releaser != NULL) {
+        body->releaser(body->owner, body);
+    } else {
+        body_free(body);
+    }
+}
+
+void body_set_releaser(body_t *body, body_releaser_t releaser, void *owner) {
+    body->releaser = releaser;
+    body->owner = owner;
+}
+
+void body_reset(body_t *body, vector_t centroid) {
+    body->destroy = false;
+    body->velocity = VEC_ZERO;
+    body->acceleration = VEC_ZERO;
+    body->omega = 0;
+    body_set_rotation(body, 0);
+    body_set_centroid(body, centroid);
 }
 
 // void body_add_decal(body_t *body, body_t *decal) {
@@ -101,7 +238,12 @@ void body_free(body_t *body) {
 // }
 
 list_t *body_get_shape_cloned(const body_t *body) {
-    return list_clone(body->shape, (clone_func_t)vec_clone);
+    // not list_clone(), since a template body's list frees nothing
+    list_t *shape = list_init(list_size(body->shape), free);
+    for (size_t i = 0; i < list_size(body->shape); i++) {
+        list_add(shape, vec_clone(list_borrow(body->shape, i)));
+    }
+    return shape;
 }
 
 list_t *body_get_shape(body_t *body) {
@@ -112,6 +254,14 @@ const list_t *body_borrow_shape(const body_t *body) {
     return body->shape;
 }
 
+const shape_template_t *body_get_template(const body_t *body) {
+    return body->shape_template;
+}
+
+double body_get_scale(const body_t *body) {
+    return body->scale;
+}
+
 vector_t body_get_centroid(const body_t *body) {
     return body->centroid;
 }
@@ -144,15 +294,75 @@ render_info_t body_get_render_data(const body_t *body) {
     return body->texture;
 }
 
+void body_set_render_data(body_t *body, render_info_t texture) {
+    body->texture = texture;
+}
+
+render_layer_e body_get_layer(const body_t *body) {
+    return body->layer;
+}
+
+void body_set_layer(body_t *body, render_layer_e layer) {
+    assert(layer < RENDER_LAYER_COUNT);
+    body->layer = layer;
+}
+
+size_t body_get_tag(const body_t *body) {
+    return body->tag;
+}
+
+void body_set_tag(body_t *body, size_t tag) {
+    body->tag = tag;
+}
+
+double body_get_bounding_radius(const body_t *body) {
+    return body->bounding_radius;
+}
+
+bool body_is_cullable(const body_t *body) {
+    return body->cullable;
+}
+
+void body_set_cullable(body_t *body, bool cullable) {
+    body->cullable = cullable;
+}
+
+bool body_is_wrapping(const body_t *body) {
+    return body->wrapping;
+}
+
+void body_set_wrapping(body_t *body, bool wrapping) {
+    body->wrapping = wrapping;
+}
+
 void *body_get_info(body_t *body) {
     return body->aux;
 }
 
+void body_set_info(body_t *body, void *info, free_func_t info_freer) {
+    body->aux = info;
+    body->freer = info_freer;
+}
+
 void body_translate(body_t *body, vector_t translate) {
     body->centroid = vec_add(body->centroid, translate);
     polygon_translate(body->shape, translate);
 }
 
+void body_scale(body_t *body, double factor) {
+    assert(factor > 0);
+    body->scale *= factor;
+    body->bounding_radius *= factor;
+    if (body->shape_template != NULL) {
+        body_derive_vertices(body);
+        return;
+    }
+    for (size_t i = 0; i < list_size(body->shape); i++) {
+        vector_t *vertex = list_get(body->shape, i);
+        *vertex = vec_add(body->centroid, vec_multiply(factor, vec_subtract(*vertex, body->centroid)));
+    }
+}
+
 void body_set_centroid(body_t *body, vector_t x) {
     body_translate(body, vec_subtract(x, body_get_centroid(body)));
 }
@@ -178,14 +388,22 @@ void body_set_mass(body_t *body, double mass) {
 }
 
 void body_rotate(body_t *body, double angle) {
-    polygon_rotate(body->shape, angle, body_get_centroid(body));
     body->theta += angle;
+    if (body->shape_template != NULL) {
+        body_derive_vertices(body);
+        return;
+    }
+    polygon_rotate(body->shape, angle, body_get_centroid(body));
 }
 
 void body_set_rotation(body_t *body, double angle) {
     body_rotate(body, angle - body->theta);
 }
 
+void body_set_angle(body_t *body, double angle) {
+    body->theta = angle;
+}
+
 void body_add_force(body_t *body, vector_t force) { // TODO: possible DBZ error
     vector_t delta_acc = vec_multiply(1 / body->mass, force); // a = F/m
     body->acceleration = vec_add(body->acceleration, delta_acc);
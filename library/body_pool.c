@@ -0,0 +1,65 @@
+#include "body_pool.h"
+#include "alloc_track.h"
+#include <assert.h>
+#include <stdlib.h>
+
+typedef struct body_pool {
+    // every body in the pool, so they can be freed
+    body_t **bodies;
+    size_t size;
+    size_t capacity;
+    // the bodies that can be acquired, used as a stack
+    body_t **idle;
+    size_t idle_count;
+} body_pool_t;
+
+body_pool_t *body_pool_init(size_t capacity) {
+    body_pool_t *pool = TRACKED_MALLOC(ALLOC_OTHER, sizeof(body_pool_t));
+    assert(pool != NULL);
+    pool->bodies = TRACKED_MALLOC(ALLOC_OTHER, capacity * sizeof(body_t *));
+    pool->idle = TRACKED_MALLOC(ALLOC_OTHER, capacity * sizeof(body_t *));
+    assert(capacity == 0 || (pool->bodies != NULL && pool->idle != NULL));
+    pool->size = 0;
+    pool->capacity = capacity;
+    pool->idle_count = 0;
+    return pool;
+}
+
+void body_pool_free(body_pool_t *pool) {
+    assert(pool->idle_count == pool->size);
+    for (size_t i = 0; i < pool->size; i++) {
+        body_free(pool->bodies[i]);
+    }
+    TRACKED_FREE(ALLOC_OTHER, pool->bodies);
+    TRACKED_FREE(ALLOC_OTHER, pool->idle);
+    TRACKED_FREE(ALLOC_OTHER, pool);
+}
+
+void body_pool_take_back(body_pool_t *pool, body_t *body) {
+    assert(pool->idle_count < pool->size);
+    pool->idle[pool->idle_count++] = body;
+}
+
+void body_pool_add(body_pool_t *pool, body_t *body) {
+    assert(pool->size < pool->capacity);
+    pool->bodies[pool->size++] = body;
+    pool->idle[pool->idle_count++] = body;
+    body_set_releaser(body, (body_releaser_t)body_pool_take_back, pool);
+}
+
+body_t *body_pool_acquire(body_pool_t *pool, vector_t centroid) {
+    if (pool->idle_count == 0) {
+        return NULL;
+    }
+    body_t *body = pool->idle[--pool->idle_count];
+    body_reset(body, centroid);
+    return body;
+}
+
+size_t body_pool_size(const body_pool_t *pool) {
+    return pool->size;
+}
+
+size_t body_pool_idle(const body_pool_t *pool) {
+    return pool->idle_count;
+}
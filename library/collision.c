@@ -4,6 +4,7 @@
 #include "vector.h"
 #include <assert.h>
 #include "collision.h"
+#include "profiler.h"
 #include <float.h>
 #include <math.h>
 
@@ -47,11 +48,6 @@ bounding_box_t polygon_bounding_box(const list_t *poly) {
     return box;
 }
 
-typedef struct interval {
-    double low;
-    double high;
-} interval_t;
-
 // contract: intervals are well formed (low <= high)
 // returns the length of intersection (0 = no intersect)
 double intervals_intersect(interval_t i1, interval_t i2) {
@@ -62,7 +58,6 @@ double intervals_intersect(interval_t i1, interval_t i2) {
     }
 }
 
-// contract: axis is normalized (a unit vector)
 interval_t polygon_project(const list_t *poly, vector_t axis) {
     vector_t point0 = list_copy_vector(poly, 0);
     double point0d = vec_dot(point0, axis);
@@ -128,12 +123,15 @@ collision_info_t find_collision(const list_t *poly1, const list_t *poly2) {
     if (!bounding_box_collide(polygon_bounding_box(poly1), polygon_bounding_box(poly2))) {
         return (collision_info_t){ .collided = false, .axis = VEC_ZERO };
     }
+    PROFILE_COUNT(COUNTER_BOUNDING_BOX_PASSED);
 
+    PROFILE_COUNT(COUNTER_SAT_TESTS);
     partial_sat_result_t result1 = partial_sat(poly1, poly2);
     if (!result1.collided) {
         return (collision_info_t){ .collided = false, .axis = VEC_ZERO };
     }
 
+    PROFILE_COUNT(COUNTER_SAT_TESTS);
     partial_sat_result_t result2 = partial_sat(poly2, poly1);
     if (!result2.collided) {
         return (collision_info_t){ .collided = false, .axis = VEC_ZERO };
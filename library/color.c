@@ -25,12 +25,18 @@ render_info_t render_color(rgb_color_t color) {
 }
 
 render_info_t render_texture(SDL_Texture *tex, int w, int h) {
-    assert(tex != NULL);
+    return render_sprite((sprite_t){.tex = tex, .uv = {0, 0, 1, 1}, .atlas_index = NOT_IN_ATLAS}, w, h);
+}
+
+render_info_t render_sprite(sprite_t sprite, int w, int h) {
+    assert(sprite.tex != NULL);
     return (render_info_t){
         .type = TEX,
         .data = (render_data_t){
             .texture = {
-                .tex = tex,
+                .tex = sprite.tex,
+                .uv = sprite.uv,
+                .atlas_index = sprite.atlas_index,
                 .dx = w / 2,
                 .dy = h / 2,
                 .w = w,
@@ -1,6 +1,8 @@
 #include "forces.h"
 #include "body.h"
 #include "collision.h"
+#include "profiler.h"
+#include "alloc_track.h"
 #include "scene.h"
 #include "utils.h"
 #include <math.h>
@@ -19,24 +21,28 @@ typedef struct newtonian_gravity_aux {
     bool one_way;
 } newtonian_gravity_aux_t;
 
-void newtonian_gravity_handler(newtonian_gravity_aux_t *aux) {
-    vector_t radius_vector = vec_subtract(body_get_centroid(aux->body2), body_get_centroid(aux->body1));
+void apply_newtonian_gravity(double G, body_t *body1, body_t *body2, bool one_way) {
+    vector_t radius_vector = vec_subtract(body_get_centroid(body2), body_get_centroid(body1));
     double radius = vec_norm(radius_vector);
 
-    double mass1 = body_get_mass(aux->body1);
-    double mass2 = body_get_mass(aux->body2);
+    double mass1 = body_get_mass(body1);
+    double mass2 = body_get_mass(body2);
     vector_t force =
-        radius >= MIN_RADIUS_FOR_EFFECT ? vec_multiply(-aux->G * mass1 * mass2 / (radius * radius), vec_normalize(radius_vector))
+        radius >= MIN_RADIUS_FOR_EFFECT ? vec_multiply(-G * mass1 * mass2 / (radius * radius), vec_normalize(radius_vector))
                    : VEC_ZERO;
 
-    if (!aux->one_way) {
-        body_add_force(aux->body2, force);
+    if (!one_way) {
+        body_add_force(body2, force);
     }
-    body_add_force(aux->body1, vec_negate(force));
+    body_add_force(body1, vec_negate(force));
+}
+
+void newtonian_gravity_handler(newtonian_gravity_aux_t *aux) {
+    apply_newtonian_gravity(aux->G, aux->body1, aux->body2, aux->one_way);
 }
 
 void create_newtonian_gravity(scene_t *scene, double G, body_t *body1, body_t *body2, bool one_way) {
-    newtonian_gravity_aux_t *aux = malloc(sizeof(newtonian_gravity_aux_t));
+    newtonian_gravity_aux_t *aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(newtonian_gravity_aux_t));
     aux->G = G;
     aux->body1 = body1;
     aux->body2 = body2;
@@ -47,6 +53,22 @@ void create_newtonian_gravity(scene_t *scene, double G, body_t *body1, body_t *b
     scene_add_bodies_force_creator(scene, (force_creator_t)newtonian_gravity_handler, aux, list, free);
 }
 
+typedef struct pair_gravity_aux {
+    double G;
+    bool one_way;
+} pair_gravity_aux_t;
+
+void pair_gravity_handler(body_t *body1, body_t *body2, pair_gravity_aux_t *aux) {
+    apply_newtonian_gravity(aux->G, body1, body2, aux->one_way);
+}
+
+void create_pair_newtonian_gravity(scene_t *scene, double G, size_t tag1, size_t tag2, bool one_way) {
+    pair_gravity_aux_t *aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(pair_gravity_aux_t));
+    aux->G = G;
+    aux->one_way = one_way;
+    scene_add_pair_force_creator(scene, tag1, tag2, (pair_force_creator_t)pair_gravity_handler, aux, free);
+}
+
 // Attraction force
 
 typedef struct attraction_aux {
@@ -56,22 +78,25 @@ typedef struct attraction_aux {
     bool one_way;
 } attraction_aux_t;
 
-void attraction_handler(attraction_aux_t *aux) {
-    vector_t radius_vector = vec_subtract(body_get_centroid(aux->body2), body_get_centroid(aux->body1));
+vector_t attraction_velocity(double A, vector_t position, vector_t target) {
+    vector_t radius_vector = vec_subtract(target, position);
     double radius = vec_norm(radius_vector);
 
-    vector_t force =
-        radius >= MIN_RADIUS_FOR_EFFECT ? vec_multiply(-aux->A * radius, vec_normalize(radius_vector))
-                   : VEC_ZERO;
+    return radius >= MIN_RADIUS_FOR_EFFECT ? vec_multiply(A * radius, vec_normalize(radius_vector))
+                      : VEC_ZERO;
+}
+
+void attraction_handler(attraction_aux_t *aux) {
+    vector_t velocity = attraction_velocity(aux->A, body_get_centroid(aux->body1), body_get_centroid(aux->body2));
 
     if (!aux->one_way) {
-        body_set_velocity(aux->body2, force);
+        body_set_velocity(aux->body2, vec_negate(velocity));
     }
-    body_set_velocity(aux->body1, vec_negate(force));
+    body_set_velocity(aux->body1, velocity);
 }
 
 void create_attraction(scene_t *scene, double A, body_t *body1, body_t *body2, bool one_way) {
-    attraction_aux_t *aux = malloc(sizeof(attraction_aux_t));
+    attraction_aux_t *aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(attraction_aux_t));
     aux->A = A;
     aux->body1 = body1;
     aux->body2 = body2;
@@ -95,18 +120,11 @@ typedef struct attraction_mirrored_aux {
 void attraction_mirrored_handler(attraction_mirrored_aux_t *aux) {
     vector_t anti_center = vec_subtract(aux->sdl_max, body_get_centroid(aux->body_unaffected));
     anti_center = vec_add(anti_center, aux->offset);
-    vector_t radius_vector = vec_subtract(anti_center, body_get_centroid(aux->body_to_move));
-    double radius = vec_norm(radius_vector);
-
-    vector_t force =
-        radius >= MIN_RADIUS_FOR_EFFECT ? vec_multiply(-aux->A * radius, vec_normalize(radius_vector))
-                   : VEC_ZERO;
-
-    body_set_velocity(aux->body_to_move, vec_negate(force));
+    body_set_velocity(aux->body_to_move, attraction_velocity(aux->A, body_get_centroid(aux->body_to_move), anti_center));
 }
 
 void create_attraction_mirrored(scene_t *scene, double A, body_t *body_to_move, body_t *body_unaffected, vector_t sdl_max, vector_t offset) {
-    attraction_mirrored_aux_t *aux = malloc(sizeof(attraction_mirrored_aux_t));
+    attraction_mirrored_aux_t *aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(attraction_mirrored_aux_t));
     aux->A = A;
     aux->body_to_move = body_to_move;
     aux->body_unaffected = body_unaffected;
@@ -133,7 +151,7 @@ void pointing_force_handler(pointing_force_aux_t *aux) {
 }
 
 void create_pointing_force(scene_t *scene, body_t *body_to_point, body_t *body_point_to) {
-    pointing_force_aux_t *aux = malloc(sizeof(pointing_force_aux_t));
+    pointing_force_aux_t *aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(pointing_force_aux_t));
     aux->body_to_point = body_to_point;
     aux->body_point_to = body_point_to;
     list_t *list = list_init(2, NULL);
@@ -159,7 +177,7 @@ void spring_handler(spring_aux_t *aux) {
 }
 
 void create_spring(scene_t *scene, double k, body_t *body1, body_t *body2) {
-    spring_aux_t *aux = malloc(sizeof(spring_aux_t));
+    spring_aux_t *aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(spring_aux_t));
     aux->k = k;
     aux->body1 = body1;
     aux->body2 = body2;
@@ -183,7 +201,7 @@ void drag_force_handler(drag_aux_t *aux) {
 }
 
 void create_drag(scene_t *scene, double gamma, body_t *body) {
-    drag_aux_t *aux = malloc(sizeof(drag_aux_t));
+    drag_aux_t *aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(drag_aux_t));
     aux->gamma = gamma;
     aux->body = body;
     list_t *list = list_init(1, NULL);
@@ -196,6 +214,7 @@ void create_drag(scene_t *scene, double gamma, body_t *body) {
 // COLLISION HANDLES
 
 typedef struct collision_aux {
+    scene_t *scene; // BORROWED
     body_t *body1; // BORROWED
     body_t *body2; // BORROWED
     collision_handler_t handler;
@@ -208,7 +227,7 @@ void collision_aux_free(collision_aux_t *ptr) {
     if (ptr->freer != NULL & ptr->aux != NULL) {
         ptr->freer(ptr->aux);
     }
-    free(ptr);
+    TRACKED_FREE(ALLOC_AUX, ptr);
 }
 
 void collision_handle(collision_aux_t *aux) {
@@ -217,10 +236,14 @@ void collision_handle(collision_aux_t *aux) {
     const list_t *shape1 = body_borrow_shape(aux->body1);
     const list_t *shape2 = body_borrow_shape(aux->body2);
 
+    // counted like the pairs of a pair collision, by the bodies' tags
+    PROFILE_PAIR_BEGIN(body_get_tag(aux->body1), body_get_tag(aux->body2));
+    PROFILE_COUNT(COUNTER_PAIRS_TESTED);
     collision_info_t info = find_collision(shape1, shape2);
     if (info.collided) {
-            aux->handler(aux->body1, aux->body2, info.axis, aux->aux);
+        scene_add_contact(aux->scene, aux->body1, aux->body2, info.axis, aux->handler, aux->aux, false);
     }
+    PROFILE_PAIR_END();
 }
 
 void create_collision(
@@ -230,7 +253,8 @@ void create_collision(
     collision_handler_t handler,
     void *aux,
     free_func_t freer) {
-    collision_aux_t *caux = malloc(sizeof(collision_aux_t));
+    collision_aux_t *caux = TRACKED_MALLOC(ALLOC_AUX, sizeof(collision_aux_t));
+    caux->scene = scene;
     caux->body1 = body1;
     caux->body2 = body2;
     caux->handler = handler;
@@ -248,6 +272,46 @@ void create_collision(
 
 
 
+typedef struct pair_collision_aux {
+    scene_t *scene; // BORROWED
+    collision_handler_t handler;
+    void *aux;
+    free_func_t freer;
+} pair_collision_aux_t;
+
+void pair_collision_aux_free(pair_collision_aux_t *ptr) {
+    if (ptr->freer != NULL && ptr->aux != NULL) {
+        ptr->freer(ptr->aux);
+    }
+    TRACKED_FREE(ALLOC_AUX, ptr);
+}
+
+void pair_collision_handle(body_t *body1, body_t *body2, pair_collision_aux_t *aux) {
+    collision_info_t info = find_collision(body_borrow_shape(body1), body_borrow_shape(body2));
+    if (info.collided) {
+        scene_add_contact(aux->scene, body1, body2, info.axis, aux->handler, aux->aux, false);
+    }
+}
+
+void create_pair_collision(
+    scene_t *scene,
+    size_t tag1,
+    size_t tag2,
+    collision_handler_t handler,
+    void *aux,
+    free_func_t freer) {
+    pair_collision_aux_t *caux = TRACKED_MALLOC(ALLOC_AUX, sizeof(pair_collision_aux_t));
+    caux->scene = scene;
+    caux->handler = handler;
+    caux->aux = aux;
+    caux->freer = freer;
+    scene_add_pair_force_creator(scene, tag1, tag2, (pair_force_creator_t)pair_collision_handle, caux, (free_func_t)pair_collision_aux_free);
+}
+
+
+
+
+
 // MUTUALLY DESTRUCTIVE COLLISION
 
 void destructive_collision_handler(body_t *body1, body_t *body2, vector_t axis, void *aux) {
@@ -260,6 +324,10 @@ void create_destructive_collision(scene_t *scene, body_t *body1, body_t *body2)
     create_collision(scene, body1, body2, destructive_collision_handler, NULL, NULL);
 }
 
+void create_pair_destructive_collision(scene_t *scene, size_t tag1, size_t tag2) {
+    create_pair_collision(scene, tag1, tag2, destructive_collision_handler, NULL, NULL);
+}
+
 
 
 
@@ -311,7 +379,17 @@ void create_physics_collision(
     double elasticity,
     body_t *body1,
     body_t *body2) {
-    physics_collision_aux *aux = malloc(sizeof(physics_collision_aux));
+    physics_collision_aux *aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(physics_collision_aux));
     aux->elasticity = elasticity;
     create_collision(scene, body1, body2, (collision_handler_t)physics_collision_handler, aux, free);
 }
+
+void create_pair_physics_collision(
+    scene_t *scene,
+    double elasticity,
+    size_t tag1,
+    size_t tag2) {
+    physics_collision_aux *aux = TRACKED_MALLOC(ALLOC_AUX, sizeof(physics_collision_aux));
+    aux->elasticity = elasticity;
+    create_pair_collision(scene, tag1, tag2, (collision_handler_t)physics_collision_handler, aux, free);
+}
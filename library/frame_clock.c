@@ -0,0 +1,129 @@
+#include "frame_clock.h"
+#include "alloc_track.h"
+#include <assert.h>
+#include <math.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Number of recent frames the histogram holds
+#define FRAME_CLOCK_WINDOW 240
+// Width of a histogram bucket, and how many there are before the last one,
+// which holds every frame of FRAME_CLOCK_BUCKETS * FRAME_CLOCK_BUCKET_MS or more
+#define FRAME_CLOCK_BUCKET_MS 0.1
+#define FRAME_CLOCK_BUCKETS 1000
+
+const double FRAME_CLOCK_MS_PER_S = 1e3;
+const double FRAME_CLOCK_NS_PER_S = 1e9;
+// Sleeping can overshoot, so the last part of a wait yields instead
+const double FRAME_CLOCK_YIELD_S = 0.002;
+
+typedef struct frame_clock {
+    // seconds per frame at the target rate, or 0 for no limit
+    double period;
+    // when the current frame started, or a negative time before the first tick
+    double frame_start;
+    // the bucket of each recent frame, a ring buffer
+    size_t window[FRAME_CLOCK_WINDOW];
+    size_t window_size;
+    size_t window_next;
+    size_t buckets[FRAME_CLOCK_BUCKETS + 1];
+} frame_clock_t;
+
+double frame_clock_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / FRAME_CLOCK_NS_PER_S;
+}
+
+frame_clock_t *frame_clock_init(double target_rate) {
+    frame_clock_t *clock = TRACKED_MALLOC(ALLOC_OTHER, sizeof(frame_clock_t));
+    assert(clock != NULL);
+    clock->frame_start = -1;
+    clock->window_size = 0;
+    clock->window_next = 0;
+    for (size_t i = 0; i <= FRAME_CLOCK_BUCKETS; i++) {
+        clock->buckets[i] = 0;
+    }
+    frame_clock_set_target(clock, target_rate);
+    return clock;
+}
+
+void frame_clock_free(frame_clock_t *clock) {
+    TRACKED_FREE(ALLOC_OTHER, clock);
+}
+
+void frame_clock_set_target(frame_clock_t *clock, double target_rate) {
+    assert(target_rate >= 0);
+    clock->period = target_rate > 0 ? 1 / target_rate : 0;
+}
+
+/** Waits until the monotonic clock reaches a deadline */
+void frame_clock_wait(double deadline) {
+    double remaining = deadline - frame_clock_now();
+    if (remaining > FRAME_CLOCK_YIELD_S) {
+        double sleep = remaining - FRAME_CLOCK_YIELD_S;
+        struct timespec duration = {
+            .tv_sec = (time_t)sleep,
+            .tv_nsec = (long)((sleep - floor(sleep)) * FRAME_CLOCK_NS_PER_S)};
+        nanosleep(&duration, NULL);
+    }
+    while (frame_clock_now() < deadline) {
+        sched_yield();
+    }
+}
+
+double frame_clock_tick(frame_clock_t *clock) {
+    if (clock->frame_start < 0) {
+        clock->frame_start = frame_clock_now();
+        return 0;
+    }
+    if (clock->period > 0) {
+        frame_clock_wait(clock->frame_start + clock->period);
+    }
+    double now = frame_clock_now();
+    double dt = now - clock->frame_start;
+    clock->frame_start = now;
+    frame_clock_record(clock, dt);
+    return dt;
+}
+
+void frame_clock_record(frame_clock_t *clock, double seconds) {
+    assert(seconds >= 0);
+    double position = seconds * FRAME_CLOCK_MS_PER_S / FRAME_CLOCK_BUCKET_MS;
+    size_t bucket = position < FRAME_CLOCK_BUCKETS ? (size_t)position : FRAME_CLOCK_BUCKETS;
+    if (clock->window_size == FRAME_CLOCK_WINDOW) {
+        clock->buckets[clock->window[clock->window_next]]--;
+    } else {
+        clock->window_size++;
+    }
+    clock->window[clock->window_next] = bucket;
+    clock->buckets[bucket]++;
+    clock->window_next = (clock->window_next + 1) % FRAME_CLOCK_WINDOW;
+}
+
+size_t frame_clock_frames(const frame_clock_t *clock) {
+    return clock->window_size;
+}
+
+double frame_clock_percentile(const frame_clock_t *clock, double fraction) {
+    assert(0 <= fraction && fraction <= 1);
+    if (clock->window_size == 0) {
+        return 0;
+    }
+    // the number of frames at or below the percentile, at least 1
+    size_t rank = ceil(fraction * clock->window_size);
+    if (rank == 0) {
+        rank = 1;
+    }
+    size_t seen = 0;
+    size_t bucket = 0;
+    for (; bucket < FRAME_CLOCK_BUCKETS; bucket++) {
+        seen += clock->buckets[bucket];
+        if (seen >= rank) {
+            break;
+        }
+    }
+    // the upper edge of the bucket
+    return (bucket + 1) * FRAME_CLOCK_BUCKET_MS;
+}
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <list.h>
+#include <alloc_track.h>
 #include <stdbool.h>
 
 // TODO: list_clear() tests
@@ -16,13 +17,13 @@ typedef struct list {
 } list_t;
 
 list_t *list_init(size_t initial_size, free_func_t freer) {
-    list_t *list = malloc(sizeof(list_t));
+    list_t *list = TRACKED_MALLOC(ALLOC_LIST, sizeof(list_t));
     assert(list != NULL);
 
     list->size = 0;
     list->capacity = initial_size;
     list->freer = freer;
-    list->data = malloc(initial_size * sizeof(void*));
+    list->data = TRACKED_MALLOC(ALLOC_LIST, initial_size * sizeof(void*));
     assert(list->data != NULL);
 
     return list;
@@ -34,8 +35,8 @@ void list_free(list_t *list) {
             list->freer(list->data[i]);
         }
     }
-    free(list->data);
-    free(list);
+    TRACKED_FREE(ALLOC_LIST, list->data);
+    TRACKED_FREE(ALLOC_LIST, list);
 }
 
 size_t list_size(const list_t *list) {
@@ -64,11 +65,17 @@ const void *list_borrow(const list_t *list, size_t index) {
  */
 void list_expand(list_t *list, size_t new_capacity) {
     assert(new_capacity > list->capacity);
-    list->data = realloc(list->data, new_capacity * sizeof(void *));
+    list->data = TRACKED_REALLOC(ALLOC_LIST, list->data, new_capacity * sizeof(void *));
     assert(list->data != NULL);
     list->capacity = new_capacity;
 }
 
+void list_reserve(list_t *list, size_t capacity) {
+    if (capacity > list->capacity) {
+        list_expand(list, capacity);
+    }
+}
+
 void list_add(list_t *list, void *value) {
     assert(value != NULL);
     if (list->size >= list->capacity) {
@@ -89,6 +96,15 @@ void *list_remove(list_t *list, size_t index) {
     return removed;
 }
 
+void *list_swap_remove(list_t *list, size_t index) {
+    assert(list->size > 0);
+    assert(index < list->size);
+    void *removed = list->data[index];
+    list->data[index] = list->data[list->size - 1];
+    list->size--;
+    return removed;
+}
+
 void *list_remove_item(list_t *list, const void *ptr) {
     size_t len = list_size(list);
     for (size_t i = 0; i < len; i++) {
@@ -0,0 +1,347 @@
+#include "profiler.h"
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Frames kept for profiler_average_ms() and profiler_write_csv()
+#define PROFILER_HISTORY_FRAMES 600
+// Zones kept for profiler_write_trace(); older ones are overwritten
+#define PROFILER_TRACE_EVENTS 65536
+// How deeply zones can nest on one thread
+#define PROFILER_MAX_DEPTH 16
+
+const double PROFILER_NS_PER_MS = 1e6;
+const double PROFILER_NS_PER_US = 1e3;
+
+const char *const PROFILE_ZONE_NAMES[PROFILE_ZONE_COUNT] = {
+    [ZONE_FRAME] = "frame",
+    [ZONE_SCENE_TICK] = "scene_tick",
+    [ZONE_TIMERS] = "timers",
+    [ZONE_CULL] = "cull",
+    [ZONE_FORCE_CREATORS] = "force_creators",
+    [ZONE_TAG_FORCES] = "tag_forces",
+    [ZONE_PAIR_FORCES] = "pair_forces",
+    [ZONE_COLLISION_HANDLERS] = "collision_handlers",
+    [ZONE_COMMANDS] = "commands",
+    [ZONE_REMOVAL] = "removal",
+    [ZONE_BODY_TICK] = "body_tick",
+    [ZONE_CAPTURE] = "capture",
+    [ZONE_RENDER] = "render",
+    [ZONE_TEXT] = "text",
+};
+
+const char *const PROFILE_COUNTER_NAMES[PROFILE_COUNTER_COUNT] = {
+    [COUNTER_PAIRS_TESTED] = "pairs_tested",
+    [COUNTER_BOUNDING_BOX_PASSED] = "bounding_box_passed",
+    [COUNTER_SAT_TESTS] = "sat_tests",
+    [COUNTER_HANDLERS_FIRED] = "handlers_fired",
+};
+
+// The pair of tags being counted, if in_pair
+bool in_pair = false;
+size_t pair_low = 0;
+size_t pair_high = 0;
+
+typedef struct open_zone {
+    profile_zone_e zone;
+    uint64_t start_ns;
+} open_zone_t;
+
+typedef struct trace_event {
+    profile_zone_e zone;
+    size_t thread;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+} trace_event_t;
+
+/**
+ * The zones running on each thread, innermost last.
+ * Zones run on the game thread and the main thread at the same time,
+ * so everything shared between threads below is atomic.
+ */
+_Thread_local open_zone_t open_zones[PROFILER_MAX_DEPTH];
+_Thread_local size_t open_depth = 0;
+// Numbers threads in the order they first start a zone, starting at 1
+_Thread_local size_t thread_number = 0;
+atomic_size_t thread_count = 0;
+
+// Time spent in each zone in the frame that hasn't ended yet
+_Atomic uint64_t frame_ns[PROFILE_ZONE_COUNT];
+atomic_size_t zone_depths[PROFILE_ZONE_COUNT];
+
+// Counts in the frame that hasn't ended yet, only touched by the game thread.
+// Pairs are stored with the lower tag first.
+size_t frame_counts[PROFILE_COUNTER_COUNT];
+size_t frame_pair_counts[PROFILER_MAX_TAGS][PROFILER_MAX_TAGS][PROFILE_COUNTER_COUNT];
+// The counts of the last frame that ended, published for other threads
+atomic_size_t last_counts[PROFILE_COUNTER_COUNT];
+size_t last_pair_counts[PROFILER_MAX_TAGS][PROFILER_MAX_TAGS][PROFILE_COUNTER_COUNT];
+size_t total_pair_counts[PROFILER_MAX_TAGS][PROFILER_MAX_TAGS][PROFILE_COUNTER_COUNT];
+size_t peak_pairs_tested[PROFILER_MAX_TAGS][PROFILER_MAX_TAGS];
+
+// The most recent frames, a ring buffer written only by profiler_frame_end()
+double history_ms[PROFILER_HISTORY_FRAMES][PROFILE_ZONE_COUNT];
+size_t history_counts[PROFILER_HISTORY_FRAMES][PROFILE_COUNTER_COUNT];
+size_t history_frames = 0;
+size_t history_next = 0;
+// The sum over the history of each zone
+double history_total_ms[PROFILE_ZONE_COUNT];
+// The mean over the history of each zone, published for other threads
+_Atomic uint64_t average_ns[PROFILE_ZONE_COUNT];
+
+trace_event_t trace[PROFILER_TRACE_EVENTS];
+// Total number of events ever recorded; the newest is at (count - 1) % size
+atomic_size_t trace_count = 0;
+
+uint64_t profiler_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+void profiler_begin(profile_zone_e zone) {
+    assert(zone < PROFILE_ZONE_COUNT);
+    assert(open_depth < PROFILER_MAX_DEPTH);
+    if (thread_number == 0) {
+        thread_number = atomic_fetch_add(&thread_count, 1) + 1;
+    }
+    atomic_store_explicit(&zone_depths[zone], open_depth, memory_order_relaxed);
+    open_zones[open_depth++] = (open_zone_t){.zone = zone, .start_ns = profiler_now_ns()};
+}
+
+void profiler_end(profile_zone_e zone) {
+    uint64_t end_ns = profiler_now_ns();
+    assert(open_depth > 0);
+    open_zone_t open = open_zones[--open_depth];
+    assert(open.zone == zone);
+
+    uint64_t duration_ns = end_ns - open.start_ns;
+    atomic_fetch_add_explicit(&frame_ns[zone], duration_ns, memory_order_relaxed);
+    size_t index = atomic_fetch_add_explicit(&trace_count, 1, memory_order_relaxed);
+    trace[index % PROFILER_TRACE_EVENTS] = (trace_event_t){
+        .zone = zone,
+        .thread = thread_number,
+        .start_ns = open.start_ns,
+        .duration_ns = duration_ns};
+}
+
+void profiler_count(profile_counter_e counter) {
+    assert(counter < PROFILE_COUNTER_COUNT);
+    frame_counts[counter]++;
+    if (in_pair) {
+        frame_pair_counts[pair_low][pair_high][counter]++;
+    }
+}
+
+void profiler_pair_begin(size_t tag1, size_t tag2) {
+    in_pair = tag1 < PROFILER_MAX_TAGS && tag2 < PROFILER_MAX_TAGS;
+    pair_low = tag1 < tag2 ? tag1 : tag2;
+    pair_high = tag1 < tag2 ? tag2 : tag1;
+}
+
+void profiler_pair_end(void) {
+    in_pair = false;
+}
+
+/** Moves the counts of the frame that ended into the last frame and the totals */
+void profiler_counters_frame_end(size_t *counts) {
+    for (size_t counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+        counts[counter] = frame_counts[counter];
+        atomic_store_explicit(&last_counts[counter], frame_counts[counter], memory_order_relaxed);
+        frame_counts[counter] = 0;
+    }
+    for (size_t low = 0; low < PROFILER_MAX_TAGS; low++) {
+        for (size_t high = low; high < PROFILER_MAX_TAGS; high++) {
+            size_t *pair_counts = frame_pair_counts[low][high];
+            for (size_t counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+                last_pair_counts[low][high][counter] = pair_counts[counter];
+                total_pair_counts[low][high][counter] += pair_counts[counter];
+                pair_counts[counter] = 0;
+            }
+            if (last_pair_counts[low][high][COUNTER_PAIRS_TESTED] > peak_pairs_tested[low][high]) {
+                peak_pairs_tested[low][high] = last_pair_counts[low][high][COUNTER_PAIRS_TESTED];
+            }
+        }
+    }
+}
+
+void profiler_frame_end(void) {
+    // once the history is full, the new frame replaces the oldest one
+    bool full = history_frames == PROFILER_HISTORY_FRAMES;
+    if (!full) {
+        history_frames++;
+    }
+    double *frame = history_ms[history_next];
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; zone++) {
+        if (full) {
+            history_total_ms[zone] -= frame[zone];
+        }
+        frame[zone] = atomic_exchange_explicit(&frame_ns[zone], 0, memory_order_relaxed) / PROFILER_NS_PER_MS;
+        history_total_ms[zone] += frame[zone];
+        // rounding can leave the sum of an idle zone just below 0
+        double average_ms = history_total_ms[zone] > 0 ? history_total_ms[zone] / history_frames : 0;
+        atomic_store_explicit(&average_ns[zone], average_ms * PROFILER_NS_PER_MS, memory_order_relaxed);
+    }
+    profiler_counters_frame_end(history_counts[history_next]);
+    history_next = (history_next + 1) % PROFILER_HISTORY_FRAMES;
+}
+
+void profiler_reset(void) {
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; zone++) {
+        atomic_store(&frame_ns[zone], 0);
+        atomic_store(&average_ns[zone], 0);
+        atomic_store(&zone_depths[zone], 0);
+        history_total_ms[zone] = 0;
+    }
+    for (size_t counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+        frame_counts[counter] = 0;
+        atomic_store(&last_counts[counter], 0);
+    }
+    memset(frame_pair_counts, 0, sizeof(frame_pair_counts));
+    memset(last_pair_counts, 0, sizeof(last_pair_counts));
+    memset(total_pair_counts, 0, sizeof(total_pair_counts));
+    memset(peak_pairs_tested, 0, sizeof(peak_pairs_tested));
+    in_pair = false;
+    history_frames = 0;
+    history_next = 0;
+    atomic_store(&trace_count, 0);
+}
+
+const char *profile_zone_name(profile_zone_e zone) {
+    assert(zone < PROFILE_ZONE_COUNT);
+    return PROFILE_ZONE_NAMES[zone];
+}
+
+size_t profile_zone_depth(profile_zone_e zone) {
+    assert(zone < PROFILE_ZONE_COUNT);
+    return atomic_load_explicit(&zone_depths[zone], memory_order_relaxed);
+}
+
+const char *profile_counter_name(profile_counter_e counter) {
+    assert(counter < PROFILE_COUNTER_COUNT);
+    return PROFILE_COUNTER_NAMES[counter];
+}
+
+size_t profiler_counter_frame(profile_counter_e counter) {
+    assert(counter < PROFILE_COUNTER_COUNT);
+    return atomic_load_explicit(&last_counts[counter], memory_order_relaxed);
+}
+
+size_t profiler_pair_frame(size_t tag1, size_t tag2, profile_counter_e counter) {
+    assert(tag1 < PROFILER_MAX_TAGS && tag2 < PROFILER_MAX_TAGS);
+    assert(counter < PROFILE_COUNTER_COUNT);
+    return tag1 < tag2 ? last_pair_counts[tag1][tag2][counter] : last_pair_counts[tag2][tag1][counter];
+}
+
+size_t profiler_pair_total(size_t tag1, size_t tag2, profile_counter_e counter) {
+    assert(tag1 < PROFILER_MAX_TAGS && tag2 < PROFILER_MAX_TAGS);
+    assert(counter < PROFILE_COUNTER_COUNT);
+    return tag1 < tag2 ? total_pair_counts[tag1][tag2][counter] : total_pair_counts[tag2][tag1][counter];
+}
+
+double profiler_average_ms(profile_zone_e zone) {
+    assert(zone < PROFILE_ZONE_COUNT);
+    return atomic_load_explicit(&average_ns[zone], memory_order_relaxed) / PROFILER_NS_PER_MS;
+}
+
+size_t profiler_frames(void) {
+    return history_frames;
+}
+
+bool profiler_write_csv(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        printf("Unable to write profile: '%s'!\n", path);
+        return false;
+    }
+    fprintf(file, "frame");
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; zone++) {
+        fprintf(file, ",%s_ms", PROFILE_ZONE_NAMES[zone]);
+    }
+    for (size_t counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+        fprintf(file, ",%s", PROFILE_COUNTER_NAMES[counter]);
+    }
+    fprintf(file, "\n");
+
+    // oldest frame first
+    size_t oldest = (history_next + PROFILER_HISTORY_FRAMES - history_frames) % PROFILER_HISTORY_FRAMES;
+    for (size_t i = 0; i < history_frames; i++) {
+        const double *frame = history_ms[(oldest + i) % PROFILER_HISTORY_FRAMES];
+        const size_t *counts = history_counts[(oldest + i) % PROFILER_HISTORY_FRAMES];
+        fprintf(file, "%zu", i);
+        for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; zone++) {
+            fprintf(file, ",%.4f", frame[zone]);
+        }
+        for (size_t counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+            fprintf(file, ",%zu", counts[counter]);
+        }
+        fprintf(file, "\n");
+    }
+    return fclose(file) == 0;
+}
+
+bool profiler_write_pairs_csv(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        printf("Unable to write profile pairs: '%s'!\n", path);
+        return false;
+    }
+    fprintf(file, "tag1,tag2");
+    for (size_t counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+        fprintf(file, ",%s", PROFILE_COUNTER_NAMES[counter]);
+    }
+    fprintf(file, ",peak_pairs_tested\n");
+
+    for (size_t low = 0; low < PROFILER_MAX_TAGS; low++) {
+        for (size_t high = low; high < PROFILER_MAX_TAGS; high++) {
+            const size_t *totals = total_pair_counts[low][high];
+            bool counted = false;
+            for (size_t counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+                counted = counted || totals[counter] > 0;
+            }
+            if (!counted) {
+                continue;
+            }
+            fprintf(file, "%zu,%zu", low, high);
+            for (size_t counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+                fprintf(file, ",%zu", totals[counter]);
+            }
+            fprintf(file, ",%zu\n", peak_pairs_tested[low][high]);
+        }
+    }
+    return fclose(file) == 0;
+}
+
+bool profiler_write_trace(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        printf("Unable to write profile trace: '%s'!\n", path);
+        return false;
+    }
+
+    size_t count = atomic_load(&trace_count);
+    size_t first = count > PROFILER_TRACE_EVENTS ? count - PROFILER_TRACE_EVENTS : 0;
+    // timestamps count from the start of the earliest zone written
+    uint64_t origin_ns = count > 0 ? trace[first % PROFILER_TRACE_EVENTS].start_ns : 0;
+    for (size_t i = first; i < count; i++) {
+        uint64_t start_ns = trace[i % PROFILER_TRACE_EVENTS].start_ns;
+        if (start_ns < origin_ns) {
+            origin_ns = start_ns;
+        }
+    }
+
+    fprintf(file, "{\"traceEvents\": [");
+    for (size_t i = first; i < count; i++) {
+        const trace_event_t *event = &trace[i % PROFILER_TRACE_EVENTS];
+        fprintf(file, "%s\n  {\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %zu, "
+                      "\"ts\": %.3f, \"dur\": %.3f}",
+                i == first ? "" : ",", PROFILE_ZONE_NAMES[event->zone], event->thread,
+                (event->start_ns - origin_ns) / PROFILER_NS_PER_US,
+                event->duration_ns / PROFILER_NS_PER_US);
+    }
+    fprintf(file, "\n], \"displayTimeUnit\": \"ms\"}\n");
+    return fclose(file) == 0;
+}
@@ -0,0 +1,154 @@
+#include "render_frame.h"
+#include "body.h"
+#include "list.h"
+#include "scene.h"
+#include "text_box.h"
+#include "utils.h"
+#include <assert.h>
+#include <stdlib.h>
+
+const size_t INITIAL_FRAME_ITEMS = 64;
+const size_t INITIAL_FRAME_VERTICES = 256;
+const size_t INITIAL_FRAME_TEXTS = 4;
+
+typedef struct render_frame {
+    render_item_t *items;
+    size_t item_count;
+    size_t item_capacity;
+
+    vector_t *vertices;
+    size_t vertex_count;
+    size_t vertex_capacity;
+
+    render_text_t *texts;
+    size_t text_count;
+    size_t text_capacity;
+} render_frame_t;
+
+/** PRIVATE METHOD
+ * Grows an array so that it can hold at least the needed number of elements.
+ *
+ * @param array the array to grow, may be NULL
+ * @param capacity the current capacity, updated to the new capacity
+ * @param needed the number of elements the array has to hold
+ * @param initial the capacity to start from if the array is empty
+ * @param elem_size the size of one element
+ * @return the possibly moved array
+ */
+void *frame_reserve(void *array, size_t *capacity, size_t needed, size_t initial, size_t elem_size) {
+    if (needed <= *capacity) {
+        return array;
+    }
+    size_t new_capacity = *capacity == 0 ? initial : *capacity;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    array = realloc(array, new_capacity * elem_size);
+    assert(array != NULL);
+    *capacity = new_capacity;
+    return array;
+}
+
+render_frame_t *render_frame_init(void) {
+    render_frame_t *frame = malloc(sizeof(render_frame_t));
+    assert(frame != NULL);
+    frame->items = NULL;
+    frame->item_count = 0;
+    frame->item_capacity = 0;
+    frame->vertices = NULL;
+    frame->vertex_count = 0;
+    frame->vertex_capacity = 0;
+    frame->texts = NULL;
+    frame->text_count = 0;
+    frame->text_capacity = 0;
+    return frame;
+}
+
+void render_frame_free(render_frame_t *frame) {
+    free(frame->items);
+    free(frame->vertices);
+    free(frame->texts);
+    free(frame);
+}
+
+void render_frame_capture(render_frame_t *frame, const scene_t *scene) {
+    size_t body_count = scene_bodies(scene);
+    frame->items = frame_reserve(frame->items, &frame->item_capacity, body_count,
+                                 INITIAL_FRAME_ITEMS, sizeof(render_item_t));
+    frame->item_count = body_count;
+    frame->vertex_count = 0;
+
+    // Counting sort by layer: find where each layer starts in the items,
+    // then place every body after the ones before it in its layer.
+    size_t layer_start[RENDER_LAYER_COUNT] = {0};
+    for (size_t i = 0; i < body_count; i++) {
+        render_layer_e layer = body_get_layer(scene_borrow_body(scene, i));
+        if (layer + 1 < RENDER_LAYER_COUNT) {
+            layer_start[layer + 1]++;
+        }
+    }
+    for (size_t layer = 1; layer < RENDER_LAYER_COUNT; layer++) {
+        layer_start[layer] += layer_start[layer - 1];
+    }
+
+    for (size_t i = 0; i < body_count; i++) {
+        const body_t *body = scene_borrow_body(scene, i);
+        render_item_t *item = &frame->items[layer_start[body_get_layer(body)]++];
+        item->render = body_get_render_data(body);
+        item->centroid = body_get_centroid(body);
+        item->angle = body_get_angle(body);
+        item->first_vertex = frame->vertex_count;
+        item->vertex_count = 0;
+
+        if (item->render.type == COLOR) {
+            const list_t *shape = body_borrow_shape(body);
+            size_t n = list_size(shape);
+            frame->vertices = frame_reserve(frame->vertices, &frame->vertex_capacity, frame->vertex_count + n,
+                                            INITIAL_FRAME_VERTICES, sizeof(vector_t));
+            for (size_t j = 0; j < n; j++) {
+                frame->vertices[frame->vertex_count + j] = list_copy_vector(shape, j);
+            }
+            item->vertex_count = n;
+            frame->vertex_count += n;
+        }
+    }
+
+    size_t text_count = scene_text_boxes(scene);
+    frame->texts = frame_reserve(frame->texts, &frame->text_capacity, text_count,
+                                 INITIAL_FRAME_TEXTS, sizeof(render_text_t));
+    for (size_t i = 0; i < text_count; i++) {
+        const text_box_t *text_box = scene_borrow_text_box(scene, i);
+        frame->texts[i] = (render_text_t){
+            .text = text_box_borrow_text(text_box),
+            .font_size = text_box_get_font_size(text_box),
+            .origin = text_box_get_origin(text_box),
+            .justification = text_box_get_justification(text_box)};
+    }
+    frame->text_count = text_count;
+}
+
+size_t render_frame_items(const render_frame_t *frame) {
+    return frame->item_count;
+}
+
+const render_item_t *render_frame_get_item(const render_frame_t *frame, size_t index) {
+    assert(index < frame->item_count);
+    return &frame->items[index];
+}
+
+const vector_t *render_frame_vertices(const render_frame_t *frame) {
+    return frame->vertices;
+}
+
+size_t render_frame_vertex_count(const render_frame_t *frame) {
+    return frame->vertex_count;
+}
+
+size_t render_frame_texts(const render_frame_t *frame) {
+    return frame->text_count;
+}
+
+const render_text_t *render_frame_get_text(const render_frame_t *frame, size_t index) {
+    assert(index < frame->text_count);
+    return &frame->texts[index];
+}
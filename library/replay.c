@@ -0,0 +1,167 @@
+#include "replay.h"
+#include "alloc_track.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const char REPLAY_MAGIC[4] = {'A', 'B', 'R', 'P'};
+const uint32_t REPLAY_VERSION = 1;
+
+// The types of records that follow the header
+typedef enum replay_record {
+    // a uint64_t seed, which starts a game and releases every key
+    REPLAY_GAME,
+    // a uint64_t bitmask of the held keys, written only when it changes
+    REPLAY_KEYS,
+    // a double dt, which ends a tick
+    REPLAY_TICK
+} replay_record_e;
+
+typedef struct replay {
+    // the file being recorded to, or NULL when replaying
+    FILE *file;
+    // the whole file being replayed, and how much of it has been read
+    uint8_t *data;
+    size_t size;
+    size_t position;
+    // the held keys as of the last record written or read
+    uint64_t key_down;
+} replay_t;
+
+replay_t *replay_init(void) {
+    replay_t *replay = TRACKED_MALLOC(ALLOC_OTHER, sizeof(replay_t));
+    assert(replay != NULL);
+    replay->file = NULL;
+    replay->data = NULL;
+    replay->size = 0;
+    replay->position = 0;
+    replay->key_down = 0;
+    return replay;
+}
+
+replay_t *replay_record(const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        printf("Unable to record to: '%s'!\n", path);
+        return NULL;
+    }
+    fwrite(REPLAY_MAGIC, sizeof(REPLAY_MAGIC), 1, file);
+    fwrite(&REPLAY_VERSION, sizeof(REPLAY_VERSION), 1, file);
+    replay_t *replay = replay_init();
+    replay->file = file;
+    return replay;
+}
+
+replay_t *replay_load(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        printf("Unable to load replay: '%s'!\n", path);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    replay_t *replay = replay_init();
+    replay->size = size > 0 ? size : 0;
+    replay->data = TRACKED_MALLOC(ALLOC_OTHER, replay->size + 1);
+    assert(replay->data != NULL);
+    size_t read = fread(replay->data, 1, replay->size, file);
+    fclose(file);
+
+    uint32_t version = 0;
+    size_t header_size = sizeof(REPLAY_MAGIC) + sizeof(version);
+    if (read == replay->size && replay->size >= header_size) {
+        memcpy(&version, replay->data + sizeof(REPLAY_MAGIC), sizeof(version));
+    }
+    if (read != replay->size || replay->size < header_size ||
+        memcmp(replay->data, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 ||
+        version != REPLAY_VERSION) {
+        printf("Not a replay of version %u: '%s'!\n", REPLAY_VERSION, path);
+        replay_free(replay);
+        return NULL;
+    }
+    replay->position = header_size;
+    return replay;
+}
+
+bool replay_free(replay_t *replay) {
+    bool written = true;
+    if (replay->file != NULL) {
+        written = !ferror(replay->file);
+        written = fclose(replay->file) == 0 && written;
+    }
+    TRACKED_FREE(ALLOC_OTHER, replay->data);
+    TRACKED_FREE(ALLOC_OTHER, replay);
+    return written;
+}
+
+/** Appends a record of a type and an 8-byte value to a recording */
+void replay_write(replay_t *replay, replay_record_e type, const void *value) {
+    assert(replay->file != NULL);
+    uint8_t byte = type;
+    fwrite(&byte, sizeof(byte), 1, replay->file);
+    fwrite(value, sizeof(uint64_t), 1, replay->file);
+}
+
+void replay_record_game(replay_t *replay, uint64_t seed) {
+    replay_write(replay, REPLAY_GAME, &seed);
+    replay->key_down = 0;
+}
+
+void replay_record_tick(replay_t *replay, size_t key_down, double dt) {
+    if (key_down != replay->key_down) {
+        replay->key_down = key_down;
+        replay_write(replay, REPLAY_KEYS, &replay->key_down);
+    }
+    replay_write(replay, REPLAY_TICK, &dt);
+}
+
+/**
+ * Gets the type of the next record of a replay, without reading it.
+ * Returns false at the end of the file.
+ */
+bool replay_peek(const replay_t *replay, replay_record_e *type) {
+    assert(replay->data != NULL);
+    if (replay->position == replay->size) {
+        return false;
+    }
+    // every record is a type byte followed by 8 bytes
+    assert(replay->size - replay->position >= 1 + sizeof(uint64_t));
+    *type = replay->data[replay->position];
+    assert(*type <= REPLAY_TICK);
+    return true;
+}
+
+/** Reads the value of the next record of a replay */
+void replay_read(replay_t *replay, void *value) {
+    memcpy(value, replay->data + replay->position + 1, sizeof(uint64_t));
+    replay->position += 1 + sizeof(uint64_t);
+}
+
+bool replay_next_game(replay_t *replay, uint64_t *seed) {
+    replay_record_e type;
+    while (replay_peek(replay, &type)) {
+        if (type == REPLAY_GAME) {
+            replay_read(replay, seed);
+            replay->key_down = 0;
+            return true;
+        }
+        replay->position += 1 + sizeof(uint64_t);
+    }
+    return false;
+}
+
+bool replay_next_tick(replay_t *replay, size_t *key_down, double *dt) {
+    replay_record_e type;
+    while (replay_peek(replay, &type) && type != REPLAY_GAME) {
+        if (type == REPLAY_KEYS) {
+            replay_read(replay, &replay->key_down);
+            continue;
+        }
+        replay_read(replay, dt);
+        *key_down = replay->key_down;
+        return true;
+    }
+    return false;
+}
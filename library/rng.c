@@ -0,0 +1,64 @@
+#include "rng.h"
+#include <assert.h>
+#include <stddef.h>
+
+// Added to the splitmix64 state on every step (2^64 / golden ratio)
+const uint64_t SPLITMIX_INCREMENT = 0x9E3779B97F4A7C15;
+// A double has 53 bits of mantissa, so the top 53 bits of a number are kept
+const double RNG_DOUBLE_UNIT = 1.0 / (UINT64_C(1) << 53);
+
+uint64_t splitmix64_next(uint64_t *x) {
+    uint64_t z = (*x += SPLITMIX_INCREMENT);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+rng_t rng_init(uint64_t seed, uint64_t stream) {
+    // mixing the stream with a hash of the seed keeps (seed, stream) pairs
+    // apart even when the seeds or streams are consecutive
+    uint64_t mix = seed;
+    uint64_t x = splitmix64_next(&mix) ^ (stream * SPLITMIX_INCREMENT);
+    rng_t rng;
+    for (size_t i = 0; i < 4; i++) {
+        rng.state[i] = splitmix64_next(&x);
+    }
+    return rng;
+}
+
+uint64_t rng_next(rng_t *rng) {
+    uint64_t *s = rng->state;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+double rng_double(rng_t *rng) {
+    return (rng_next(rng) >> 11) * RNG_DOUBLE_UNIT;
+}
+
+double rng_range(rng_t *rng, double min, double max) {
+    assert(max > min);
+    return rng_double(rng) * (max - min) + min;
+}
+
+int rng_int_range(rng_t *rng, int min, int max) {
+    assert(max >= min);
+    uint64_t count = (uint64_t)((int64_t)max - min) + 1;
+    return (int)(min + (int64_t)(rng_next(rng) % count));
+}
+
+vector_t rng_vec(rng_t *rng, vector_t min, vector_t max) {
+    return vec(rng_range(rng, min.x, max.x),
+               rng_range(rng, min.y, max.y));
+}
@@ -2,12 +2,21 @@
 #include "body.h"
 #include "text_box.h"
 #include "scene.h"
+#include "profiler.h"
+#include "alloc_track.h"
 #include <assert.h>
+#include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 const size_t INITIAL_BODY_LIST_SIZE = 10;
 const size_t INITIAL_FORCE_CREATOR_LIST_SIZE = 2;
 const size_t INITIAL_TEXT_BOXES_LIST_SIZE = 1;
+const size_t INITIAL_PAIR_FORCE_CREATOR_LIST_SIZE = 4;
+const size_t INITIAL_TAG_FORCE_CREATOR_LIST_SIZE = 2;
+const size_t INITIAL_TAG_BUCKET_SIZE = 8;
+const size_t INITIAL_CONTACT_CAPACITY = 16;
+const size_t INITIAL_COMMAND_CAPACITY = 16;
 
 typedef struct force_creator_bundle {
     force_creator_t forcer;
@@ -16,10 +25,86 @@ typedef struct force_creator_bundle {
     free_func_t freer;
 } force_creator_bundle_t;
 
+typedef struct pair_force_creator_bundle {
+    size_t tag1;
+    size_t tag2;
+    pair_force_creator_t forcer;
+    void *aux;
+    free_func_t freer;
+} pair_force_creator_bundle_t;
+
+typedef struct tag_force_creator_bundle {
+    size_t tag;
+    tag_force_creator_t forcer;
+    void *aux;
+    free_func_t freer;
+} tag_force_creator_bundle_t;
+
+/**
+ * The bodies with one tag, kept up to date as bodies are added and reaped.
+ * Bodies marked for removal stay in it until the end of the tick.
+ */
+typedef struct tag_bucket {
+    body_t **bodies;
+    size_t size;
+    size_t capacity;
+} tag_bucket_t;
+
+/**
+ * A contact found while the force creators run, handled after they all have.
+ */
+typedef struct contact {
+    body_t *body1;
+    body_t *body2;
+    vector_t axis;
+    contact_handler_t handler;
+    void *aux;
+    // whether the handler runs even once either body is removed
+    bool handle_removed;
+} contact_t;
+
+/**
+ * A change to the scene queued by a contact handler, run once every
+ * contact of the tick has been handled.
+ */
+typedef struct command {
+    scene_command_t run;
+    void *aux;
+    // a copy of the args it was queued with
+    union {
+        max_align_t align;
+        unsigned char bytes[SCENE_COMMAND_ARGS_SIZE];
+    } args;
+} command_t;
+
 typedef struct scene {
     list_t *bodies;
     list_t *force_creators;
+    list_t *pair_force_creators;
+    list_t *tag_force_creators;
     list_t *text_boxes;
+    scheduler_t *scheduler;
+    // indexed by tag, for tags up to the largest one seen so far
+    tag_bucket_t *tag_buckets;
+    size_t tag_bucket_count;
+    // the contacts not handled yet, in the order they were found; the array
+    // is kept between ticks so queueing doesn't allocate once it is big enough
+    contact_t *contacts;
+    size_t contact_count;
+    size_t contact_capacity;
+    // the commands not run yet, in the order they were queued, kept
+    // between ticks like the contacts
+    command_t *commands;
+    size_t command_count;
+    size_t command_capacity;
+    // cullable bodies that leave this box are removed
+    bool has_kill_box;
+    vector_t kill_box_min;
+    vector_t kill_box_max;
+    // wrapping bodies that leave this box come back on the other side
+    bool has_wrap_box;
+    vector_t wrap_box_min;
+    vector_t wrap_box_max;
 } scene_t;
 
 void force_creator_bundle_free(force_creator_bundle_t *bundle) {
@@ -29,23 +114,59 @@ void force_creator_bundle_free(force_creator_bundle_t *bundle) {
     if (bundle->bodies != NULL) {
         list_free(bundle->bodies);
     }
-    free(bundle);
+    TRACKED_FREE(ALLOC_BUNDLE, bundle);
+}
+
+void pair_force_creator_bundle_free(pair_force_creator_bundle_t *bundle) {
+    if (bundle->freer != NULL && bundle->aux != NULL) {
+        bundle->freer(bundle->aux);
+    }
+    TRACKED_FREE(ALLOC_BUNDLE, bundle);
+}
+
+void tag_force_creator_bundle_free(tag_force_creator_bundle_t *bundle) {
+    if (bundle->freer != NULL && bundle->aux != NULL) {
+        bundle->freer(bundle->aux);
+    }
+    TRACKED_FREE(ALLOC_BUNDLE, bundle);
 }
 
 scene_t *scene_init() {
-    scene_t *scene = malloc(sizeof(scene_t));
+    scene_t *scene = TRACKED_MALLOC(ALLOC_OTHER, sizeof(scene_t));
     assert(scene != NULL);
-    scene->bodies = list_init(INITIAL_BODY_LIST_SIZE, (free_func_t)body_free);
+    scene->bodies = list_init(INITIAL_BODY_LIST_SIZE, (free_func_t)body_release);
     scene->force_creators = list_init(INITIAL_FORCE_CREATOR_LIST_SIZE, (free_func_t)force_creator_bundle_free);
+    scene->pair_force_creators = list_init(INITIAL_PAIR_FORCE_CREATOR_LIST_SIZE, (free_func_t)pair_force_creator_bundle_free);
+    scene->tag_force_creators = list_init(INITIAL_TAG_FORCE_CREATOR_LIST_SIZE, (free_func_t)tag_force_creator_bundle_free);
     scene->text_boxes = list_init(INITIAL_TEXT_BOXES_LIST_SIZE, (free_func_t)text_box_free);
+    scene->scheduler = scheduler_init();
+    scene->tag_buckets = NULL;
+    scene->tag_bucket_count = 0;
+    scene->contacts = NULL;
+    scene->contact_count = 0;
+    scene->contact_capacity = 0;
+    scene->commands = NULL;
+    scene->command_count = 0;
+    scene->command_capacity = 0;
+    scene->has_kill_box = false;
+    scene->has_wrap_box = false;
     return scene;
 }
 
 void scene_free(scene_t *scene) {
     list_free(scene->bodies);
     list_free(scene->force_creators);
+    list_free(scene->pair_force_creators);
+    list_free(scene->tag_force_creators);
     list_free(scene->text_boxes);
-    free(scene);
+    scheduler_free(scene->scheduler);
+    for (size_t i = 0; i < scene->tag_bucket_count; i++) {
+        TRACKED_FREE(ALLOC_OTHER, scene->tag_buckets[i].bodies);
+    }
+    TRACKED_FREE(ALLOC_OTHER, scene->tag_buckets);
+    TRACKED_FREE(ALLOC_OTHER, scene->contacts);
+    TRACKED_FREE(ALLOC_OTHER, scene->commands);
+    TRACKED_FREE(ALLOC_OTHER, scene);
 }
 
 size_t scene_bodies(const scene_t *scene) {
@@ -72,8 +193,167 @@ const text_box_t *scene_borrow_text_box(const scene_t *scene, size_t index) {
     return list_borrow(scene->text_boxes, index);
 }
 
+void scene_set_kill_box(scene_t *scene, vector_t min, vector_t max) {
+    assert(min.x <= max.x && min.y <= max.y);
+    scene->has_kill_box = true;
+    scene->kill_box_min = min;
+    scene->kill_box_max = max;
+}
+
+bool scene_get_kill_box(const scene_t *scene, vector_t *min, vector_t *max) {
+    if (scene->has_kill_box) {
+        *min = scene->kill_box_min;
+        *max = scene->kill_box_max;
+    }
+    return scene->has_kill_box;
+}
+
+/** Whether a body's bounding circle is entirely outside the kill box */
+bool scene_outside_kill_box(const scene_t *scene, const body_t *body) {
+    vector_t centroid = body_get_centroid(body);
+    double radius = body_get_bounding_radius(body);
+    return centroid.x + radius < scene->kill_box_min.x
+        || centroid.x - radius > scene->kill_box_max.x
+        || centroid.y + radius < scene->kill_box_min.y
+        || centroid.y - radius > scene->kill_box_max.y;
+}
+
+void scene_set_wrap_box(scene_t *scene, vector_t min, vector_t max) {
+    assert(min.x < max.x && min.y < max.y);
+    scene->has_wrap_box = true;
+    scene->wrap_box_min = min;
+    scene->wrap_box_max = max;
+}
+
+bool scene_get_wrap_box(const scene_t *scene, vector_t *min, vector_t *max) {
+    if (scene->has_wrap_box) {
+        *min = scene->wrap_box_min;
+        *max = scene->wrap_box_max;
+    }
+    return scene->has_wrap_box;
+}
+
+/** Moves a body that has left the wrap box to the opposite side of it */
+void scene_wrap_body(const scene_t *scene, body_t *body) {
+    vector_t centroid = body_get_centroid(body);
+    double radius = body_get_bounding_radius(body);
+    vector_t min = scene->wrap_box_min, max = scene->wrap_box_max;
+    vector_t shift = VEC_ZERO;
+    if (centroid.x + radius < min.x) {
+        shift.x = max.x - min.x;
+    } else if (centroid.x - radius > max.x) {
+        shift.x = min.x - max.x;
+    }
+    if (centroid.y + radius < min.y) {
+        shift.y = max.y - min.y;
+    } else if (centroid.y - radius > max.y) {
+        shift.y = min.y - max.y;
+    }
+    // only rewrite the vertices on the tick the body actually wraps
+    if (shift.x != 0 || shift.y != 0) {
+        body_translate(body, shift);
+    }
+}
+
+void scene_schedule(
+    scene_t *scene,
+    double delay,
+    timer_callback_t callback,
+    void *aux,
+    free_func_t freer
+) {
+    scheduler_add(scene->scheduler, delay, callback, aux, freer);
+}
+
+/** Makes sure every tag below needed has a bucket */
+void scene_reserve_tag_buckets(scene_t *scene, size_t needed) {
+    if (needed > scene->tag_bucket_count) {
+        scene->tag_buckets = TRACKED_REALLOC(ALLOC_OTHER, scene->tag_buckets, needed * sizeof(tag_bucket_t));
+        assert(scene->tag_buckets != NULL);
+        for (size_t i = scene->tag_bucket_count; i < needed; i++) {
+            scene->tag_buckets[i] = (tag_bucket_t){.bodies = NULL, .size = 0, .capacity = 0};
+        }
+        scene->tag_bucket_count = needed;
+    }
+}
+
+/** Grows a tag's bucket to hold at least capacity bodies */
+void tag_bucket_reserve(tag_bucket_t *bucket, size_t capacity) {
+    if (capacity > bucket->capacity) {
+        bucket->bodies = TRACKED_REALLOC(ALLOC_OTHER, bucket->bodies, capacity * sizeof(body_t *));
+        assert(bucket->bodies != NULL);
+        bucket->capacity = capacity;
+    }
+}
+
+/** Grows the contact queue to hold at least capacity contacts */
+void scene_reserve_contacts(scene_t *scene, size_t capacity) {
+    if (capacity > scene->contact_capacity) {
+        scene->contacts = TRACKED_REALLOC(ALLOC_OTHER, scene->contacts, capacity * sizeof(contact_t));
+        assert(scene->contacts != NULL);
+        scene->contact_capacity = capacity;
+    }
+}
+
+/** Grows the command queue to hold at least capacity commands */
+void scene_reserve_commands(scene_t *scene, size_t capacity) {
+    if (capacity > scene->command_capacity) {
+        scene->commands = TRACKED_REALLOC(ALLOC_OTHER, scene->commands, capacity * sizeof(command_t));
+        assert(scene->commands != NULL);
+        scene->command_capacity = capacity;
+    }
+}
+
+void scene_reserve(scene_t *scene, size_t bodies, size_t contacts) {
+    list_reserve(scene->bodies, bodies);
+    scene_reserve_contacts(scene, contacts);
+    scene_reserve_commands(scene, contacts);
+}
+
+void scene_reserve_tag(scene_t *scene, size_t tag, size_t bodies) {
+    assert(tag != BODY_TAG_NONE);
+    scene_reserve_tag_buckets(scene, tag + 1);
+    tag_bucket_reserve(&scene->tag_buckets[tag], bodies);
+}
+
 void scene_add_body(scene_t *scene, body_t *body) {
     list_add(scene->bodies, body);
+    size_t tag = body_get_tag(body);
+    if (tag == BODY_TAG_NONE) {
+        return;
+    }
+    scene_reserve_tag_buckets(scene, tag + 1);
+    tag_bucket_t *bucket = &scene->tag_buckets[tag];
+    if (bucket->size == bucket->capacity) {
+        tag_bucket_reserve(bucket, bucket->capacity == 0 ? INITIAL_TAG_BUCKET_SIZE : 2 * bucket->capacity);
+    }
+    bucket->bodies[bucket->size++] = body;
+}
+
+/** Takes a body that is being reaped out of its tag's bucket */
+void scene_unindex_body(scene_t *scene, body_t *body) {
+    size_t tag = body_get_tag(body);
+    if (tag == BODY_TAG_NONE) {
+        return;
+    }
+    tag_bucket_t *bucket = &scene->tag_buckets[tag];
+    // recently added bodies are the likeliest to be removed, so search from the back
+    for (size_t i = bucket->size; i-- > 0;) {
+        if (bucket->bodies[i] == body) {
+            bucket->bodies[i] = bucket->bodies[--bucket->size];
+            return;
+        }
+    }
+    assert(false && "tagged body missing from its bucket");
+}
+
+size_t scene_tagged_bodies(const scene_t *scene, size_t tag) {
+    return tag < scene->tag_bucket_count ? scene->tag_buckets[tag].size : 0;
+}
+
+body_t *scene_get_tagged_body(scene_t *scene, size_t tag, size_t index) {
+    assert(index < scene_tagged_bodies(scene, tag));
+    return scene->tag_buckets[tag].bodies[index];
 }
 
 void scene_add_text_box(scene_t *scene, text_box_t *text_box) {
@@ -89,7 +369,7 @@ void scene_remove_text_box(scene_t *scene, size_t index) {
 }
 
 force_creator_bundle_t *force_creator_bundle_init(force_creator_t forcer, void *aux, free_func_t freer, list_t *bodies) {
-    force_creator_bundle_t *bundle = malloc(sizeof(force_creator_bundle_t));
+    force_creator_bundle_t *bundle = TRACKED_MALLOC(ALLOC_BUNDLE, sizeof(force_creator_bundle_t));
     bundle->forcer = forcer;
     bundle->aux = aux;
     bundle->freer = freer;
@@ -107,40 +387,235 @@ void scene_add_bodies_force_creator(
     list_add(scene->force_creators, force_creator_bundle_init(forcer, aux, freer, bodies));
 }
 
+void scene_add_pair_force_creator(
+    scene_t *scene,
+    size_t tag1,
+    size_t tag2,
+    pair_force_creator_t forcer,
+    void *aux,
+    free_func_t freer
+) {
+    assert(tag1 != BODY_TAG_NONE);
+    assert(tag2 != BODY_TAG_NONE);
+    pair_force_creator_bundle_t *bundle = TRACKED_MALLOC(ALLOC_BUNDLE, sizeof(pair_force_creator_bundle_t));
+    assert(bundle != NULL);
+    bundle->tag1 = tag1;
+    bundle->tag2 = tag2;
+    bundle->forcer = forcer;
+    bundle->aux = aux;
+    bundle->freer = freer;
+    list_add(scene->pair_force_creators, bundle);
+
+    scene_reserve_tag_buckets(scene, (tag1 > tag2 ? tag1 : tag2) + 1);
+}
+
+void scene_add_tag_force_creator(
+    scene_t *scene,
+    size_t tag,
+    tag_force_creator_t forcer,
+    void *aux,
+    free_func_t freer
+) {
+    assert(tag != BODY_TAG_NONE);
+    tag_force_creator_bundle_t *bundle = TRACKED_MALLOC(ALLOC_BUNDLE, sizeof(tag_force_creator_bundle_t));
+    assert(bundle != NULL);
+    bundle->tag = tag;
+    bundle->forcer = forcer;
+    bundle->aux = aux;
+    bundle->freer = freer;
+    list_add(scene->tag_force_creators, bundle);
+    scene_reserve_tag_buckets(scene, tag + 1);
+}
+
+void scene_add_contact(
+    scene_t *scene,
+    body_t *body1,
+    body_t *body2,
+    vector_t axis,
+    contact_handler_t handler,
+    void *aux,
+    bool handle_removed
+) {
+    if (scene->contact_count == scene->contact_capacity) {
+        scene_reserve_contacts(scene, scene->contact_capacity == 0 ? INITIAL_CONTACT_CAPACITY : 2 * scene->contact_capacity);
+    }
+    scene->contacts[scene->contact_count++] = (contact_t){
+        .body1 = body1,
+        .body2 = body2,
+        .axis = axis,
+        .handler = handler,
+        .aux = aux,
+        .handle_removed = handle_removed};
+}
+
+size_t scene_contacts(const scene_t *scene) {
+    return scene->contact_count;
+}
+
+/**
+ * Calls the handler of every queued contact, in the order they were found,
+ * skipping contacts whose bodies an earlier handler removed.
+ * Nothing but the contacts is being iterated, so handlers can add bodies
+ * and force creators. A handler may queue another contact, which can move
+ * the array, so each contact is copied out before it is handled.
+ */
+void scene_handle_contacts(scene_t *scene) {
+    for (size_t i = 0; i < scene->contact_count; i++) {
+        contact_t contact = scene->contacts[i];
+        if (!contact.handle_removed && (body_is_removed(contact.body1) || body_is_removed(contact.body2))) {
+            continue;
+        }
+        PROFILE_PAIR_BEGIN(body_get_tag(contact.body1), body_get_tag(contact.body2));
+        PROFILE_COUNT(COUNTER_HANDLERS_FIRED);
+        contact.handler(contact.body1, contact.body2, contact.axis, contact.aux);
+        PROFILE_PAIR_END();
+    }
+    scene->contact_count = 0;
+}
+
+void scene_defer(scene_t *scene, scene_command_t run, void *aux, const void *args, size_t args_size) {
+    assert(args_size <= SCENE_COMMAND_ARGS_SIZE);
+    if (scene->command_count == scene->command_capacity) {
+        scene_reserve_commands(scene, scene->command_capacity == 0 ? INITIAL_COMMAND_CAPACITY : 2 * scene->command_capacity);
+    }
+    command_t *command = &scene->commands[scene->command_count++];
+    command->run = run;
+    command->aux = aux;
+    if (args_size > 0) {
+        memcpy(command->args.bytes, args, args_size);
+    }
+}
+
+size_t scene_commands(const scene_t *scene) {
+    return scene->command_count;
+}
+
+/**
+ * Runs every queued command in the order they were queued, including the
+ * ones queued by commands of this batch. Like a handler, a command may
+ * queue another, which can move the array, so each one is copied out first.
+ */
+void scene_run_commands(scene_t *scene) {
+    for (size_t i = 0; i < scene->command_count; i++) {
+        command_t command = scene->commands[i];
+        command.run(command.aux, command.args.bytes);
+    }
+    scene->command_count = 0;
+}
+
+/**
+ * Calls a pair force creator on every matching pair of live bodies.
+ * The buckets are looked up on every access because the forcer may add
+ * bodies or a pair creator, which can move the bucket arrays.
+ * Bodies are only appended to buckets until the end of the tick, so the
+ * bodies present when the run starts keep their place.
+ */
+void pair_force_creator_run(scene_t *scene, pair_force_creator_bundle_t *bundle) {
+    size_t tag1 = bundle->tag1, tag2 = bundle->tag2;
+    bool same_tag = tag1 == tag2;
+    size_t size1 = scene->tag_buckets[tag1].size, size2 = scene->tag_buckets[tag2].size;
+    PROFILE_PAIR_BEGIN(tag1, tag2);
+    for (size_t i = 0; i < size1; i++) {
+        body_t *body1 = scene->tag_buckets[tag1].bodies[i];
+        // only visit each unordered pair once when both sides share a bucket
+        for (size_t j = same_tag ? i + 1 : 0; j < size2; j++) {
+            if (body_is_removed(body1)) {
+                break;
+            }
+            body_t *body2 = scene->tag_buckets[tag2].bodies[j];
+            if (!body_is_removed(body2)) {
+                PROFILE_COUNT(COUNTER_PAIRS_TESTED);
+                bundle->forcer(body1, body2, bundle->aux);
+            }
+        }
+    }
+    PROFILE_PAIR_END();
+}
+
 void scene_tick(scene_t *scene, double dt) {
+    PROFILE_BEGIN(ZONE_SCENE_TICK);
+    PROFILE_BEGIN(ZONE_TIMERS);
+    scheduler_advance(scene->scheduler, dt);
+    PROFILE_END(ZONE_TIMERS);
+
     // If the force management is automatically done, then set the acceleration
     // to zero if there is no force creation.
+    PROFILE_BEGIN(ZONE_CULL);
     for (size_t i = 0; i < scene_bodies(scene); i++) {
         body_t *body = scene_get_body(scene, i);
         if (!body_get_manual_acceleration(body)) {
             body_set_acceleration(body, VEC_ZERO);
         }
+        if (scene->has_kill_box && body_is_cullable(body) && scene_outside_kill_box(scene, body)) {
+            body_remove(body);
+        }
     }
+    PROFILE_END(ZONE_CULL);
+    PROFILE_BEGIN(ZONE_FORCE_CREATORS);
     for (size_t i = 0; i < list_size(scene->force_creators); i++) {
         force_creator_bundle_t* bundle = list_get(scene->force_creators, i);
         bundle->forcer(bundle->aux);
     }
+    PROFILE_END(ZONE_FORCE_CREATORS);
+    PROFILE_BEGIN(ZONE_TAG_FORCES);
+    for (size_t i = 0; i < list_size(scene->tag_force_creators); i++) {
+        tag_force_creator_bundle_t *bundle = list_get(scene->tag_force_creators, i);
+        tag_bucket_t *bucket = &scene->tag_buckets[bundle->tag];
+        bundle->forcer(bucket->bodies, bucket->size, bundle->aux);
+    }
+    PROFILE_END(ZONE_TAG_FORCES);
+    PROFILE_BEGIN(ZONE_PAIR_FORCES);
+    for (size_t i = 0; i < list_size(scene->pair_force_creators); i++) {
+        pair_force_creator_run(scene, list_get(scene->pair_force_creators, i));
+    }
+    PROFILE_END(ZONE_PAIR_FORCES);
+    // every contact is found before any is handled, so the handlers see
+    // the same bodies whichever order the force creators ran in
+    PROFILE_BEGIN(ZONE_COLLISION_HANDLERS);
+    scene_handle_contacts(scene);
+    PROFILE_END(ZONE_COLLISION_HANDLERS);
+    // what the handlers spawned and wired, once they have all seen
+    // the same bodies
+    PROFILE_BEGIN(ZONE_COMMANDS);
+    scene_run_commands(scene);
+    PROFILE_END(ZONE_COMMANDS);
 
-    for (size_t i = 0; i < scene_bodies(scene); i++) {
+    // deferred body removal, before ticking so the two can be timed apart
+    PROFILE_BEGIN(ZONE_REMOVAL);
+    for (size_t i = 0; i < scene_bodies(scene);) {
         body_t *body = scene_get_body(scene, i);
+        if (!body_is_removed(body)) {
+            i++;
+            continue;
+        }
+        // bodies are drawn by layer, so the order of the list doesn't
+        // matter and the last body can take the removed one's place
+        list_swap_remove(scene->bodies, i);
+        scene_unindex_body(scene, body);
 
-        // deferred body removal
-        if (body_is_removed(body)) {
-            body_free(list_remove(scene->bodies, i));
-
-            // free the force bundle if it contains the removed body
-            for (size_t i = 0; i < list_size(scene->force_creators); i++) {
-                force_creator_bundle_t* bundle = list_get(scene->force_creators, i);
-                if (bundle->bodies != NULL) {
-                    if (list_contains(bundle->bodies, body)) {
-                        force_creator_bundle_free(bundle);
-                        list_remove(scene->force_creators, i);
-                        i--;
-                    }
+        // free the force bundle if it contains the removed body
+        for (size_t j = 0; j < list_size(scene->force_creators); j++) {
+            force_creator_bundle_t* bundle = list_get(scene->force_creators, j);
+            if (bundle->bodies != NULL) {
+                if (list_contains(bundle->bodies, body)) {
+                    force_creator_bundle_free(bundle);
+                    list_remove(scene->force_creators, j);
+                    j--;
                 }
             }
-        } else {
-            body_tick(body, dt);
+        }
+        body_release(body);
+    }
+    PROFILE_END(ZONE_REMOVAL);
+
+    PROFILE_BEGIN(ZONE_BODY_TICK);
+    for (size_t i = 0; i < scene_bodies(scene); i++) {
+        body_t *body = scene_get_body(scene, i);
+        body_tick(body, dt);
+        if (scene->has_wrap_box && body_is_wrapping(body)) {
+            scene_wrap_body(scene, body);
         }
     }
+    PROFILE_END(ZONE_BODY_TICK);
+    PROFILE_END(ZONE_SCENE_TICK);
 }
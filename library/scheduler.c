@@ -0,0 +1,139 @@
+#include "scheduler.h"
+#include "alloc_track.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+const size_t INITIAL_TIMER_HEAP_SIZE = 32;
+
+typedef struct timer_entry {
+    double due;
+    // breaks ties between timers that are due at the same time
+    size_t sequence;
+    timer_callback_t callback;
+    void *aux;
+    free_func_t freer;
+} timer_entry_t;
+
+typedef struct scheduler {
+    double now;
+    size_t next_sequence;
+    // a binary min-heap: the parent of index i is at (i - 1) / 2
+    timer_entry_t *heap;
+    size_t size;
+    size_t capacity;
+} scheduler_t;
+
+scheduler_t *scheduler_init(void) {
+    scheduler_t *scheduler = TRACKED_MALLOC(ALLOC_OTHER, sizeof(scheduler_t));
+    assert(scheduler != NULL);
+    scheduler->now = 0;
+    scheduler->next_sequence = 0;
+    scheduler->heap = TRACKED_MALLOC(ALLOC_OTHER, INITIAL_TIMER_HEAP_SIZE * sizeof(timer_entry_t));
+    assert(scheduler->heap != NULL);
+    scheduler->size = 0;
+    scheduler->capacity = INITIAL_TIMER_HEAP_SIZE;
+    return scheduler;
+}
+
+void timer_stop(timer_entry_t *timer) {
+    if (timer->freer != NULL && timer->aux != NULL) {
+        timer->freer(timer->aux);
+    }
+}
+
+void scheduler_free(scheduler_t *scheduler) {
+    for (size_t i = 0; i < scheduler->size; i++) {
+        timer_stop(&scheduler->heap[i]);
+    }
+    TRACKED_FREE(ALLOC_OTHER, scheduler->heap);
+    TRACKED_FREE(ALLOC_OTHER, scheduler);
+}
+
+bool timer_before(const timer_entry_t *a, const timer_entry_t *b) {
+    return a->due < b->due || (a->due == b->due && a->sequence < b->sequence);
+}
+
+void scheduler_push(scheduler_t *scheduler, timer_entry_t timer) {
+    if (scheduler->size == scheduler->capacity) {
+        scheduler->capacity *= 2;
+        scheduler->heap = TRACKED_REALLOC(ALLOC_OTHER, scheduler->heap, scheduler->capacity * sizeof(timer_entry_t));
+        assert(scheduler->heap != NULL);
+    }
+    timer.sequence = scheduler->next_sequence++;
+
+    // sift up
+    timer_entry_t *heap = scheduler->heap;
+    size_t i = scheduler->size++;
+    while (i > 0 && timer_before(&timer, &heap[(i - 1) / 2])) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = timer;
+}
+
+timer_entry_t scheduler_pop(scheduler_t *scheduler) {
+    timer_entry_t *heap = scheduler->heap;
+    timer_entry_t first = heap[0];
+    timer_entry_t last = heap[--scheduler->size];
+
+    // sift the last timer down from the root
+    size_t i = 0;
+    while (true) {
+        size_t child = 2 * i + 1;
+        if (child >= scheduler->size) {
+            break;
+        }
+        if (child + 1 < scheduler->size && timer_before(&heap[child + 1], &heap[child])) {
+            child++;
+        }
+        if (!timer_before(&heap[child], &last)) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = last;
+    return first;
+}
+
+void scheduler_add(
+    scheduler_t *scheduler,
+    double delay,
+    timer_callback_t callback,
+    void *aux,
+    free_func_t freer
+) {
+    assert(delay >= 0);
+    timer_entry_t timer = {
+        .due = scheduler->now + delay,
+        .callback = callback,
+        .aux = aux,
+        .freer = freer,
+    };
+    scheduler_push(scheduler, timer);
+}
+
+void scheduler_advance(scheduler_t *scheduler, double dt) {
+    scheduler->now += dt;
+    while (scheduler->size > 0 && scheduler->heap[0].due <= scheduler->now) {
+        timer_entry_t timer = scheduler_pop(scheduler);
+        double delay = timer.callback(timer.aux);
+        if (delay < 0) {
+            timer_stop(&timer);
+        } else {
+            // a repeating timer must move forward, or it would fire forever
+            assert(delay > 0);
+            timer.due += delay;
+            scheduler_push(scheduler, timer);
+        }
+    }
+}
+
+size_t scheduler_timers(const scheduler_t *scheduler) {
+    return scheduler->size;
+}
+
+double scheduler_time(const scheduler_t *scheduler) {
+    return scheduler->now;
+}
@@ -1,4 +1,8 @@
 #include "sdl_wrapper.h"
+#include "atlas.h"
+#include "frame_clock.h"
+#include "profiler.h"
+#include "render_frame.h"
 #include "text_box.h"
 #include "utils.h"
 #include <SDL2/SDL.h>
@@ -8,14 +12,34 @@
 #include <SDL2/SDL_ttf.h>
 #include <assert.h>
 #include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
 
 const char WINDOW_TITLE[] = "Aster Blaster";
 const int WINDOW_WIDTH = 1200;
 const int WINDOW_HEIGHT = 800;
 const double MS_PER_S = 1e3;
 const char *FONT_PATH;
+// Gap left between images in an atlas so filtering doesn't bleed across them
+const int ATLAS_PADDING = 1;
+// Side length of the white block reserved at the atlas origin
+const int ATLAS_WHITE_SIZE = 2;
+const size_t INITIAL_BATCH_VERTICES = 256;
+// Game time that passes between two headless frames, in seconds
+const double HEADLESS_TICK = 1.0 / 60;
+// Number of headless frames between switching the held arrow key
+const size_t HEADLESS_STEER_FRAMES = 90;
+// How long the event loop waits for a new frame before polling again, in ms
+const Uint32 EVENT_POLL_MS = 5;
+// Key and mouse events the event loop can hold until the game reads them
+#define INPUT_QUEUE_CAPACITY 256
+#ifdef PROFILER
+// The profiler overlay is drawn in the top left corner, one zone or counter per line
+const size_t PROFILER_OVERLAY_FONT_SIZE = 14;
+const int PROFILER_OVERLAY_LINE_HEIGHT = 16;
+const int PROFILER_OVERLAY_MARGIN = 10;
+#endif
 
 /**
  * The coordinate at the center of the screen.
@@ -26,9 +50,13 @@ vector_t center;
  */
 vector_t max_diff;
 /**
- * The SDL window where the scene is rendered.
+ * The SDL window where the scene is rendered, or NULL if running headless.
  */
-SDL_Window *window;
+SDL_Window *window = NULL;
+/**
+ * The surface that a headless renderer draws into, or NULL if using a window.
+ */
+SDL_Surface *offscreen = NULL;
 /**
  * The renderer used to draw the scene.
  */
@@ -43,12 +71,146 @@ key_handler_t key_handler = NULL;
  */
 uint32_t key_start_timestamp;
 /**
- * The value of clock() when time_since_last_tick() was last called.
- * Initially 0.
+ * Times the game loop's frames, or NULL before the backend is initialized.
+ * time_since_last_tick() ends a frame on it.
  */
-clock_t last_clock = 0;
+frame_clock_t *tick_clock = NULL;
 
+/**
+ * The background color set by the game.
+ */
 rgb_color_t background_color;
+/**
+ * The background color of the frame being drawn. It is copied from
+ * background_color when the frame is captured, since the game may change
+ * background_color while the main thread draws an older frame.
+ */
+rgb_color_t clear_color;
+
+/**
+ * The affine map from scene coordinates to pixel coordinates:
+ * pixel = (scale * x + offset.x, offset.y - scale * y).
+ * The y axis is flipped since positive y is down on the screen.
+ */
+typedef struct view_transform {
+    double scale;
+    vector_t offset;
+} view_transform_t;
+
+view_transform_t view;
+/**
+ * Set when the output size may have changed, so the next frame
+ * recomputes view. Written by the event loop, read when drawing.
+ */
+SDL_atomic_t view_stale;
+
+/**
+ * The captured vertices of the frame being drawn, mapped to pixels.
+ * Reused between frames.
+ */
+SDL_FPoint *frame_pixels = NULL;
+size_t frame_pixel_capacity = 0;
+
+/**
+ * The atlas that colored polygons are batched with, or NULL if none is loaded.
+ */
+sdl_atlas_t *active_atlas = NULL;
+
+/**
+ * Vertices and indices waiting to be submitted with a single
+ * SDL_RenderGeometry() call. The buffers are reused between frames.
+ */
+typedef struct sprite_batch {
+    SDL_Texture *tex;
+    SDL_Vertex *vertices;
+    size_t vertex_count;
+    size_t vertex_capacity;
+    int *indices;
+    size_t index_count;
+    size_t index_capacity;
+} sprite_batch_t;
+
+sprite_batch_t batch = {0};
+
+/**
+ * Triple-buffered frames shared between the game and the main thread,
+ * while sdl_run() runs the game on a thread of its own.
+ * The game captures into back and swaps it with pending;
+ * the main thread swaps pending with front and draws front.
+ * Neither side ever waits for the other to finish a frame.
+ * All drawing and event polling stays on the main thread,
+ * which created the window and renderer.
+ */
+typedef struct render_pipeline {
+    render_frame_t *frames[3];
+    // the background color each frame was captured with
+    rgb_color_t backgrounds[3];
+    size_t back;
+    size_t pending;
+    size_t front;
+    // whether pending holds a frame that hasn't been drawn yet
+    bool fresh;
+    // whether the game is running on its own thread
+    bool running;
+    // set once the game has returned
+    bool finished;
+    void (*game)(void);
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_cond *published;
+} render_pipeline_t;
+
+render_pipeline_t pipeline = {0};
+
+/**
+ * A key or mouse event read by the event loop on the main thread.
+ */
+typedef struct input_event {
+    char key;
+    key_event_type_t type;
+    double held_time;
+} input_event_t;
+
+/**
+ * The events the main thread has read but the game hasn't handled yet,
+ * used as a ring buffer. Guarded by pipeline.lock.
+ * sdl_is_done() passes them to the key handler on the game's thread,
+ * so the handler never runs at the same time as the game.
+ */
+typedef struct input_queue {
+    input_event_t events[INPUT_QUEUE_CAPACITY];
+    size_t start;
+    size_t count;
+    // whether the window has been closed
+    bool quit;
+} input_queue_t;
+
+input_queue_t input = {0};
+
+/**
+ * The frame used by sdl_render_scene() when the game runs on the main thread.
+ */
+render_frame_t *immediate_frame = NULL;
+
+/**
+ * Progress of a headless run. Headless frames take a fixed amount of game
+ * time and are driven by a scripted player who keeps firing and sweeps
+ * left and right, so runs are repeatable.
+ */
+typedef struct headless_run {
+    size_t frame_limit;
+    // whether frames are drawn into the offscreen surface or only captured
+    bool rasterize;
+    size_t frames;
+    size_t items_captured;
+    // whether the key handler changed since the fire button was last pressed
+    bool new_handler;
+    Uint64 start_counter;
+    // whether sdl_headless_report() has printed the run's times
+    bool reported;
+} headless_run_t;
+
+headless_run_t headless = {.frame_limit = 0, .rasterize = false};
 
 void sdl_set_background_color(rgb_color_t color) {
     background_color = color;
@@ -56,14 +218,10 @@ void sdl_set_background_color(rgb_color_t color) {
 
 /** Computes the center of the window in pixel coordinates */
 vector_t get_window_center(void) {
-    int *width = malloc(sizeof(*width)),
-        *height = malloc(sizeof(*height));
-    assert(width != NULL);
-    assert(height != NULL);
-    SDL_GetWindowSize(window, width, height);
-    vector_t dimensions = {.x = *width, .y = *height};
-    free(width);
-    free(height);
+    int width, height;
+    // works for both the window and the offscreen surface
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+    vector_t dimensions = {.x = width, .y = height};
     return vec_multiply(0.5, dimensions);
 }
 
@@ -79,18 +237,47 @@ double get_scene_scale(vector_t window_center) {
     return x_scale < y_scale ? x_scale : y_scale;
 }
 
-/** Maps a scene coordinate to a window coordinate */
-vector_t get_window_position(vector_t scene_pos, vector_t window_center) {
+/** Recomputes view if the output size changed since it was last computed */
+void update_view(void) {
+    if (!SDL_AtomicSet(&view_stale, 0)) {
+        return;
+    }
     // Scale scene coordinates by the scaling factor
     // and map the center of the scene to the center of the window
-    vector_t scene_center_offset = vec_subtract(scene_pos, center);
+    vector_t window_center = get_window_center();
     double scale = get_scene_scale(window_center);
-    vector_t pixel_center_offset = vec_multiply(scale, scene_center_offset);
-    vector_t pixel = {
-        .x = round(window_center.x + pixel_center_offset.x),
-        // Flip y axis since positive y is down on the screen
-        .y = round(window_center.y - pixel_center_offset.y)};
-    return pixel;
+    view = (view_transform_t){
+        .scale = scale,
+        .offset = {
+            .x = window_center.x - scale * center.x,
+            .y = window_center.y + scale * center.y}};
+}
+
+/** Maps a scene coordinate to a window coordinate */
+vector_t get_window_position(vector_t scene_pos) {
+    return (vector_t){
+        .x = view.scale * scene_pos.x + view.offset.x,
+        .y = view.offset.y - view.scale * scene_pos.y};
+}
+
+/**
+ * Maps every captured vertex of a frame to pixels in one pass,
+ * storing the result in frame_pixels.
+ */
+void transform_frame_vertices(const render_frame_t *frame) {
+    size_t n = render_frame_vertex_count(frame);
+    if (n > frame_pixel_capacity) {
+        frame_pixel_capacity = n * 2;
+        frame_pixels = realloc(frame_pixels, frame_pixel_capacity * sizeof(SDL_FPoint));
+        assert(frame_pixels != NULL);
+    }
+    const vector_t *restrict points = render_frame_vertices(frame);
+    SDL_FPoint *restrict pixels = frame_pixels;
+    float scale = view.scale, x_offset = view.offset.x, y_offset = view.offset.y;
+    for (size_t i = 0; i < n; i++) {
+        pixels[i].x = scale * (float)points[i].x + x_offset;
+        pixels[i].y = y_offset - scale * (float)points[i].y;
+    }
 }
 
 /**
@@ -153,70 +340,238 @@ void sdl_init(vector_t min, vector_t max) {
         WINDOW_HEIGHT,
         SDL_WINDOW_RESIZABLE);
     renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    SDL_AtomicSet(&view_stale, 1);
+    tick_clock = frame_clock_init(0);
+}
+
+void sdl_init_headless(vector_t min, vector_t max) {
+    assert(min.x < max.x);
+    assert(min.y < max.y);
+
+    center = vec_multiply(0.5, vec_add(min, max));
+    max_diff = vec_subtract(max, center);
+    TTF_Init();
+    offscreen = SDL_CreateRGBSurfaceWithFormat(0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, SDL_PIXELFORMAT_RGBA32);
+    assert(offscreen != NULL);
+    renderer = SDL_CreateSoftwareRenderer(offscreen);
+    assert(renderer != NULL);
+    SDL_AtomicSet(&view_stale, 1);
+    // headless frames run as fast as they can, so this only measures them
+    tick_clock = frame_clock_init(0);
+}
+
+void sdl_configure_headless(size_t frame_limit, bool rasterize) {
+    headless.frame_limit = frame_limit;
+    headless.rasterize = rasterize;
 }
 
 void sdl_set_font(const char *font_path) {
     FONT_PATH = font_path;
 }
 
-bool sdl_is_done(void *aux) {
-    SDL_Event *event = malloc(sizeof(*event));
-    assert(event != NULL);
+/**
+ * Passes a key or mouse event to the key handler. While the game runs on
+ * its own thread, the event is queued for its next sdl_is_done() instead.
+ */
+void sdl_dispatch_key(char key, key_event_type_t type, double held_time, void *aux) {
+    if (!pipeline.running) {
+        if (key_handler != NULL) {
+            key_handler(key, type, held_time, aux);
+        }
+        return;
+    }
+    SDL_LockMutex(pipeline.lock);
+    // a full queue drops the newest events; the game is far behind anyway
+    if (input.count < INPUT_QUEUE_CAPACITY) {
+        size_t end = (input.start + input.count) % INPUT_QUEUE_CAPACITY;
+        input.events[end] = (input_event_t){.key = key, .type = type, .held_time = held_time};
+        input.count++;
+    }
+    SDL_UnlockMutex(pipeline.lock);
+}
 
-    while (SDL_PollEvent(event)) {
-        switch (event->type) {
+/**
+ * Processes all pending SDL events. Must be called on the main thread.
+ *
+ * @param aux the value passed to the key handler
+ * @return true if the window was closed, false otherwise
+ */
+bool sdl_poll_events(void *aux) {
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        switch (event.type) {
         case SDL_QUIT: // TODO: do we need to call TTF_Quit() here? SDL_Quit() not called?
-            free(event);
             return true;
         case SDL_KEYDOWN:
-        case SDL_KEYUP:
-            // Skip the keypress if no handler is configured
-            // or an unrecognized key was pressed
-            if (key_handler == NULL)
-                break;
-            char key = get_keycode(event->key.keysym.sym);
+        case SDL_KEYUP: {
+            // Skip the keypress if an unrecognized key was pressed
+            char key = get_keycode(event.key.keysym.sym);
             if (key == '\0')
                 break;
 
-            uint32_t timestamp = event->key.timestamp;
-            if (!event->key.repeat) {
+            uint32_t timestamp = event.key.timestamp;
+            if (!event.key.repeat) {
                 key_start_timestamp = timestamp;
             }
             key_event_type_t type =
-                event->type == SDL_KEYDOWN ? KEY_PRESSED : KEY_RELEASED;
+                event.type == SDL_KEYDOWN ? KEY_PRESSED : KEY_RELEASED;
             double held_time = (timestamp - key_start_timestamp) / MS_PER_S;
-            key_handler(key, type, held_time, aux);
+            sdl_dispatch_key(key, type, held_time, aux);
+            break;
+        }
+        case SDL_WINDOWEVENT:
+            if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                SDL_AtomicSet(&view_stale, 1);
+            }
             break;
         case SDL_MOUSEBUTTONDOWN:
-        case SDL_MOUSEBUTTONUP:
-            if (key_handler == NULL)
-                break;
-            char mousekey = get_mousecode(event->button.button);
+        case SDL_MOUSEBUTTONUP: {
+            char mousekey = get_mousecode(event.button.button);
             if (mousekey == '\0')
                 break;
             key_event_type_t mouse_type =
-                event->type == SDL_MOUSEBUTTONDOWN ? KEY_PRESSED : KEY_RELEASED;
-            key_handler(mousekey, mouse_type, 0, aux);
+                event.type == SDL_MOUSEBUTTONDOWN ? KEY_PRESSED : KEY_RELEASED;
+            sdl_dispatch_key(mousekey, mouse_type, 0, aux);
             break;
         }
+        }
     }
-    free(event);
     return false;
 }
 
+bool sdl_is_done(void *aux) {
+    if (!pipeline.running) {
+        return sdl_poll_events(aux);
+    }
+    // the main thread polls the events; this only hands them to the game
+    input_event_t events[INPUT_QUEUE_CAPACITY];
+    SDL_LockMutex(pipeline.lock);
+    size_t count = input.count;
+    for (size_t i = 0; i < count; i++) {
+        events[i] = input.events[(input.start + i) % INPUT_QUEUE_CAPACITY];
+    }
+    input.start = (input.start + count) % INPUT_QUEUE_CAPACITY;
+    input.count = 0;
+    bool quit = input.quit;
+    SDL_UnlockMutex(pipeline.lock);
+
+    for (size_t i = 0; i < count && key_handler != NULL; i++) {
+        key_handler(events[i].key, events[i].type, events[i].held_time, aux);
+    }
+    return quit;
+}
+
 void sdl_clear(void) {
-    rgb_color_t color = background_color;
+    rgb_color_t color = clear_color;
     SDL_SetRenderDrawColor(renderer, color.r * 255, color.g * 255, color.b * 255, color.a * 255);
     SDL_RenderClear(renderer);
 }
 
-void sdl_draw_polygon(const body_t *body, vector_t window_center) {
-    const list_t *points = body_borrow_shape(body);
-    // Check parameters
-    size_t n = list_size(points);
-    assert(n >= 3);
+/** Submits everything queued in the batch to the renderer */
+void batch_flush(void) {
+    if (batch.index_count > 0) {
+        SDL_RenderGeometry(renderer, batch.tex,
+                           batch.vertices, batch.vertex_count,
+                           batch.indices, batch.index_count);
+    }
+    batch.vertex_count = 0;
+    batch.index_count = 0;
+}
+
+/**
+ * Makes room in the batch for the given number of vertices and indices
+ * drawn with tex, flushing first if the batch uses a different texture.
+ * Returns the index of the first new vertex.
+ */
+size_t batch_reserve(SDL_Texture *tex, size_t vertices, size_t indices) {
+    if (tex != batch.tex) {
+        batch_flush();
+        batch.tex = tex;
+    }
+    if (batch.vertex_count + vertices > batch.vertex_capacity) {
+        size_t capacity = batch.vertex_capacity == 0 ? INITIAL_BATCH_VERTICES : batch.vertex_capacity;
+        while (capacity < batch.vertex_count + vertices) {
+            capacity *= 2;
+        }
+        batch.vertices = realloc(batch.vertices, capacity * sizeof(*batch.vertices));
+        assert(batch.vertices != NULL);
+        batch.vertex_capacity = capacity;
+    }
+    if (batch.index_count + indices > batch.index_capacity) {
+        size_t capacity = batch.index_capacity == 0 ? INITIAL_BATCH_VERTICES : batch.index_capacity;
+        while (capacity < batch.index_count + indices) {
+            capacity *= 2;
+        }
+        batch.indices = realloc(batch.indices, capacity * sizeof(*batch.indices));
+        assert(batch.indices != NULL);
+        batch.index_capacity = capacity;
+    }
+    return batch.vertex_count;
+}
 
-    render_info_t texture = body_get_render_data(body);
+/**
+ * Queues a solid-colored polygon as a triangle fan around its centroid.
+ * This is exact for every polygon that is star-shaped about its centroid,
+ * which includes the stars and sectors built by polygon.c.
+ */
+void batch_add_polygon(const render_item_t *item, const SDL_FPoint *pixels) {
+    rgb_color_t color = item->render.data.color;
+    size_t n = item->vertex_count;
+    size_t first = batch_reserve(atlas_get_texture(active_atlas), n + 1, 3 * n);
+    SDL_FPoint white_uv = atlas_get_white_uv(active_atlas);
+    SDL_Color sdl_color = {color.r * 255, color.g * 255, color.b * 255, 255};
+
+    vector_t center = get_window_position(item->centroid);
+    batch.vertices[first] = (SDL_Vertex){
+        .position = {center.x, center.y},
+        .color = sdl_color,
+        .tex_coord = white_uv};
+    for (size_t i = 0; i < n; i++) {
+        batch.vertices[first + 1 + i] = (SDL_Vertex){
+            .position = pixels[i],
+            .color = sdl_color,
+            .tex_coord = white_uv};
+
+        int *triangle = batch.indices + batch.index_count + 3 * i;
+        triangle[0] = first;
+        triangle[1] = first + 1 + i;
+        triangle[2] = first + 1 + (i + 1) % n;
+    }
+    batch.vertex_count += n + 1;
+    batch.index_count += 3 * n;
+}
+
+/** Queues a rotated textured quad centered on the body's centroid */
+void batch_add_sprite(const render_item_t *item) {
+    render_data_texture_t data = item->render.data.texture;
+    size_t first = batch_reserve(data.tex, 4, 6);
+
+    vector_t pos = get_window_position(item->centroid);
+    double angle = item->angle;
+    double c = cos(angle), s = sin(angle);
+    // corners relative to the centroid, in pixels, counterclockwise from top left
+    double xs[4] = {-data.dx, data.w - data.dx, data.w - data.dx, -data.dx};
+    double ys[4] = {-data.dy, -data.dy, data.h - data.dy, data.h - data.dy};
+    float us[4] = {data.uv.x, data.uv.x + data.uv.w, data.uv.x + data.uv.w, data.uv.x};
+    float vs[4] = {data.uv.y, data.uv.y, data.uv.y + data.uv.h, data.uv.y + data.uv.h};
+    for (size_t i = 0; i < 4; i++) {
+        // positive y is down on the screen, so a counterclockwise rotation
+        // in the scene is (x, y) -> (x cos + y sin, y cos - x sin) in pixels
+        batch.vertices[first + i] = (SDL_Vertex){
+            .position = {pos.x + xs[i] * c + ys[i] * s, pos.y + ys[i] * c - xs[i] * s},
+            .color = {255, 255, 255, 255},
+            .tex_coord = {us[i], vs[i]}};
+    }
+    int quad[6] = {0, 1, 2, 0, 2, 3};
+    for (size_t i = 0; i < 6; i++) {
+        batch.indices[batch.index_count + i] = first + quad[i];
+    }
+    batch.vertex_count += 4;
+    batch.index_count += 6;
+}
+
+void sdl_draw_item(const render_item_t *item, const SDL_FPoint *pixels) {
+    render_info_t texture = item->render;
     // Draw polygon with the given color
     if (texture.type == COLOR) {
         rgb_color_t color = texture.data.color;
@@ -224,16 +579,25 @@ void sdl_draw_polygon(const body_t *body, vector_t window_center) {
         assert(0 <= color.g && color.g <= 1);
         assert(0 <= color.b && color.b <= 1);
 
+        // Check parameters
+        size_t n = item->vertex_count;
+        assert(n >= 3);
+        const SDL_FPoint *points = pixels + item->first_vertex;
+
+        if (active_atlas != NULL) {
+            batch_add_polygon(item, points);
+            return;
+        }
+        batch_flush();
+
         // Convert each vertex to a point on screen
         int16_t *x_points = malloc(sizeof(*x_points) * n),
                 *y_points = malloc(sizeof(*y_points) * n);
         assert(x_points != NULL);
         assert(y_points != NULL);
         for (size_t i = 0; i < n; i++) {
-            vector_t vertex = list_copy_vector(points, i);
-            vector_t pixel = get_window_position(vertex, window_center);
-            x_points[i] = pixel.x;
-            y_points[i] = pixel.y;
+            x_points[i] = round(points[i].x);
+            y_points[i] = round(points[i].y);
         }
 
         filledPolygonRGBA(
@@ -244,40 +608,29 @@ void sdl_draw_polygon(const body_t *body, vector_t window_center) {
         free(x_points);
         free(y_points);
     } else if (texture.type == TEX) {
-        render_data_texture_t data = texture.data.texture;
-        SDL_Texture *tex = data.tex;
-
-        vector_t pos = get_window_position(body_get_centroid(body), window_center);
-        int w = data.w;
-        int h = data.h;
-        int x = pos.x - data.dx;
-        int y = pos.y - data.dy;
-        double angle = body_get_angle(body);
-
-        SDL_RenderCopyEx(renderer, tex, NULL, &(SDL_Rect){x, y, w, h}, -angle * 180 / M_PI, NULL, 0);
+        batch_add_sprite(item);
     }
 }
 
-void sdl_show(vector_t window_center) {
+void sdl_show(void) {
     // Draw boundary lines
     vector_t max = vec_add(center, max_diff),
              min = vec_subtract(center, max_diff);
-    vector_t max_pixel = get_window_position(max, window_center),
-             min_pixel = get_window_position(min, window_center);
-    SDL_Rect *boundary = malloc(sizeof(*boundary));
-    boundary->x = min_pixel.x;
-    boundary->y = max_pixel.y;
-    boundary->w = max_pixel.x - min_pixel.x;
-    boundary->h = min_pixel.y - max_pixel.y;
+    vector_t max_pixel = get_window_position(max),
+             min_pixel = get_window_position(min);
+    SDL_Rect boundary = {
+        .x = round(min_pixel.x),
+        .y = round(max_pixel.y),
+        .w = round(max_pixel.x - min_pixel.x),
+        .h = round(min_pixel.y - max_pixel.y)};
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderDrawRect(renderer, boundary);
-    free(boundary);
+    SDL_RenderDrawRect(renderer, &boundary);
 
     SDL_RenderPresent(renderer);
 }
 
-int sdl_render_text(const text_box_t *text_box) {
-    TTF_Font *font = TTF_OpenFont(FONT_PATH, text_box_get_font_size(text_box));
+int sdl_render_text(const render_text_t *text_box) {
+    TTF_Font *font = TTF_OpenFont(FONT_PATH, text_box->font_size);
     if (!font) {
         printf("Unable to load font: '%s'!\n"
                "SDL2_ttf Error: %s\n",
@@ -290,7 +643,7 @@ int sdl_render_text(const text_box_t *text_box) {
     SDL_Texture *text = NULL;
     SDL_Rect textRect;
 
-    SDL_Surface *textSurface = TTF_RenderText_Shaded(font, text_box_borrow_text(text_box), textColor, textBackgroundColor);
+    SDL_Surface *textSurface = TTF_RenderText_Shaded(font, text_box->text, textColor, textBackgroundColor);
     if (!textSurface) {
         printf("Unable to render text surface!\n"
                "SDL2_ttf Error: %s\n",
@@ -313,59 +666,394 @@ int sdl_render_text(const text_box_t *text_box) {
 
     SDL_FreeSurface(textSurface);
 
-    switch (text_box_get_justification(text_box)) {
+    switch (text_box->justification) {
     case LEFT: {
-        textRect.x = WINDOW_WIDTH - text_box_get_origin(text_box).x;
+        textRect.x = WINDOW_WIDTH - text_box->origin.x;
         break;
     }
     case RIGHT: {
-        textRect.x = WINDOW_WIDTH - text_box_get_origin(text_box).x - textRect.w;
+        textRect.x = WINDOW_WIDTH - text_box->origin.x - textRect.w;
         break;
     }
     case CENTER: {
-        textRect.x = WINDOW_WIDTH - text_box_get_origin(text_box).x - (textRect.w / 2.0);
+        textRect.x = WINDOW_WIDTH - text_box->origin.x - (textRect.w / 2.0);
         break;
     }
     }
-    textRect.y = WINDOW_HEIGHT - text_box_get_origin(text_box).y;
+    textRect.y = WINDOW_HEIGHT - text_box->origin.y;
 
     SDL_RenderCopy(renderer, text, NULL, &textRect);
 
+    SDL_DestroyTexture(text);
     TTF_CloseFont(font);
 
     return 1;
 }
 
-void sdl_render_scene(const scene_t *scene) {
+#ifdef PROFILER
+/** Draws one line of the profiler overlay, counting lines from the top */
+void sdl_render_profiler_line(const char *line, size_t index) {
+    render_text_t text = {
+        .text = line,
+        .font_size = PROFILER_OVERLAY_FONT_SIZE,
+        .origin = {
+            .x = WINDOW_WIDTH - PROFILER_OVERLAY_MARGIN,
+            .y = WINDOW_HEIGHT - PROFILER_OVERLAY_MARGIN - (int)index * PROFILER_OVERLAY_LINE_HEIGHT},
+        .justification = LEFT};
+    sdl_render_text(&text);
+}
+
+/**
+ * Draws the average time of each profiler zone over the frame,
+ * followed by the collision counters of the last frame
+ */
+void sdl_render_profiler_overlay(void) {
+    char line[64];
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; zone++) {
+        // indent each zone under the zone it runs inside of
+        int indent = 2 * profile_zone_depth(zone);
+        snprintf(line, sizeof(line), "%*s%-20s %7.3f ms", indent, "",
+                 profile_zone_name(zone), profiler_average_ms(zone));
+        sdl_render_profiler_line(line, zone);
+    }
+    for (size_t counter = 0; counter < PROFILE_COUNTER_COUNT; counter++) {
+        snprintf(line, sizeof(line), "%-20s %7zu", profile_counter_name(counter),
+                 profiler_counter_frame(counter));
+        sdl_render_profiler_line(line, PROFILE_ZONE_COUNT + counter);
+    }
+}
+#endif
+
+void sdl_render_frame(const render_frame_t *frame) {
+    PROFILE_BEGIN(ZONE_RENDER);
+    update_view();
     sdl_clear();
-    size_t body_count = scene_bodies(scene);
-    vector_t window_center = get_window_center();
-    for (size_t i = 0; i < body_count; i++) {
-        const body_t *body = scene_borrow_body(scene, i);
-        sdl_draw_polygon(body, window_center);
+    transform_frame_vertices(frame);
+    size_t item_count = render_frame_items(frame);
+    for (size_t i = 0; i < item_count; i++) {
+        sdl_draw_item(render_frame_get_item(frame, i), frame_pixels);
+    }
+    batch_flush();
+    PROFILE_BEGIN(ZONE_TEXT);
+    size_t text_count = render_frame_texts(frame);
+    for (size_t i = 0; i < text_count; i++) {
+        sdl_render_text(render_frame_get_text(frame, i));
+    }
+#ifdef PROFILER
+    sdl_render_profiler_overlay();
+#endif
+    PROFILE_END(ZONE_TEXT);
+    sdl_show();
+    PROFILE_END(ZONE_RENDER);
+}
+
+void sdl_render_scene(const scene_t *scene) {
+    if (pipeline.running) {
+        PROFILE_BEGIN(ZONE_CAPTURE);
+        render_frame_capture(pipeline.frames[pipeline.back], scene);
+        PROFILE_END(ZONE_CAPTURE);
+        pipeline.backgrounds[pipeline.back] = background_color;
+
+        SDL_LockMutex(pipeline.lock);
+        size_t published = pipeline.back;
+        pipeline.back = pipeline.pending;
+        pipeline.pending = published;
+        pipeline.fresh = true;
+        SDL_CondSignal(pipeline.published);
+        SDL_UnlockMutex(pipeline.lock);
+        return;
+    }
+
+    if (immediate_frame == NULL) {
+        immediate_frame = render_frame_init();
+    }
+    PROFILE_BEGIN(ZONE_CAPTURE);
+    render_frame_capture(immediate_frame, scene);
+    PROFILE_END(ZONE_CAPTURE);
+    clear_color = background_color;
+    sdl_render_frame(immediate_frame);
+}
+
+/** Body of the game's thread: runs the game, then tells the main thread */
+int game_thread_main(void *data) {
+    pipeline.game();
+    SDL_LockMutex(pipeline.lock);
+    pipeline.finished = true;
+    SDL_CondSignal(pipeline.published);
+    SDL_UnlockMutex(pipeline.lock);
+    return 0;
+}
+
+void sdl_run(void (*game)(void)) {
+    assert(!pipeline.running);
+    for (size_t i = 0; i < 3; i++) {
+        pipeline.frames[i] = render_frame_init();
+    }
+    pipeline.back = 0;
+    pipeline.pending = 1;
+    pipeline.front = 2;
+    pipeline.fresh = false;
+    pipeline.finished = false;
+    pipeline.game = game;
+    pipeline.lock = SDL_CreateMutex();
+    pipeline.published = SDL_CreateCond();
+    assert(pipeline.lock != NULL);
+    assert(pipeline.published != NULL);
+    input.start = 0;
+    input.count = 0;
+    input.quit = false;
+    pipeline.running = true;
+    pipeline.thread = SDL_CreateThread(game_thread_main, "game", NULL);
+    assert(pipeline.thread != NULL);
+
+    // the event loop: poll input and draw the newest published frame
+    // until the game returns
+    while (true) {
+        bool quit = sdl_poll_events(NULL);
+
+        SDL_LockMutex(pipeline.lock);
+        input.quit = input.quit || quit;
+        if (!pipeline.fresh && !pipeline.finished) {
+            SDL_CondWaitTimeout(pipeline.published, pipeline.lock, EVENT_POLL_MS);
+        }
+        if (pipeline.finished) {
+            SDL_UnlockMutex(pipeline.lock);
+            break;
+        }
+        bool fresh = pipeline.fresh;
+        if (fresh) {
+            size_t newest = pipeline.pending;
+            pipeline.pending = pipeline.front;
+            pipeline.front = newest;
+            pipeline.fresh = false;
+        }
+        SDL_UnlockMutex(pipeline.lock);
+
+        if (fresh) {
+            clear_color = pipeline.backgrounds[pipeline.front];
+            sdl_render_frame(pipeline.frames[pipeline.front]);
+        }
     }
-    size_t text_box_count = scene_text_boxes(scene);
-    for (size_t i = 0; i < text_box_count; i++) {
-        sdl_render_text(scene_borrow_text_box(scene, i));
+
+    SDL_WaitThread(pipeline.thread, NULL);
+    pipeline.running = false;
+    SDL_DestroyCond(pipeline.published);
+    SDL_DestroyMutex(pipeline.lock);
+    for (size_t i = 0; i < 3; i++) {
+        render_frame_free(pipeline.frames[i]);
     }
-    sdl_show(window_center);
 }
 
 void sdl_on_key(key_handler_t handler) {
     key_handler = handler;
 }
 
+void headless_on_key(key_handler_t handler) {
+    key_handler = handler;
+    headless.new_handler = true;
+}
+
+void sdl_headless_report(void) {
+    if (headless.frames == 0 || headless.reported) {
+        return;
+    }
+    double seconds = (double)(SDL_GetPerformanceCounter() - headless.start_counter) /
+                     SDL_GetPerformanceFrequency();
+    printf("headless: %zu frames in %.3f s (%.3f ms per frame, %zu bodies captured)\n",
+           headless.frames, seconds, MS_PER_S * seconds / headless.frames,
+           headless.items_captured);
+    printf("headless: frame times p50 %.1f ms, p95 %.1f ms, p99 %.1f ms over the last %zu frames\n",
+           frame_clock_percentile(tick_clock, 0.5), frame_clock_percentile(tick_clock, 0.95),
+           frame_clock_percentile(tick_clock, 0.99), frame_clock_frames(tick_clock));
+    headless.reported = true;
+}
+
+bool headless_is_done(void *aux) {
+    if (headless.frames == 0) {
+        headless.start_counter = SDL_GetPerformanceCounter();
+    }
+    if (headless.frames >= headless.frame_limit) {
+        sdl_headless_report();
+        return true;
+    }
+
+    if (key_handler != NULL) {
+        // press fire once per screen: it starts the game from the menus
+        // and keeps the player shooting during the game
+        if (headless.new_handler) {
+            key_handler(ATTACK1_BUTTON, KEY_PRESSED, 0, aux);
+            headless.new_handler = false;
+        }
+        if (headless.frames % HEADLESS_STEER_FRAMES == 0) {
+            bool go_left = headless.frames / HEADLESS_STEER_FRAMES % 2 == 0;
+            key_handler(go_left ? RIGHT_ARROW : LEFT_ARROW, KEY_RELEASED, 0, aux);
+            key_handler(go_left ? LEFT_ARROW : RIGHT_ARROW, KEY_PRESSED, 0, aux);
+        }
+    }
+    headless.frames++;
+    return false;
+}
+
+void headless_render_scene(const scene_t *scene) {
+    if (headless.rasterize) {
+        sdl_render_scene(scene);
+        return;
+    }
+    // still capture the scene so the game thread does the same work
+    // as with a real renderer, but discard the frame
+    if (immediate_frame == NULL) {
+        immediate_frame = render_frame_init();
+    }
+    PROFILE_BEGIN(ZONE_CAPTURE);
+    render_frame_capture(immediate_frame, scene);
+    PROFILE_END(ZONE_CAPTURE);
+    headless.items_captured += render_frame_items(immediate_frame);
+}
+
+void headless_run(void (*game)(void)) {
+    // without a window there are no events to poll, so the game draws,
+    // if at all, on the calling thread
+    game();
+}
+
+double headless_time_since_last_tick(void) {
+    // the real frame time is recorded, but the game advances by a fixed step
+    frame_clock_tick(tick_clock);
+    return HEADLESS_TICK;
+}
+
+void headless_set_frame_rate(double fps) {}
+
 SDL_Texture *sdl_load_texture(char *file) {
     SDL_Texture *ptr = IMG_LoadTexture(renderer, file);
     assert(ptr != NULL);
     return ptr;
 }
 
+sdl_atlas_t *sdl_atlas_init(const char *const *files, size_t count) {
+    SDL_Surface **images = malloc(count * sizeof(SDL_Surface *));
+    SDL_Rect *places = malloc(count * sizeof(SDL_Rect));
+    assert(images != NULL);
+    assert(places != NULL);
+    int total_area = ATLAS_WHITE_SIZE * ATLAS_WHITE_SIZE;
+    int widest = ATLAS_WHITE_SIZE;
+    for (size_t i = 0; i < count; i++) {
+        images[i] = IMG_Load(files[i]);
+        if (images[i] == NULL) {
+            printf("Unable to load image: '%s'!\n"
+                   "SDL2_image Error: %s\n",
+                   files[i], SDL_GetError());
+        }
+        assert(images[i] != NULL);
+        total_area += (images[i]->w + ATLAS_PADDING) * (images[i]->h + ATLAS_PADDING);
+        widest = imax(widest, images[i]->w + ATLAS_PADDING);
+    }
+
+    // Shelf packing: place images left to right and start a new row
+    // whenever the next image doesn't fit in the atlas width.
+    int width = imax(widest, (int)ceil(sqrt(total_area)));
+    int x = ATLAS_WHITE_SIZE + ATLAS_PADDING, y = 0, shelf_height = ATLAS_WHITE_SIZE;
+    for (size_t i = 0; i < count; i++) {
+        if (x + images[i]->w > width) {
+            x = 0;
+            y += shelf_height + ATLAS_PADDING;
+            shelf_height = 0;
+        }
+        places[i] = (SDL_Rect){x, y, images[i]->w, images[i]->h};
+        x += images[i]->w + ATLAS_PADDING;
+        shelf_height = imax(shelf_height, images[i]->h);
+    }
+    int height = y + shelf_height;
+
+    SDL_Surface *sheet = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    assert(sheet != NULL);
+    // every byte 0xFF is opaque white in any 32-bit RGBA layout
+    for (int row = 0; row < ATLAS_WHITE_SIZE; row++) {
+        memset((char *)sheet->pixels + row * sheet->pitch, 0xFF, ATLAS_WHITE_SIZE * 4);
+    }
+    for (size_t i = 0; i < count; i++) {
+        // copy alpha as-is instead of blending onto the empty sheet
+        SDL_SetSurfaceBlendMode(images[i], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(images[i], NULL, sheet, &places[i]);
+        SDL_FreeSurface(images[i]);
+    }
+
+    SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, sheet);
+    assert(tex != NULL);
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    SDL_FreeSurface(sheet);
+
+    sdl_atlas_t *atlas = atlas_init(tex, count);
+    for (size_t i = 0; i < count; i++) {
+        atlas_set_sprite(atlas, i, (SDL_FRect){
+            (float)places[i].x / width,
+            (float)places[i].y / height,
+            (float)places[i].w / width,
+            (float)places[i].h / height});
+    }
+    atlas_set_white_uv(atlas, (SDL_FPoint){
+        0.5f * ATLAS_WHITE_SIZE / width,
+        0.5f * ATLAS_WHITE_SIZE / height});
+
+    free(images);
+    free(places);
+    active_atlas = atlas;
+    return atlas;
+}
+
+void sdl_atlas_free(sdl_atlas_t *atlas) {
+    if (active_atlas == atlas) {
+        active_atlas = NULL;
+    }
+    SDL_Texture *tex = atlas_get_texture(atlas);
+    if (batch.tex == tex) {
+        batch.tex = NULL;
+    }
+    SDL_DestroyTexture(tex);
+    atlas_free(atlas);
+}
+
 double time_since_last_tick(void) {
-    clock_t now = clock();
-    double difference = last_clock
-                            ? (double)(now - last_clock) / CLOCKS_PER_SEC
-                            : 0.0; // return 0 the first time this is called
-    last_clock = now;
-    return difference;
+    assert(tick_clock != NULL);
+    return frame_clock_tick(tick_clock);
 }
+
+void sdl_set_frame_rate(double fps) {
+    assert(tick_clock != NULL);
+    frame_clock_set_target(tick_clock, fps);
+}
+
+const frame_clock_t *sdl_frame_clock(void) {
+    assert(tick_clock != NULL);
+    return tick_clock;
+}
+
+const backend_t SDL_BACKEND = {
+    .name = "sdl",
+    .init = sdl_init,
+    .set_background_color = sdl_set_background_color,
+    .set_font = sdl_set_font,
+    .on_key = sdl_on_key,
+    .is_done = sdl_is_done,
+    .render_scene = sdl_render_scene,
+    .run = sdl_run,
+    .atlas_init = sdl_atlas_init,
+    .atlas_free = sdl_atlas_free,
+    .time_since_last_tick = time_since_last_tick,
+    .set_frame_rate = sdl_set_frame_rate,
+    .frame_clock = sdl_frame_clock};
+
+const backend_t HEADLESS_BACKEND = {
+    .name = "headless",
+    .init = sdl_init_headless,
+    .set_background_color = sdl_set_background_color,
+    .set_font = sdl_set_font,
+    .on_key = headless_on_key,
+    .is_done = headless_is_done,
+    .render_scene = headless_render_scene,
+    .run = headless_run,
+    .atlas_init = sdl_atlas_init,
+    .atlas_free = sdl_atlas_free,
+    .time_since_last_tick = headless_time_since_last_tick,
+    .set_frame_rate = headless_set_frame_rate,
+    .frame_clock = sdl_frame_clock};
@@ -0,0 +1,129 @@
+#include "shape_cache.h"
+#include "alloc_track.h"
+#include "polygon.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+const size_t INITIAL_SHAPE_CACHE_SIZE = 8;
+
+typedef enum template_kind {
+    TEMPLATE_NGON,
+    TEMPLATE_STAR,
+    TEMPLATE_SECTOR
+} template_kind_e;
+
+typedef struct shape_template {
+    // the arguments the template was built with, to look it up again
+    template_kind_e kind;
+    size_t points;
+    size_t cut_points;
+    double param;
+
+    vector_t *vertices;
+    size_t size;
+    vector_t centroid;
+    double radius;
+} shape_template_t;
+
+typedef struct shape_cache {
+    list_t *templates;
+} shape_cache_t;
+
+void shape_template_free(shape_template_t *shape) {
+    TRACKED_FREE(ALLOC_SHAPE, shape->vertices);
+    TRACKED_FREE(ALLOC_SHAPE, shape);
+}
+
+shape_cache_t *shape_cache_init(void) {
+    shape_cache_t *cache = TRACKED_MALLOC(ALLOC_OTHER, sizeof(shape_cache_t));
+    assert(cache != NULL);
+    cache->templates = list_init(INITIAL_SHAPE_CACHE_SIZE, (free_func_t)shape_template_free);
+    return cache;
+}
+
+void shape_cache_free(shape_cache_t *cache) {
+    list_free(cache->templates);
+    TRACKED_FREE(ALLOC_OTHER, cache);
+}
+
+/**
+ * Finds the template built with the given arguments, or NULL.
+ * Caches only hold a handful of shapes, so they are searched in order.
+ */
+shape_template_t *shape_cache_find(shape_cache_t *cache, template_kind_e kind, size_t points, size_t cut_points, double param) {
+    for (size_t i = 0; i < list_size(cache->templates); i++) {
+        shape_template_t *shape = list_get(cache->templates, i);
+        if (shape->kind == kind && shape->points == points
+            && shape->cut_points == cut_points && shape->param == param) {
+            return shape;
+        }
+    }
+    return NULL;
+}
+
+/** Copies a unit polygon_*() shape into a new template and adds it to the cache */
+shape_template_t *shape_cache_add(shape_cache_t *cache, template_kind_e kind, size_t points, size_t cut_points, double param, list_t *unit) {
+    shape_template_t *shape = TRACKED_MALLOC(ALLOC_SHAPE, sizeof(shape_template_t));
+    assert(shape != NULL);
+    shape->kind = kind;
+    shape->points = points;
+    shape->cut_points = cut_points;
+    shape->param = param;
+    shape->size = list_size(unit);
+    shape->vertices = TRACKED_MALLOC(ALLOC_SHAPE, shape->size * sizeof(vector_t));
+    assert(shape->vertices != NULL);
+    shape->centroid = polygon_centroid(unit);
+    shape->radius = 0;
+    for (size_t i = 0; i < shape->size; i++) {
+        shape->vertices[i] = *(vector_t *)list_get(unit, i);
+        shape->radius = fmax(shape->radius, vec_norm(vec_subtract(shape->vertices[i], shape->centroid)));
+    }
+    list_free(unit);
+    list_add(cache->templates, shape);
+    return shape;
+}
+
+const shape_template_t *shape_cache_ngon(shape_cache_t *cache, size_t n) {
+    shape_template_t *shape = shape_cache_find(cache, TEMPLATE_NGON, n, 0, 0);
+    if (shape == NULL) {
+        shape = shape_cache_add(cache, TEMPLATE_NGON, n, 0, 0, polygon_reg_ngon(VEC_ZERO, 1, n));
+    }
+    return shape;
+}
+
+const shape_template_t *shape_cache_star(shape_cache_t *cache, double ratio, size_t degree) {
+    shape_template_t *shape = shape_cache_find(cache, TEMPLATE_STAR, degree, 0, ratio);
+    if (shape == NULL) {
+        shape = shape_cache_add(cache, TEMPLATE_STAR, degree, 0, ratio, polygon_star(VEC_ZERO, 1, ratio, degree));
+    }
+    return shape;
+}
+
+const shape_template_t *shape_cache_sector(shape_cache_t *cache, size_t N, size_t n, double theta) {
+    shape_template_t *shape = shape_cache_find(cache, TEMPLATE_SECTOR, N, n, theta);
+    if (shape == NULL) {
+        shape = shape_cache_add(cache, TEMPLATE_SECTOR, N, n, theta, polygon_ngon_sector(VEC_ZERO, 1, N, n, theta));
+    }
+    return shape;
+}
+
+size_t shape_cache_size(const shape_cache_t *cache) {
+    return list_size(cache->templates);
+}
+
+size_t shape_template_size(const shape_template_t *shape) {
+    return shape->size;
+}
+
+const vector_t *shape_template_vertices(const shape_template_t *shape) {
+    return shape->vertices;
+}
+
+vector_t shape_template_centroid(const shape_template_t *shape) {
+    return shape->centroid;
+}
+
+double shape_template_radius(const shape_template_t *shape) {
+    return shape->radius;
+}
@@ -0,0 +1,454 @@
+#include "snapshot.h"
+#include "alloc_track.h"
+#include "list.h"
+#include "vector.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const char SNAPSHOT_MAGIC[4] = {'A', 'B', 'S', 'N'};
+const uint32_t SNAPSHOT_VERSION = 3;
+
+// A scene's kill box or wrap box
+typedef struct snapshot_box {
+    uint32_t has_box;
+    vector_t min;
+    vector_t max;
+} snapshot_box_t;
+
+// The scene's boxes, then the counts of everything that follows the
+// header, in this order: the body records, every body's vertices,
+// the bodies' info records and the scene's record
+typedef struct snapshot_header {
+    char magic[4];
+    uint32_t version;
+    snapshot_box_t kill_box;
+    snapshot_box_t wrap_box;
+    uint64_t bodies;
+    uint64_t vertices;
+    uint64_t info_size;
+    uint64_t scene_size;
+} snapshot_header_t;
+
+// Bytes in the file of a header, a body record and a vertex.
+// Every field is written on its own, so there is no padding.
+#define SNAPSHOT_HEADER_SIZE (4 + 4 + 2 * (4 + 2 * 16) + 4 * 8)
+#define SNAPSHOT_BODY_SIZE (3 * 16 + 3 * 8 + 8 + 4 * 4 + 4 * 4 + 5 * 4)
+#define SNAPSHOT_VERTEX_SIZE 16
+
+// Bits of snapshot_body_t.flags
+typedef enum snapshot_flag {
+    SNAPSHOT_CULLABLE = 1 << 0,
+    SNAPSHOT_WRAPPING = 1 << 1,
+    SNAPSHOT_MANUAL_ACCELERATION = 1 << 2,
+    SNAPSHOT_REMOVED = 1 << 3
+} snapshot_flag_e;
+
+typedef struct snapshot_body {
+    vector_t centroid;
+    vector_t velocity;
+    vector_t acceleration;
+    double mass;
+    double angle;
+    double omega;
+    uint64_t tag;
+    // the body's vertices are the next vertex_count after those of the bodies before it
+    uint32_t vertex_count;
+    uint32_t layer;
+    uint32_t flags;
+    uint32_t render_type;
+    // for COLOR bodies
+    rgb_color_t color;
+    // for TEX bodies: the codec's id for the image, and where it's drawn
+    uint32_t asset;
+    int32_t dx;
+    int32_t dy;
+    int32_t w;
+    int32_t h;
+} snapshot_body_t;
+
+void snapshot_put_u32(uint8_t **out, uint32_t value) {
+    for (size_t i = 0; i < 4; i++) {
+        (*out)[i] = value >> (8 * i);
+    }
+    *out += 4;
+}
+
+void snapshot_put_u64(uint8_t **out, uint64_t value) {
+    for (size_t i = 0; i < 8; i++) {
+        (*out)[i] = value >> (8 * i);
+    }
+    *out += 8;
+}
+
+void snapshot_put_f64(uint8_t **out, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    snapshot_put_u64(out, bits);
+}
+
+void snapshot_put_vec(uint8_t **out, vector_t value) {
+    snapshot_put_f64(out, value.x);
+    snapshot_put_f64(out, value.y);
+}
+
+uint32_t snapshot_get_u32(const uint8_t **in) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; i++) {
+        value |= (uint32_t)(*in)[i] << (8 * i);
+    }
+    *in += 4;
+    return value;
+}
+
+uint64_t snapshot_get_u64(const uint8_t **in) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; i++) {
+        value |= (uint64_t)(*in)[i] << (8 * i);
+    }
+    *in += 8;
+    return value;
+}
+
+double snapshot_get_f64(const uint8_t **in) {
+    uint64_t bits = snapshot_get_u64(in);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+vector_t snapshot_get_vec(const uint8_t **in) {
+    double x = snapshot_get_f64(in);
+    return (vector_t){.x = x, .y = snapshot_get_f64(in)};
+}
+
+void snapshot_put_f32(uint8_t **out, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    snapshot_put_u32(out, bits);
+}
+
+float snapshot_get_f32(const uint8_t **in) {
+    uint32_t bits = snapshot_get_u32(in);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void snapshot_put_box(uint8_t **out, const snapshot_box_t *box) {
+    snapshot_put_u32(out, box->has_box);
+    snapshot_put_vec(out, box->min);
+    snapshot_put_vec(out, box->max);
+}
+
+snapshot_box_t snapshot_get_box(const uint8_t **in) {
+    snapshot_box_t box;
+    box.has_box = snapshot_get_u32(in);
+    box.min = snapshot_get_vec(in);
+    box.max = snapshot_get_vec(in);
+    return box;
+}
+
+void snapshot_header_write(const snapshot_header_t *header, uint8_t *out) {
+    memcpy(out, header->magic, sizeof(header->magic));
+    out += sizeof(header->magic);
+    snapshot_put_u32(&out, header->version);
+    snapshot_put_box(&out, &header->kill_box);
+    snapshot_put_box(&out, &header->wrap_box);
+    snapshot_put_u64(&out, header->bodies);
+    snapshot_put_u64(&out, header->vertices);
+    snapshot_put_u64(&out, header->info_size);
+    snapshot_put_u64(&out, header->scene_size);
+}
+
+snapshot_header_t snapshot_header_read(const uint8_t *in) {
+    snapshot_header_t header;
+    memcpy(header.magic, in, sizeof(header.magic));
+    in += sizeof(header.magic);
+    header.version = snapshot_get_u32(&in);
+    header.kill_box = snapshot_get_box(&in);
+    header.wrap_box = snapshot_get_box(&in);
+    header.bodies = snapshot_get_u64(&in);
+    header.vertices = snapshot_get_u64(&in);
+    header.info_size = snapshot_get_u64(&in);
+    header.scene_size = snapshot_get_u64(&in);
+    return header;
+}
+
+/** Whether a body can be saved: textures are saved by their place in the atlas */
+bool snapshot_body_savable(const body_t *body) {
+    render_info_t render = body_get_render_data(body);
+    return render.type == COLOR || render.data.texture.atlas_index < UINT32_MAX;
+}
+
+snapshot_body_t snapshot_body_record(const body_t *body) {
+    snapshot_body_t record = {
+        .centroid = body_get_centroid(body),
+        .velocity = body_get_velocity(body),
+        .acceleration = body_get_acceleration(body),
+        .mass = body_get_mass(body),
+        .angle = body_get_angle(body),
+        .omega = body_get_omega(body),
+        .tag = body_get_tag(body),
+        .vertex_count = list_size(body_borrow_shape(body)),
+        .layer = body_get_layer(body),
+        .flags = (body_is_cullable(body) ? SNAPSHOT_CULLABLE : 0) |
+                 (body_is_wrapping(body) ? SNAPSHOT_WRAPPING : 0) |
+                 (body_get_manual_acceleration(body) ? SNAPSHOT_MANUAL_ACCELERATION : 0) |
+                 (body_is_removed(body) ? SNAPSHOT_REMOVED : 0)};
+    render_info_t render = body_get_render_data(body);
+    record.render_type = render.type;
+    if (render.type == COLOR) {
+        record.color = render.data.color;
+    } else {
+        const render_data_texture_t *texture = &render.data.texture;
+        record.asset = texture->atlas_index;
+        record.dx = texture->dx;
+        record.dy = texture->dy;
+        record.w = texture->w;
+        record.h = texture->h;
+    }
+    return record;
+}
+
+void snapshot_body_write(const snapshot_body_t *record, uint8_t *out) {
+    uint8_t *start = out;
+    snapshot_put_vec(&out, record->centroid);
+    snapshot_put_vec(&out, record->velocity);
+    snapshot_put_vec(&out, record->acceleration);
+    snapshot_put_f64(&out, record->mass);
+    snapshot_put_f64(&out, record->angle);
+    snapshot_put_f64(&out, record->omega);
+    snapshot_put_u64(&out, record->tag);
+    snapshot_put_u32(&out, record->vertex_count);
+    snapshot_put_u32(&out, record->layer);
+    snapshot_put_u32(&out, record->flags);
+    snapshot_put_u32(&out, record->render_type);
+    snapshot_put_f32(&out, record->color.r);
+    snapshot_put_f32(&out, record->color.g);
+    snapshot_put_f32(&out, record->color.b);
+    snapshot_put_f32(&out, record->color.a);
+    snapshot_put_u32(&out, record->asset);
+    snapshot_put_u32(&out, record->dx);
+    snapshot_put_u32(&out, record->dy);
+    snapshot_put_u32(&out, record->w);
+    snapshot_put_u32(&out, record->h);
+    assert(out - start == SNAPSHOT_BODY_SIZE);
+}
+
+snapshot_body_t snapshot_body_read(const uint8_t *in) {
+    snapshot_body_t record;
+    record.centroid = snapshot_get_vec(&in);
+    record.velocity = snapshot_get_vec(&in);
+    record.acceleration = snapshot_get_vec(&in);
+    record.mass = snapshot_get_f64(&in);
+    record.angle = snapshot_get_f64(&in);
+    record.omega = snapshot_get_f64(&in);
+    record.tag = snapshot_get_u64(&in);
+    record.vertex_count = snapshot_get_u32(&in);
+    record.layer = snapshot_get_u32(&in);
+    record.flags = snapshot_get_u32(&in);
+    record.render_type = snapshot_get_u32(&in);
+    record.color.r = snapshot_get_f32(&in);
+    record.color.g = snapshot_get_f32(&in);
+    record.color.b = snapshot_get_f32(&in);
+    record.color.a = snapshot_get_f32(&in);
+    record.asset = snapshot_get_u32(&in);
+    record.dx = snapshot_get_u32(&in);
+    record.dy = snapshot_get_u32(&in);
+    record.w = snapshot_get_u32(&in);
+    record.h = snapshot_get_u32(&in);
+    return record;
+}
+
+bool snapshot_save(scene_t *scene, const snapshot_codec_t *codec, const char *path) {
+    size_t count = scene_bodies(scene);
+    snapshot_header_t header = {
+        .version = SNAPSHOT_VERSION,
+        .bodies = count,
+        .vertices = 0,
+        .info_size = codec != NULL ? codec->info_size : 0,
+        .scene_size = codec != NULL ? codec->scene_size : 0};
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.kill_box.has_box = scene_get_kill_box(scene, &header.kill_box.min, &header.kill_box.max);
+    header.wrap_box.has_box = scene_get_wrap_box(scene, &header.wrap_box.min, &header.wrap_box.max);
+    for (size_t i = 0; i < count; i++) {
+        const body_t *body = scene_borrow_body(scene, i);
+        if (!snapshot_body_savable(body)) {
+            printf("Unable to save a texture that isn't in an atlas to snapshot: '%s'!\n", path);
+            return false;
+        }
+        header.vertices += list_size(body_borrow_shape(body));
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        printf("Unable to write snapshot: '%s'!\n", path);
+        return false;
+    }
+    uint8_t bytes[SNAPSHOT_BODY_SIZE];
+    snapshot_header_write(&header, bytes);
+    fwrite(bytes, SNAPSHOT_HEADER_SIZE, 1, file);
+
+    for (size_t i = 0; i < count; i++) {
+        snapshot_body_t record = snapshot_body_record(scene_borrow_body(scene, i));
+        snapshot_body_write(&record, bytes);
+        fwrite(bytes, SNAPSHOT_BODY_SIZE, 1, file);
+    }
+    for (size_t i = 0; i < count; i++) {
+        const list_t *shape = body_borrow_shape(scene_borrow_body(scene, i));
+        for (size_t j = 0; j < list_size(shape); j++) {
+            uint8_t *out = bytes;
+            snapshot_put_vec(&out, *(const vector_t *)list_borrow(shape, j));
+            fwrite(bytes, SNAPSHOT_VERTEX_SIZE, 1, file);
+        }
+    }
+
+    // the game's records share one buffer, sized for the larger of them
+    size_t record_size = header.info_size > header.scene_size ? header.info_size : header.scene_size;
+    void *record = TRACKED_MALLOC(ALLOC_OTHER, record_size + 1);
+    assert(record != NULL);
+    for (size_t i = 0; header.info_size > 0 && i < count; i++) {
+        memset(record, 0, header.info_size);
+        codec->save_info(scene, i, record, codec->aux);
+        fwrite(record, header.info_size, 1, file);
+    }
+    if (header.scene_size > 0) {
+        memset(record, 0, header.scene_size);
+        codec->save_scene(scene, record, codec->aux);
+        fwrite(record, header.scene_size, 1, file);
+    }
+    TRACKED_FREE(ALLOC_OTHER, record);
+
+    bool written = !ferror(file);
+    return fclose(file) == 0 && written;
+}
+
+/** Builds a body from its record and its vertices */
+body_t *snapshot_body_build(const snapshot_body_t *record, const uint8_t *vertices,
+                            const snapshot_codec_t *codec) {
+    list_t *shape = list_init(record->vertex_count, free);
+    for (size_t i = 0; i < record->vertex_count; i++) {
+        list_add(shape, vec_alloc(snapshot_get_vec(&vertices)));
+    }
+    render_info_t render;
+    if (record->render_type == COLOR) {
+        render = render_color(record->color);
+    } else {
+        assert(codec != NULL && codec->asset_sprite != NULL);
+        render = render_sprite(codec->asset_sprite(record->asset, codec->aux), record->w, record->h);
+        render.data.texture.dx = record->dx;
+        render.data.texture.dy = record->dy;
+    }
+
+    body_t *body = body_init_texture(shape, record->mass, render);
+    // the shape is saved already moved and rotated
+    body_set_centroid(body, record->centroid);
+    body_set_angle(body, record->angle);
+    body_set_velocity(body, record->velocity);
+    body_set_acceleration(body, record->acceleration);
+    body_set_omega(body, record->omega);
+    body_set_tag(body, record->tag);
+    body_set_layer(body, record->layer);
+    body_set_cullable(body, record->flags & SNAPSHOT_CULLABLE);
+    body_set_wrapping(body, record->flags & SNAPSHOT_WRAPPING);
+    body_set_manual_acceleration(body, record->flags & SNAPSHOT_MANUAL_ACCELERATION);
+    if (record->flags & SNAPSHOT_REMOVED) {
+        body_remove(body);
+    }
+    return body;
+}
+
+/**
+ * Whether a file of size bytes holds exactly what its header counts,
+ * and its bodies have as many vertices as the header says.
+ * The counts are checked against the size before they are multiplied,
+ * so a damaged header can't overflow the expected size.
+ */
+bool snapshot_complete(const snapshot_header_t *header, const uint8_t *data, size_t size) {
+    if (size < SNAPSHOT_HEADER_SIZE || header->bodies > size / SNAPSHOT_BODY_SIZE ||
+        header->vertices > size / SNAPSHOT_VERTEX_SIZE ||
+        header->info_size > size || header->scene_size > size ||
+        (header->info_size > 0 && header->bodies > size / header->info_size)) {
+        return false;
+    }
+    size_t expected_size = SNAPSHOT_HEADER_SIZE + header->bodies * SNAPSHOT_BODY_SIZE +
+                           header->vertices * SNAPSHOT_VERTEX_SIZE +
+                           header->bodies * header->info_size + header->scene_size;
+    if (size != expected_size) {
+        return false;
+    }
+    uint64_t vertices = 0;
+    for (size_t i = 0; i < header->bodies; i++) {
+        snapshot_body_t record = snapshot_body_read(data + SNAPSHOT_HEADER_SIZE + i * SNAPSHOT_BODY_SIZE);
+        vertices += record.vertex_count;
+    }
+    return vertices == header->vertices;
+}
+
+bool snapshot_load(scene_t *scene, const snapshot_codec_t *codec, const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        printf("Unable to load snapshot: '%s'!\n", path);
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    size_t size = file_size > 0 ? file_size : 0;
+    uint8_t *data = TRACKED_MALLOC(ALLOC_OTHER, size + 1);
+    assert(data != NULL);
+    size_t read = fread(data, 1, size, file);
+    fclose(file);
+
+    snapshot_header_t header = {0};
+    if (read == size && size >= SNAPSHOT_HEADER_SIZE) {
+        header = snapshot_header_read(data);
+    }
+    size_t info_size = codec != NULL ? codec->info_size : 0;
+    size_t scene_size = codec != NULL ? codec->scene_size : 0;
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+        header.version != SNAPSHOT_VERSION || header.info_size != info_size ||
+        header.scene_size != scene_size || !snapshot_complete(&header, data, size)) {
+        printf("Not a snapshot of version %u with this codec: '%s'!\n", SNAPSHOT_VERSION, path);
+        TRACKED_FREE(ALLOC_OTHER, data);
+        return false;
+    }
+
+    if (header.kill_box.has_box) {
+        scene_set_kill_box(scene, header.kill_box.min, header.kill_box.max);
+    }
+    if (header.wrap_box.has_box) {
+        scene_set_wrap_box(scene, header.wrap_box.min, header.wrap_box.max);
+    }
+
+    const uint8_t *records = data + SNAPSHOT_HEADER_SIZE;
+    const uint8_t *vertices = records + header.bodies * SNAPSHOT_BODY_SIZE;
+    const uint8_t *infos = vertices + header.vertices * SNAPSHOT_VERTEX_SIZE;
+    const uint8_t *scene_record = infos + header.bodies * info_size;
+
+    size_t count = header.bodies;
+    body_t **bodies = TRACKED_MALLOC(ALLOC_OTHER, (count + 1) * sizeof(body_t *));
+    assert(bodies != NULL);
+    size_t first_vertex = 0;
+    for (size_t i = 0; i < count; i++) {
+        snapshot_body_t record = snapshot_body_read(records + i * SNAPSHOT_BODY_SIZE);
+        bodies[i] = snapshot_body_build(&record, vertices + first_vertex * SNAPSHOT_VERTEX_SIZE, codec);
+        first_vertex += record.vertex_count;
+    }
+    // every body exists before the infos that refer to them are restored
+    for (size_t i = 0; info_size > 0 && i < count; i++) {
+        codec->load_info(bodies[i], infos + i * info_size, bodies, codec->aux);
+    }
+    for (size_t i = 0; i < count; i++) {
+        scene_add_body(scene, bodies[i]);
+    }
+    if (scene_size > 0) {
+        codec->load_scene(scene, scene_record, bodies, count, codec->aux);
+    }
+
+    TRACKED_FREE(ALLOC_OTHER, bodies);
+    TRACKED_FREE(ALLOC_OTHER, data);
+    return true;
+}
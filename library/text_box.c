@@ -2,6 +2,7 @@
 #include <assert.h>
 #include "vector.h"
 #include "text_box.h"
+#include "alloc_track.h"
 
 typedef struct text_box {
     char *text;
@@ -11,7 +12,7 @@ typedef struct text_box {
 } text_box_t;
 
 text_box_t *text_box_init(char *text, size_t font_size, vector_t origin, justification_e justification) {
-    text_box_t *text_box = malloc(sizeof(text_box_t));
+    text_box_t *text_box = TRACKED_MALLOC(ALLOC_OTHER, sizeof(text_box_t));
     assert(text_box != NULL);
     text_box->text = text;
     text_box->font_size = font_size;
@@ -21,7 +22,7 @@ text_box_t *text_box_init(char *text, size_t font_size, vector_t origin, justifi
 }
 
 void text_box_free(text_box_t *text_box) {
-    free(text_box);
+    TRACKED_FREE(ALLOC_OTHER, text_box);
 }
 
 char *text_box_get_text(text_box_t *text_box) {
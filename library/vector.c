@@ -1,4 +1,5 @@
 #include "vector.h"
+#include "alloc_track.h"
 #include "utils.h"
 #include <assert.h>
 #include <math.h>
@@ -21,7 +22,7 @@ vector_t vec_y(double y) {
 }
 
 vector_t *vec_alloc(vector_t v) {
-    vector_t *ptr = malloc(sizeof(vector_t));
+    vector_t *ptr = TRACKED_MALLOC(ALLOC_VERTEX, sizeof(vector_t));
     assert(ptr != NULL);
     *ptr = v;
     return ptr;
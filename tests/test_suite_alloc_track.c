@@ -0,0 +1,88 @@
+#include "alloc_track.h"
+#include "test_util.h"
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+void test_counts_per_site() {
+    alloc_track_reset();
+    void *body = alloc_track_malloc(ALLOC_BODY, 100);
+    void *list = alloc_track_malloc(ALLOC_LIST, 16);
+    list = alloc_track_realloc(ALLOC_LIST, list, 32);
+    alloc_track_free(ALLOC_LIST, list);
+
+    // nothing is reported for the frame until it ends
+    assert(alloc_track_frame(ALLOC_BODY).allocs == 0);
+    alloc_track_frame_end();
+    alloc_stats_t body_stats = alloc_track_frame(ALLOC_BODY);
+    alloc_stats_t list_stats = alloc_track_frame(ALLOC_LIST);
+    assert(body_stats.allocs == 1 && body_stats.bytes == 100 && body_stats.frees == 0);
+    assert(list_stats.allocs == 2 && list_stats.bytes == 48 && list_stats.frees == 1);
+    assert(alloc_track_frame(ALLOC_AUX).allocs == 0);
+
+    alloc_track_free(ALLOC_BODY, body);
+    alloc_track_frame_end();
+    assert(alloc_track_frame(ALLOC_BODY).allocs == 0);
+    assert(alloc_track_frame(ALLOC_BODY).frees == 1);
+    assert(alloc_track_total(ALLOC_BODY).allocs == 1);
+    assert(alloc_track_total(ALLOC_LIST).bytes == 48);
+    assert(alloc_track_frames() == 2);
+    assert(strcmp(alloc_site_name(ALLOC_VERTEX), "vertex") == 0);
+}
+
+void test_reset() {
+    alloc_track_reset();
+    alloc_track_free(ALLOC_AUX, alloc_track_malloc(ALLOC_AUX, 8));
+    alloc_track_frame_end();
+    alloc_track_reset();
+    assert(alloc_track_frames() == 0);
+    assert(alloc_track_total(ALLOC_AUX).allocs == 0);
+    assert(alloc_track_frame(ALLOC_AUX).frees == 0);
+}
+
+void allocate_and_end_frame(void *aux) {
+    alloc_track_free(ALLOC_AUX, alloc_track_malloc(ALLOC_AUX, 8));
+    alloc_track_frame_end();
+}
+
+void test_budget() {
+    alloc_track_reset();
+    alloc_track_set_budget(2);
+    void *a = alloc_track_malloc(ALLOC_BUNDLE, 8);
+    void *b = alloc_track_malloc(ALLOC_AUX, 8);
+    // a frame at the budget passes
+    alloc_track_frame_end();
+    alloc_track_free(ALLOC_BUNDLE, a);
+    alloc_track_free(ALLOC_AUX, b);
+    // frees don't count against it
+    alloc_track_set_budget(0);
+    alloc_track_frame_end();
+
+    // an exempt frame may go over, but is still counted
+    alloc_track_exempt_frame();
+    alloc_track_free(ALLOC_AUX, alloc_track_malloc(ALLOC_AUX, 8));
+    alloc_track_frame_end();
+    assert(alloc_track_frame(ALLOC_AUX).allocs == 1);
+    // and the exemption ends with the frame
+    assert(test_assert_fail(allocate_and_end_frame, NULL));
+    alloc_track_set_budget(SIZE_MAX);
+    alloc_track_reset();
+}
+
+int main(int argc, char *argv[]) {
+    puts("alloc_track_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_counts_per_site)
+    DO_TEST(test_reset)
+    DO_TEST(test_budget)
+
+    puts("alloc_track_test PASS");
+}
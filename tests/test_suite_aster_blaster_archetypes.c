@@ -0,0 +1,109 @@
+#include "aster_blaster_imports.h"
+#include "test_util.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// The atlas never touches its texture, so any pointer will do
+SDL_Texture *const FAKE_TEXTURE = (SDL_Texture *)&FAKE_TEXTURE;
+
+const double TICK_DT = 1e-3;
+
+/** Sets up a game the way stress_context_init() does, without SDL */
+void test_context_init(game_context_t *ctx) {
+    sdl_atlas_t *atlas = atlas_init(FAKE_TEXTURE, SPRITE_COUNT);
+    *ctx = (game_context_t){
+        .scene = scene_init(),
+        .atlas = atlas,
+        .ast_sprites_list = ast_sprites_list_init(atlas),
+        .weapon_ready = true,
+        .shapes = shape_cache_init()};
+    seed_game(ctx, 1);
+    archetype_pools_init(ctx);
+}
+
+void test_context_free(game_context_t *ctx) {
+    scene_free(ctx->scene);
+    archetype_pools_free(ctx);
+    shape_cache_free(ctx->shapes);
+    atlas_free((sdl_atlas_t *)ctx->atlas);
+}
+
+void test_archetype_get() {
+    game_context_t ctx;
+    test_context_init(&ctx);
+    // the types whose bodies leave the screen for good
+    const bool cullable[BODY_TYPE_COUNT] = {
+        [BULLET] = true,
+        [LASER] = true,
+        [ASTEROID] = true,
+        [ENEMY_SHOOTER_BULLET] = true,
+        [BLACK_HOLE] = true,
+        [BOSS_BULLET] = true};
+    for (body_type_e type = 0; type < BODY_TYPE_COUNT; type++) {
+        archetype_t archetype = archetype_get(&ctx, type);
+        assert(archetype.cullable == cullable[type]);
+        assert(archetype.layer == LAYER_DEFAULT);
+
+        // a spawned body is tagged with its type, pooled or not
+        body_t *body = spawn_entity(&ctx, type, vec(100, 200));
+        assert(body_get_tag(body) == type);
+        assert(body_get_layer(body) == archetype.layer);
+        assert(body_is_cullable(body) == archetype.cullable);
+        aster_aux_t *aster_aux = body_get_info(body);
+        assert(aster_aux->body_type == type);
+        assert(aster_aux->health == archetype.health);
+        assert(scene_tagged_bodies(ctx.scene, type) == 1);
+    }
+    assert(archetype_get(&ctx, PLAYER).health == HEALTH_TOTAL);
+    assert(archetype_get(&ctx, BOSS).health == BOSS_HEALTH);
+    test_context_free(&ctx);
+}
+
+void test_wire_interactions() {
+    game_context_t ctx;
+    test_context_init(&ctx);
+    wire_interactions(&ctx, PHASE_ALWAYS);
+
+    // a bullet and a saw destroy each other
+    spawn_entity(&ctx, ENEMY_SAW, vec(100, 100));
+    spawn_entity(&ctx, BULLET, vec(100, 100));
+    scene_tick(ctx.scene, TICK_DT);
+    assert(scene_tagged_bodies(ctx.scene, ENEMY_SAW) == 0);
+    assert(scene_tagged_bodies(ctx.scene, BULLET) == 0);
+
+    // bullets go through the boss until it is tangible
+    body_t *boss = spawn_entity(&ctx, BOSS, vec(500, 500));
+    body_t *health_bar = body_health_bar_init();
+    scene_add_body(ctx.scene, health_bar);
+    aster_aux_t *boss_aux = body_get_info(boss);
+    boss_aux->health_bar = health_bar;
+    spawn_entity(&ctx, BULLET, vec(500, 500));
+    scene_tick(ctx.scene, TICK_DT);
+    assert(scene_tagged_bodies(ctx.scene, BULLET) == 1);
+    assert(boss_aux->health == BOSS_HEALTH);
+
+    wire_interactions(&ctx, PHASE_BOSS_TANGIBLE);
+    scene_tick(ctx.scene, TICK_DT);
+    assert(scene_tagged_bodies(ctx.scene, BULLET) == 0);
+    assert(scene_tagged_bodies(ctx.scene, BOSS) == 1);
+    assert(boss_aux->health < BOSS_HEALTH);
+    test_context_free(&ctx);
+}
+
+int main(int argc, char *argv[]) {
+    puts("aster_blaster_archetypes START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_archetype_get)
+    DO_TEST(test_wire_interactions)
+
+    puts("aster_blaster_archetypes PASS");
+}
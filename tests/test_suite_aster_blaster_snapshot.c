@@ -0,0 +1,148 @@
+#include "aster_blaster_imports.h"
+#include "test_util.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+const char TEST_SNAPSHOT_PATH[] = "test_game_snapshot.bin";
+
+// The atlas never touches its texture, so any pointer will do
+SDL_Texture *const FAKE_TEXTURE = (SDL_Texture *)&FAKE_TEXTURE;
+
+/** Sets up a game the way stress_context_init() does, without SDL */
+void test_context_init(game_context_t *ctx) {
+    sdl_atlas_t *atlas = atlas_init(FAKE_TEXTURE, SPRITE_COUNT);
+    *ctx = (game_context_t){
+        .scene = scene_init(),
+        .atlas = atlas,
+        .ast_sprites_list = ast_sprites_list_init(atlas),
+        .weapon_ready = true,
+        .shapes = shape_cache_init()};
+    seed_game(ctx, 1);
+    archetype_pools_init(ctx);
+}
+
+void test_context_free(game_context_t *ctx) {
+    scene_free(ctx->scene);
+    archetype_pools_free(ctx);
+    shape_cache_free(ctx->shapes);
+    atlas_free((sdl_atlas_t *)ctx->atlas);
+}
+
+/** A player, a hurt saw that has wandered off its path and a moving asteroid */
+void make_game(game_context_t *ctx) {
+    body_t *health_bar = body_health_bar_init();
+    scene_add_body(ctx->scene, health_bar);
+    body_t *player = spawn_player(ctx, health_bar);
+    ((aster_aux_t *)body_get_info(player))->health = HEALTH_TOTAL / 2;
+
+    body_t *saw = spawn_entity(ctx, ENEMY_SAW, vec(300, 400));
+    aster_aux_t *saw_aux = body_get_info(saw);
+    saw_aux->health = 3;
+    saw_aux->steering_offset = vec(-20, 10);
+
+    body_t *asteroid = spawn_entity(ctx, ASTEROID, vec(700, 100));
+    body_set_velocity(asteroid, vec(-15, 25));
+    body_set_wrapping(asteroid, true);
+}
+
+void test_round_trip() {
+    game_context_t ctx;
+    test_context_init(&ctx);
+    make_game(&ctx);
+    assert(game_snapshot_save(&ctx, TEST_SNAPSHOT_PATH));
+
+    game_context_t loaded;
+    test_context_init(&loaded);
+    assert(game_snapshot_load(&loaded, TEST_SNAPSHOT_PATH));
+    assert(scene_bodies(loaded.scene) == scene_bodies(ctx.scene));
+    for (size_t i = 0; i < scene_bodies(ctx.scene); i++) {
+        body_t *a = scene_get_body(ctx.scene, i);
+        body_t *b = scene_get_body(loaded.scene, i);
+        assert(vec_isclose(body_get_centroid(a), body_get_centroid(b)));
+        assert(vec_equal(body_get_velocity(a), body_get_velocity(b)));
+        assert(body_get_tag(a) == body_get_tag(b));
+        assert(body_is_cullable(a) == body_is_cullable(b));
+        assert(body_is_wrapping(a) == body_is_wrapping(b));
+        assert(body_get_manual_acceleration(a) == body_get_manual_acceleration(b));
+        assert(body_is_removed(a) == body_is_removed(b));
+
+        aster_aux_t *aux_a = body_get_info(a);
+        aster_aux_t *aux_b = body_get_info(b);
+        assert((aux_a == NULL) == (aux_b == NULL));
+        if (aux_a != NULL) {
+            assert(aux_a->body_type == aux_b->body_type);
+            assert(aux_a->health == aux_b->health);
+            assert(aux_a->game_over == aux_b->game_over);
+            assert(vec_equal(aux_a->steering_offset, aux_b->steering_offset));
+        }
+    }
+
+    // references to bodies point to the loaded ones
+    assert(loaded.player == scene_get_body(loaded.scene, 1));
+    assert(((aster_aux_t *)body_get_info(loaded.player))->health == HEALTH_TOTAL / 2);
+    assert(((aster_aux_t *)body_get_info(loaded.player))->health_bar == scene_get_body(loaded.scene, 0));
+    assert(loaded.boss == NULL);
+    assert(scene_tagged_bodies(loaded.scene, ENEMY_SAW) == 1);
+    aster_aux_t *saw_aux = body_get_info(scene_get_tagged_body(loaded.scene, ENEMY_SAW, 0));
+    assert(saw_aux->health == 3);
+
+    test_context_free(&ctx);
+    test_context_free(&loaded);
+    remove(TEST_SNAPSHOT_PATH);
+}
+
+/** Saves a game, then changes one byte of it and drops its last drop bytes */
+void save_damaged(size_t offset, uint8_t value, size_t drop) {
+    game_context_t ctx;
+    test_context_init(&ctx);
+    make_game(&ctx);
+    assert(game_snapshot_save(&ctx, TEST_SNAPSHOT_PATH));
+    test_context_free(&ctx);
+
+    FILE *file = fopen(TEST_SNAPSHOT_PATH, "rb");
+    uint8_t data[8192];
+    size_t size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+    assert(size > offset && size > drop && size < sizeof(data));
+    data[offset] = value;
+    file = fopen(TEST_SNAPSHOT_PATH, "wb");
+    fwrite(data, 1, size - drop, file);
+    fclose(file);
+}
+
+void test_load_rejected() {
+    game_context_t loaded;
+    test_context_init(&loaded);
+
+    // a version this build doesn't read, which follows the 4-byte magic
+    save_damaged(4, 0xFF, 0);
+    assert(!game_snapshot_load(&loaded, TEST_SNAPSHOT_PATH));
+    // cut short by a byte
+    save_damaged(0, 'A', 1);
+    assert(!game_snapshot_load(&loaded, TEST_SNAPSHOT_PATH));
+    assert(!game_snapshot_load(&loaded, "no_such_snapshot.bin"));
+    assert(scene_bodies(loaded.scene) == 0);
+    assert(loaded.player == NULL);
+
+    test_context_free(&loaded);
+    remove(TEST_SNAPSHOT_PATH);
+}
+
+int main(int argc, char *argv[]) {
+    puts("aster_blaster_snapshot START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_round_trip)
+    DO_TEST(test_load_rejected)
+
+    puts("aster_blaster_snapshot PASS");
+}
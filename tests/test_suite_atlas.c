@@ -0,0 +1,60 @@
+#include "atlas.h"
+#include "test_util.h"
+#include <assert.h>
+
+// The atlas never touches its texture, so any pointer will do
+SDL_Texture *const FAKE_TEXTURE = (SDL_Texture *)&FAKE_TEXTURE;
+
+void test_default_sprites() {
+    sdl_atlas_t *atlas = atlas_init(FAKE_TEXTURE, 3);
+    assert(atlas_size(atlas) == 3);
+    assert(atlas_get_texture(atlas) == FAKE_TEXTURE);
+    for (size_t i = 0; i < 3; i++) {
+        sprite_t sprite = atlas_get(atlas, i);
+        assert(sprite.tex == FAKE_TEXTURE);
+        assert(sprite.atlas_index == i);
+        assert(sprite.uv.x == 0 && sprite.uv.y == 0);
+        assert(sprite.uv.w == 1 && sprite.uv.h == 1);
+    }
+    atlas_free(atlas);
+}
+
+void test_set_sprite() {
+    sdl_atlas_t *atlas = atlas_init(FAKE_TEXTURE, 2);
+    atlas_set_sprite(atlas, 1, (SDL_FRect){0.5f, 0.25f, 0.5f, 0.75f});
+    sprite_t first = atlas_get(atlas, 0);
+    sprite_t second = atlas_get(atlas, 1);
+    assert(first.uv.x == 0 && first.uv.w == 1);
+    assert(second.tex == FAKE_TEXTURE);
+    assert(second.uv.x == 0.5f && second.uv.y == 0.25f);
+    assert(second.uv.w == 0.5f && second.uv.h == 0.75f);
+    atlas_free(atlas);
+}
+
+void test_white_uv() {
+    sdl_atlas_t *atlas = atlas_init(FAKE_TEXTURE, 0);
+    SDL_FPoint unset = atlas_get_white_uv(atlas);
+    assert(unset.x == 0 && unset.y == 0);
+    atlas_set_white_uv(atlas, (SDL_FPoint){0.125f, 0.5f});
+    SDL_FPoint white = atlas_get_white_uv(atlas);
+    assert(white.x == 0.125f && white.y == 0.5f);
+    atlas_free(atlas);
+}
+
+int main(int argc, char *argv[]) {
+    puts("atlas_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_default_sprites)
+    DO_TEST(test_set_sprite)
+    DO_TEST(test_white_uv)
+
+    puts("atlas_test PASS");
+}
@@ -0,0 +1,126 @@
+#include "backend.h"
+#include "scene.h"
+#include "test_util.h"
+#include <assert.h>
+#include <stdlib.h>
+
+// A backend that records what it was asked to do
+size_t fake_renders = 0;
+size_t fake_polls = 0;
+rgb_color_t fake_background = {0, 0, 0};
+key_handler_t fake_handler = NULL;
+
+void fake_init(vector_t min, vector_t max) {}
+void fake_set_background_color(rgb_color_t color) {
+    fake_background = color;
+}
+void fake_set_font(const char *font_path) {}
+void fake_on_key(key_handler_t handler) {
+    fake_handler = handler;
+}
+// Presses a key on every poll and stops after three polls
+bool fake_is_done(void *aux) {
+    fake_polls++;
+    if (fake_handler != NULL) {
+        fake_handler(UP_ARROW, KEY_PRESSED, 0, aux);
+    }
+    return fake_polls >= 3;
+}
+void fake_render_scene(const scene_t *scene) {
+    fake_renders++;
+}
+void fake_run(void (*game)(void)) {
+    game();
+}
+sdl_atlas_t *fake_atlas_init(const char *const *files, size_t count) {
+    return NULL;
+}
+void fake_atlas_free(sdl_atlas_t *atlas) {}
+double fake_time_since_last_tick(void) {
+    return 0.25;
+}
+double fake_frame_rate = 0;
+void fake_set_frame_rate(double fps) {
+    fake_frame_rate = fps;
+}
+const frame_clock_t *fake_frame_clock(void) {
+    return NULL;
+}
+
+const backend_t FAKE_BACKEND = {
+    .name = "fake",
+    .init = fake_init,
+    .set_background_color = fake_set_background_color,
+    .set_font = fake_set_font,
+    .on_key = fake_on_key,
+    .is_done = fake_is_done,
+    .render_scene = fake_render_scene,
+    .run = fake_run,
+    .atlas_init = fake_atlas_init,
+    .atlas_free = fake_atlas_free,
+    .time_since_last_tick = fake_time_since_last_tick,
+    .set_frame_rate = fake_set_frame_rate,
+    .frame_clock = fake_frame_clock};
+
+size_t games_played = 0;
+void play_game(void) {
+    games_played++;
+}
+
+void count_up_presses(char key, key_event_type_t type, double held_time, void *aux) {
+    if (key == UP_ARROW && type == KEY_PRESSED) {
+        (*(size_t *)aux)++;
+    }
+}
+
+void test_backend_forwards() {
+    backend_use(&FAKE_BACKEND);
+    assert(backend_current() == &FAKE_BACKEND);
+    backend_init(VEC_ZERO, vec(10, 10));
+    backend_set_background_color((rgb_color_t){1, 0.5, 0});
+    assert(fake_background.g == 0.5);
+    assert(backend_time_since_last_tick() == 0.25);
+    backend_set_frame_rate(60);
+    assert(fake_frame_rate == 60);
+    assert(backend_frame_clock() == NULL);
+    backend_run(play_game);
+    assert(games_played == 1);
+}
+
+void test_backend_loop() {
+    backend_use(&FAKE_BACKEND);
+    scene_t *scene = scene_init();
+    size_t presses = 0;
+    backend_on_key(count_up_presses);
+
+    fake_polls = 0;
+    fake_renders = 0;
+    double time = 0;
+    while (!backend_is_done(&presses)) {
+        time += backend_time_since_last_tick();
+        scene_tick(scene, backend_time_since_last_tick());
+        backend_render_scene(scene);
+    }
+    assert(fake_polls == 3);
+    assert(fake_renders == 2);
+    assert(presses == 3);
+    assert(isclose(time, 0.5));
+    scene_free(scene);
+}
+
+int main(int argc, char *argv[]) {
+    puts("backend_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_backend_forwards)
+    DO_TEST(test_backend_loop)
+
+    puts("backend_test PASS");
+}
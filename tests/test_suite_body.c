@@ -1,4 +1,6 @@
 #include "body.h"
+#include "polygon.h"
+#include "shape_cache.h"
 #include "test_util.h"
 #include <assert.h>
 #include <math.h>
@@ -190,6 +192,49 @@ void test_body_remove() {
     body_free(body);
 }
 
+void test_bounding_radius() {
+    list_t *shape = list_init(3, free);
+    vector_t *v = malloc(sizeof(*v));
+    *v = (vector_t) {0, 0};
+    list_add(shape, v);
+    v = malloc(sizeof(*v));
+    *v = (vector_t) {6, 0};
+    list_add(shape, v);
+    v = malloc(sizeof(*v));
+    *v = (vector_t) {0, 3};
+    list_add(shape, v);
+    body_t *body = body_init(shape, 1, (rgb_color_t) {0, 0, 0});
+    // the centroid is (2, 1), so (6, 0) is the farthest vertex
+    assert(isclose(body_get_bounding_radius(body), sqrt(17)));
+    body_set_rotation(body, 1);
+    body_set_centroid(body, (vector_t) {-40, 7});
+    assert(isclose(body_get_bounding_radius(body), sqrt(17)));
+    assert(!body_is_cullable(body));
+    body_set_cullable(body, true);
+    assert(body_is_cullable(body));
+    body_free(body);
+}
+
+void test_body_scale() {
+    list_t *shape = list_init(4, free);
+    vector_t corners[] = {{1, 1}, {5, 1}, {5, 3}, {1, 3}};
+    for (size_t i = 0; i < 4; i++) {
+        vector_t *v = malloc(sizeof(*v));
+        *v = corners[i];
+        list_add(shape, v);
+    }
+    body_t *body = body_init(shape, 1, (rgb_color_t) {0, 0, 0});
+    double radius = body_get_bounding_radius(body);
+    body_scale(body, 0.5);
+    // shrinks towards the centroid (3, 2), which stays put
+    assert(vec_isclose(body_get_centroid(body), (vector_t) {3, 2}));
+    assert(vec_isclose(*(vector_t *) list_get(body_get_shape(body), 0), (vector_t) {2, 1.5}));
+    assert(vec_isclose(*(vector_t *) list_get(body_get_shape(body), 2), (vector_t) {4, 2.5}));
+    assert(isclose(body_get_bounding_radius(body), radius / 2));
+    assert(isclose(polygon_area(body_get_shape(body)), 2));
+    body_free(body);
+}
+
 void test_body_info() {
     list_t *shape = list_init(3, free);
     vector_t *v = malloc(sizeof(*v));
@@ -243,6 +288,81 @@ void test_body_info_freer() {
     body_free(body);
 }
 
+// Asserts that two bodies have the same vertices and centroid
+void assert_same_vertices(body_t *a, body_t *b) {
+    const list_t *shape_a = body_borrow_shape(a);
+    const list_t *shape_b = body_borrow_shape(b);
+    assert(list_size(shape_a) == list_size(shape_b));
+    for (size_t i = 0; i < list_size(shape_a); i++) {
+        assert(vec_isclose(*(const vector_t *)list_borrow(shape_a, i), *(const vector_t *)list_borrow(shape_b, i)));
+    }
+    assert(vec_isclose(body_get_centroid(a), body_get_centroid(b)));
+    assert(isclose(body_get_bounding_radius(a), body_get_bounding_radius(b)));
+}
+
+void test_body_template() {
+    shape_cache_t *cache = shape_cache_init();
+    const shape_template_t *sector = shape_cache_sector(cache, 12, 4, M_PI / 4);
+    vector_t center = vec(5, -3);
+    body_t *shared = body_init_template(sector, center, 4, 2, render_color(COLOR_WHITE));
+    body_t *owned = body_init(polygon_ngon_sector(center, 4, 12, 4, M_PI / 4), 2, COLOR_WHITE);
+    assert(body_get_template(shared) == sector);
+    assert(body_get_template(owned) == NULL);
+    assert(isclose(body_get_scale(shared), 4));
+    assert_same_vertices(shared, owned);
+    // every other field starts the same as an owned body's
+    assert(vec_equal(body_get_velocity(shared), VEC_ZERO));
+    assert(body_get_tag(shared) == body_get_tag(owned));
+    assert(body_get_layer(shared) == body_get_layer(owned));
+    assert(body_get_info(shared) == NULL && !body_is_removed(shared));
+
+    // moving, turning and resizing the template body matches the owned one
+    body_set_velocity(shared, vec(1, 2));
+    body_set_velocity(owned, vec(1, 2));
+    body_set_omega(shared, 0.75);
+    body_set_omega(owned, 0.75);
+    for (size_t i = 0; i < 100; i++) {
+        body_tick(shared, 0.1);
+        body_tick(owned, 0.1);
+    }
+    body_scale(shared, 1.5);
+    body_scale(owned, 1.5);
+    assert(isclose(body_get_scale(shared), 6));
+    assert_same_vertices(shared, owned);
+
+    body_reset(shared, VEC_ZERO);
+    body_reset(owned, VEC_ZERO);
+    assert_same_vertices(shared, owned);
+
+    list_t *clone = body_get_shape_cloned(shared);
+    assert(list_size(clone) == shape_template_size(sector));
+    list_free(clone);
+
+    body_free(shared);
+    body_free(owned);
+    shape_cache_free(cache);
+}
+
+void test_body_set_template() {
+    shape_cache_t *cache = shape_cache_init();
+    body_t *body = body_init_template(shape_cache_ngon(cache, 4), vec(1, 2), 3, 1, render_color(COLOR_WHITE));
+    body_set_rotation(body, 0.5);
+
+    // growing and shrinking the shape keeps the body's place, angle and size
+    const shape_template_t *shapes[] = {shape_cache_ngon(cache, 9), shape_cache_ngon(cache, 5)};
+    for (size_t i = 0; i < 2; i++) {
+        body_set_template(body, shapes[i]);
+        assert(body_get_template(body) == shapes[i]);
+        body_t *expected = body_init_template(shapes[i], vec(1, 2), 3, 1, render_color(COLOR_WHITE));
+        body_set_rotation(expected, 0.5);
+        assert_same_vertices(body, expected);
+        body_free(expected);
+    }
+
+    body_free(body);
+    shape_cache_free(cache);
+}
+
 int main(int argc, char *argv[]) {
     puts("body_test START");
 
@@ -260,6 +380,10 @@ int main(int argc, char *argv[]) {
     DO_TEST(test_infinite_mass)
     DO_TEST(test_forces)
     DO_TEST(test_body_remove)
+    DO_TEST(test_bounding_radius)
+    DO_TEST(test_body_scale)
+    DO_TEST(test_body_template)
+    DO_TEST(test_body_set_template)
     DO_TEST(test_body_info)
     DO_TEST(test_body_info_freer)
 
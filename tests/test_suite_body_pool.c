@@ -0,0 +1,102 @@
+#include "body_pool.h"
+#include "polygon.h"
+#include "scene.h"
+#include "test_util.h"
+#include <assert.h>
+#include <stdlib.h>
+
+body_t *make_triangle() {
+    return body_init(polygon_reg_ngon(VEC_ZERO, 1, 3), 1, (rgb_color_t){1, 1, 1});
+}
+
+void test_pool_acquire() {
+    body_pool_t *pool = body_pool_init(2);
+    body_pool_add(pool, make_triangle());
+    body_pool_add(pool, make_triangle());
+    assert(body_pool_size(pool) == 2);
+    assert(body_pool_idle(pool) == 2);
+
+    body_t *a = body_pool_acquire(pool, vec(5, 5));
+    body_t *b = body_pool_acquire(pool, vec(-5, 0));
+    assert(a != NULL && b != NULL && a != b);
+    assert(vec_isclose(body_get_centroid(a), vec(5, 5)));
+    assert(body_pool_idle(pool) == 0);
+    assert(body_pool_acquire(pool, VEC_ZERO) == NULL);
+
+    body_release(a);
+    body_release(b);
+    assert(body_pool_idle(pool) == 2);
+    body_pool_free(pool);
+}
+
+void test_pool_reset() {
+    body_pool_t *pool = body_pool_init(1);
+    body_pool_add(pool, make_triangle());
+    body_t *body = body_pool_acquire(pool, VEC_ZERO);
+    vector_t first_vertex = *(vector_t *)list_get(body_get_shape(body), 0);
+    body_set_velocity(body, vec(1, 2));
+    body_set_omega(body, 3);
+    body_tick(body, 0.5);
+    body_remove(body);
+    body_release(body);
+
+    body_t *again = body_pool_acquire(pool, vec(10, 0));
+    assert(again == body);
+    assert(!body_is_removed(again));
+    assert(vec_equal(body_get_velocity(again), VEC_ZERO));
+    assert(body_get_omega(again) == 0);
+    assert(isclose(body_get_angle(again), 0));
+    assert(vec_isclose(body_get_centroid(again), vec(10, 0)));
+    assert(vec_isclose(*(vector_t *)list_get(body_get_shape(again), 0), vec_add(first_vertex, vec(10, 0))));
+    body_release(again);
+    body_pool_free(pool);
+}
+
+void test_scene_returns_to_pool() {
+    body_pool_t *pool = body_pool_init(3);
+    for (size_t i = 0; i < 3; i++) {
+        body_pool_add(pool, make_triangle());
+    }
+    scene_t *scene = scene_init();
+    body_t *kept = make_triangle();
+    scene_add_body(scene, kept);
+    for (size_t i = 0; i < 3; i++) {
+        scene_add_body(scene, body_pool_acquire(pool, vec(i, 0)));
+    }
+    assert(body_pool_idle(pool) == 0);
+
+    scene_remove_body(scene, 1);
+    scene_remove_body(scene, 3);
+    scene_tick(scene, 1);
+    assert(scene_bodies(scene) == 2);
+    assert(body_pool_idle(pool) == 2);
+
+    // the removed bodies can be used again right away
+    body_t *reused = body_pool_acquire(pool, VEC_ZERO);
+    assert(reused != NULL);
+    scene_add_body(scene, reused);
+    scene_tick(scene, 1);
+    assert(scene_bodies(scene) == 3);
+
+    scene_free(scene);
+    assert(body_pool_idle(pool) == 3);
+    body_pool_free(pool);
+}
+
+int main(int argc, char *argv[]) {
+    puts("body_pool_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_pool_acquire)
+    DO_TEST(test_pool_reset)
+    DO_TEST(test_scene_returns_to_pool)
+
+    puts("body_pool_test PASS");
+}
@@ -1,6 +1,272 @@
+#include "collision.h"
+#include "polygon.h"
+#include "rng.h"
+#include "test_util.h"
 #include <assert.h>
+#include <math.h>
 #include <stdbool.h>
-#include "test_util.h"
+#include <stdlib.h>
+
+/*
+ * Differential tests: random shapes from the polygon.c generators are run
+ * through each implementation below and through a plain reference, and
+ * every answer that differs by more than DIFF_TOLERANCE is printed with
+ * the seed and case that reproduce it.
+ * An optimized version of find_collision(), polygon_project() or
+ * polygon_rotate() is checked by adding it to the matching table.
+ */
+
+typedef collision_info_t (*collision_func_t)(const list_t *shape1, const list_t *shape2);
+typedef interval_t (*project_func_t)(const list_t *poly, vector_t axis);
+typedef void (*rotate_func_t)(list_t *polygon, double angle, vector_t point);
+
+typedef struct collision_impl {
+    const char *name;
+    collision_func_t func;
+} collision_impl_t;
+
+typedef struct project_impl {
+    const char *name;
+    project_func_t func;
+} project_impl_t;
+
+typedef struct rotate_impl {
+    const char *name;
+    rotate_func_t func;
+} rotate_impl_t;
+
+const collision_impl_t COLLISION_IMPLS[] = {{"find_collision", find_collision}};
+const project_impl_t PROJECT_IMPLS[] = {{"polygon_project", polygon_project}};
+const rotate_impl_t ROTATE_IMPLS[] = {{"polygon_rotate", polygon_rotate}};
+
+// Each seed is a separate run of DIFF_CASES cases
+const uint64_t DIFF_SEEDS[] = {1, 2, 3, 0x5eed};
+const size_t DIFF_CASES = 2000;
+const double DIFF_TOLERANCE = 1e-7;
+// Shapes are centered in a square this wide, so about half of the pairs touch
+const double DIFF_AREA = 60;
+const double DIFF_MIN_RADIUS = 1;
+const double DIFF_MAX_RADIUS = 25;
+#define REFERENCE_MAX_VERTICES 32
+
+#define ARRAY_LENGTH(array) (sizeof(array) / sizeof((array)[0]))
+
+typedef enum diff_shape {
+    DIFF_RECT,
+    DIFF_NGON,
+    DIFF_STAR,
+    DIFF_SECTOR,
+    DIFF_SHAPE_COUNT
+} diff_shape_e;
+
+/** Makes a random shape with one of the polygon.c generators */
+list_t *random_shape(rng_t *rng) {
+    vector_t center = rng_vec(rng, VEC_ZERO, vec(DIFF_AREA, DIFF_AREA));
+    double r = rng_range(rng, DIFF_MIN_RADIUS, DIFF_MAX_RADIUS);
+    list_t *shape;
+    switch (rng_int_range(rng, 0, DIFF_SHAPE_COUNT - 1)) {
+    case DIFF_RECT:
+        shape = polygon_rect(center, r, rng_range(rng, DIFF_MIN_RADIUS, DIFF_MAX_RADIUS));
+        break;
+    case DIFF_NGON:
+        shape = polygon_reg_ngon(center, r, rng_int_range(rng, 3, 12));
+        break;
+    case DIFF_STAR:
+        shape = polygon_star(center, r, r * rng_range(rng, 0.2, 0.9), rng_int_range(rng, 2, 8));
+        break;
+    default: {
+        size_t sides = rng_int_range(rng, 4, 16);
+        shape = polygon_ngon_sector(center, r, sides, rng_int_range(rng, 1, sides - 2),
+                                    rng_range(rng, 0, 2 * M_PI));
+        break;
+    }
+    }
+    polygon_rotate(shape, rng_range(rng, 0, 2 * M_PI), center);
+    return shape;
+}
+
+/** Copies a shape's vertices into an array, returning how many there are */
+size_t reference_vertices(const list_t *shape, vector_t *vertices) {
+    size_t count = list_size(shape);
+    assert(count > 0 && count <= REFERENCE_MAX_VERTICES);
+    for (size_t i = 0; i < count; i++) {
+        vertices[i] = *(const vector_t *)list_borrow(shape, i);
+    }
+    return count;
+}
+
+interval_t reference_project(const vector_t *vertices, size_t count, vector_t axis) {
+    interval_t interval = {.low = INFINITY, .high = -INFINITY};
+    for (size_t i = 0; i < count; i++) {
+        double d = vertices[i].x * axis.x + vertices[i].y * axis.y;
+        interval.low = fmin(interval.low, d);
+        interval.high = fmax(interval.high, d);
+    }
+    return interval;
+}
+
+/**
+ * What find_collision() should answer: every axis the separating axis
+ * test tries, with how far the shapes overlap along it.
+ * Near a tie, any axis that overlaps within DIFF_TOLERANCE of the least
+ * is right, and near touching either answer to collided is.
+ */
+typedef struct reference_collision {
+    bool collided;
+    bool borderline;
+    double depth;
+    size_t axes;
+    // the axes scaled by their overlap, first shape's edges first
+    vector_t axis[2 * REFERENCE_MAX_VERTICES];
+    double overlap[2 * REFERENCE_MAX_VERTICES];
+} reference_collision_t;
+
+/** Adds the normal of each edge of a shape, pointing to its left */
+void reference_add_axes(reference_collision_t *ref, const vector_t *edges, size_t edge_count,
+                        const vector_t *a, size_t a_count, const vector_t *b, size_t b_count,
+                        double sign) {
+    for (size_t i = 0; i < edge_count; i++) {
+        vector_t edge = vec_subtract(edges[(i + 1) % edge_count], edges[i]);
+        double length = sqrt(edge.x * edge.x + edge.y * edge.y);
+        vector_t normal = {.x = -edge.y / length, .y = edge.x / length};
+        interval_t ia = reference_project(a, a_count, normal);
+        interval_t ib = reference_project(b, b_count, normal);
+        double overlap = fmin(ia.high, ib.high) - fmax(ia.low, ib.low);
+        ref->axis[ref->axes] = vec_multiply(sign * overlap, normal);
+        ref->overlap[ref->axes] = overlap;
+        ref->axes++;
+        ref->depth = fmin(ref->depth, overlap);
+    }
+}
+
+reference_collision_t reference_collision(const list_t *shape1, const list_t *shape2) {
+    vector_t a[REFERENCE_MAX_VERTICES], b[REFERENCE_MAX_VERTICES];
+    size_t a_count = reference_vertices(shape1, a);
+    size_t b_count = reference_vertices(shape2, b);
+    reference_collision_t ref = {.depth = INFINITY};
+
+    // the bounding boxes are checked first, since the shapes may be concave
+    interval_t ax = reference_project(a, a_count, vec(1, 0));
+    interval_t bx = reference_project(b, b_count, vec(1, 0));
+    interval_t ay = reference_project(a, a_count, vec(0, 1));
+    interval_t by = reference_project(b, b_count, vec(0, 1));
+    double box_overlap = fmin(fmin(ax.high, bx.high) - fmax(ax.low, bx.low),
+                              fmin(ay.high, by.high) - fmax(ay.low, by.low));
+
+    // the axes of the second shape point the other way, from shape1 to shape2
+    reference_add_axes(&ref, a, a_count, a, a_count, b, b_count, 1);
+    reference_add_axes(&ref, b, b_count, b, b_count, a, a_count, -1);
+    ref.collided = box_overlap > 0 && ref.depth > 0;
+    ref.borderline = fabs(box_overlap) < DIFF_TOLERANCE || fabs(ref.depth) < DIFF_TOLERANCE;
+    return ref;
+}
+
+bool collision_matches(const reference_collision_t *ref, collision_info_t info) {
+    if (ref->borderline) {
+        return true;
+    }
+    if (info.collided != ref->collided) {
+        return false;
+    }
+    for (size_t i = 0; info.collided && i < ref->axes; i++) {
+        if (ref->overlap[i] <= ref->depth + DIFF_TOLERANCE &&
+            vec_within(DIFF_TOLERANCE, info.axis, ref->axis[i])) {
+            return true;
+        }
+    }
+    return !info.collided;
+}
+
+void test_find_collision_differential() {
+    size_t mismatches = 0;
+    for (size_t s = 0; s < ARRAY_LENGTH(DIFF_SEEDS); s++) {
+        rng_t rng = rng_init(DIFF_SEEDS[s], 0);
+        for (size_t i = 0; i < DIFF_CASES; i++) {
+            list_t *shape1 = random_shape(&rng);
+            list_t *shape2 = random_shape(&rng);
+            reference_collision_t ref = reference_collision(shape1, shape2);
+            for (size_t impl = 0; impl < ARRAY_LENGTH(COLLISION_IMPLS); impl++) {
+                collision_info_t info = COLLISION_IMPLS[impl].func(shape1, shape2);
+                if (!collision_matches(&ref, info)) {
+                    printf("%s mismatch, seed %lu case %zu: collided %d axis (%g, %g), "
+                           "expected collided %d depth %g\n",
+                           COLLISION_IMPLS[impl].name, (unsigned long)DIFF_SEEDS[s], i,
+                           info.collided, info.axis.x, info.axis.y, ref.collided, ref.depth);
+                    mismatches++;
+                }
+            }
+            list_free(shape1);
+            list_free(shape2);
+        }
+    }
+    assert(mismatches == 0);
+}
+
+void test_polygon_project_differential() {
+    size_t mismatches = 0;
+    for (size_t s = 0; s < ARRAY_LENGTH(DIFF_SEEDS); s++) {
+        rng_t rng = rng_init(DIFF_SEEDS[s], 1);
+        for (size_t i = 0; i < DIFF_CASES; i++) {
+            list_t *shape = random_shape(&rng);
+            double angle = rng_range(&rng, 0, 2 * M_PI);
+            vector_t axis = vec(cos(angle), sin(angle));
+            vector_t vertices[REFERENCE_MAX_VERTICES];
+            size_t count = reference_vertices(shape, vertices);
+            interval_t ref = reference_project(vertices, count, axis);
+            for (size_t impl = 0; impl < ARRAY_LENGTH(PROJECT_IMPLS); impl++) {
+                interval_t interval = PROJECT_IMPLS[impl].func(shape, axis);
+                if (!within(DIFF_TOLERANCE, interval.low, ref.low) ||
+                    !within(DIFF_TOLERANCE, interval.high, ref.high)) {
+                    printf("%s mismatch, seed %lu case %zu: [%g, %g], expected [%g, %g]\n",
+                           PROJECT_IMPLS[impl].name, (unsigned long)DIFF_SEEDS[s], i,
+                           interval.low, interval.high, ref.low, ref.high);
+                    mismatches++;
+                }
+            }
+            list_free(shape);
+        }
+    }
+    assert(mismatches == 0);
+}
+
+void test_polygon_rotate_differential() {
+    size_t mismatches = 0;
+    for (size_t s = 0; s < ARRAY_LENGTH(DIFF_SEEDS); s++) {
+        rng_t rng = rng_init(DIFF_SEEDS[s], 2);
+        for (size_t i = 0; i < DIFF_CASES; i++) {
+            list_t *shape = random_shape(&rng);
+            double angle = rng_range(&rng, -2 * M_PI, 2 * M_PI);
+            vector_t point = rng_vec(&rng, VEC_ZERO, vec(DIFF_AREA, DIFF_AREA));
+            vector_t vertices[REFERENCE_MAX_VERTICES];
+            size_t count = reference_vertices(shape, vertices);
+            for (size_t j = 0; j < count; j++) {
+                vector_t rel = vec_subtract(vertices[j], point);
+                vertices[j] = vec(point.x + rel.x * cos(angle) - rel.y * sin(angle),
+                                  point.y + rel.x * sin(angle) + rel.y * cos(angle));
+            }
+            for (size_t impl = 0; impl < ARRAY_LENGTH(ROTATE_IMPLS); impl++) {
+                // each implementation rotates its own copy
+                list_t *rotated = list_init(count, free);
+                for (size_t j = 0; j < count; j++) {
+                    list_add(rotated, vec_alloc(*(const vector_t *)list_borrow(shape, j)));
+                }
+                ROTATE_IMPLS[impl].func(rotated, angle, point);
+                for (size_t j = 0; j < count; j++) {
+                    vector_t v = *(const vector_t *)list_borrow(rotated, j);
+                    if (!vec_within(DIFF_TOLERANCE, v, vertices[j])) {
+                        printf("%s mismatch, seed %lu case %zu vertex %zu: (%g, %g), expected (%g, %g)\n",
+                               ROTATE_IMPLS[impl].name, (unsigned long)DIFF_SEEDS[s], i, j,
+                               v.x, v.y, vertices[j].x, vertices[j].y);
+                        mismatches++;
+                    }
+                }
+                list_free(rotated);
+            }
+            list_free(shape);
+        }
+    }
+    assert(mismatches == 0);
+}
 
 int main(int argc, char *argv[]) {
     puts("collision_test START");
@@ -13,5 +279,9 @@ int main(int argc, char *argv[]) {
         read_testname(argv[1], testname, sizeof(testname));
     }
 
+    DO_TEST(test_find_collision_differential)
+    DO_TEST(test_polygon_project_differential)
+    DO_TEST(test_polygon_rotate_differential)
+
     puts("collision_test PASS");
-}
\ No newline at end of file
+}
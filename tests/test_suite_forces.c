@@ -161,6 +161,77 @@ void test_forces_removed() {
     scene_free(scene);
 }
 
+// Tests that pair collisions match bodies by tag, including ones added later
+void test_pair_collisions() {
+    const size_t ROCK = 0, SHOT = 1;
+    scene_t *scene = scene_init();
+    create_pair_destructive_collision(scene, ROCK, SHOT);
+
+    body_t *rock = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_set_tag(rock, ROCK);
+    scene_add_body(scene, rock);
+    // an untagged body overlapping the rock is never matched
+    scene_add_body(scene, body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0}));
+    scene_tick(scene, 1);
+    assert(scene_bodies(scene) == 2);
+
+    body_t *shot = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_set_tag(shot, SHOT);
+    body_set_centroid(shot, (vector_t) {10, 0});
+    body_set_velocity(shot, (vector_t) {-10, 0});
+    scene_add_body(scene, shot);
+    scene_tick(scene, 1);
+    assert(scene_bodies(scene) == 3);
+    scene_tick(scene, 1);
+    assert(scene_bodies(scene) == 1);
+    assert(body_get_tag(scene_get_body(scene, 0)) == BODY_TAG_NONE);
+    scene_free(scene);
+}
+
+// Tests that pair gravity pulls every tagged body like create_newtonian_gravity()
+void test_pair_gravity() {
+    const size_t STAR = 3, PLANET = 5;
+    scene_t *scene = scene_init();
+    create_pair_newtonian_gravity(scene, 2, PLANET, STAR, true);
+    body_t *star = body_init(make_shape(), 10, (rgb_color_t) {0, 0, 0});
+    body_set_tag(star, STAR);
+    scene_add_body(scene, star);
+    body_t *planets[2];
+    for (size_t i = 0; i < 2; i++) {
+        planets[i] = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+        body_set_tag(planets[i], PLANET);
+        body_set_centroid(planets[i], (vector_t) {i == 0 ? 5 : -5, 0});
+        scene_add_body(scene, planets[i]);
+    }
+    scene_tick(scene, 1);
+    // F = G m1 m2 / r^2 = 0.8 towards the star, and the star doesn't move
+    assert(vec_isclose(body_get_velocity(planets[0]), (vector_t) {-0.8, 0}));
+    assert(vec_isclose(body_get_velocity(planets[1]), (vector_t) {0.8, 0}));
+    assert(vec_isclose(body_get_velocity(star), VEC_ZERO));
+    scene_free(scene);
+}
+
+void test_attraction_velocity() {
+    // twice as far away is twice as fast
+    assert(vec_isclose(attraction_velocity(0.5, (vector_t) {1, 1}, (vector_t) {1, 5}), (vector_t) {0, 2}));
+    assert(vec_isclose(attraction_velocity(0.5, (vector_t) {1, 1}, (vector_t) {-7, 1}), (vector_t) {-4, 0}));
+    assert(vec_equal(attraction_velocity(0.5, (vector_t) {1, 1}, (vector_t) {1, 1}), VEC_ZERO));
+
+    // the pairwise force creator moves bodies at the same velocity
+    scene_t *scene = scene_init();
+    body_t *body1 = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_t *body2 = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    vector_t start1 = body_get_centroid(body1);
+    body_set_centroid(body2, vec_add(start1, (vector_t) {3, 4}));
+    scene_add_body(scene, body1);
+    scene_add_body(scene, body2);
+    create_attraction(scene, 2, body1, body2, false);
+    scene_tick(scene, 0);
+    assert(vec_isclose(body_get_velocity(body1), (vector_t) {6, 8}));
+    assert(vec_isclose(body_get_velocity(body2), (vector_t) {-6, -8}));
+    scene_free(scene);
+}
+
 int main(int argc, char *argv[]) {
     puts("forces_test START");
 
@@ -176,6 +247,9 @@ int main(int argc, char *argv[]) {
     DO_TEST(test_energy_conservation)
     DO_TEST(test_collisions)
     DO_TEST(test_forces_removed)
+    DO_TEST(test_pair_collisions)
+    DO_TEST(test_pair_gravity)
+    DO_TEST(test_attraction_velocity)
 
     puts("forces_test PASS");
 }
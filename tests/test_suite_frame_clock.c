@@ -0,0 +1,89 @@
+#include "frame_clock.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+
+void test_percentiles() {
+    frame_clock_t *clock = frame_clock_init(0);
+    assert(frame_clock_frames(clock) == 0);
+    assert(frame_clock_percentile(clock, 0.5) == 0);
+
+    // 90 frames of 10 ms, 9 of 20 ms and one of 50 ms
+    for (size_t i = 0; i < 90; i++) {
+        frame_clock_record(clock, 0.01005);
+    }
+    for (size_t i = 0; i < 9; i++) {
+        frame_clock_record(clock, 0.02005);
+    }
+    frame_clock_record(clock, 0.05005);
+    assert(frame_clock_frames(clock) == 100);
+    // frame times are rounded up to the next 0.1 ms
+    assert(fabs(frame_clock_percentile(clock, 0.5) - 10.1) < 1e-9);
+    assert(fabs(frame_clock_percentile(clock, 0.9) - 10.1) < 1e-9);
+    assert(fabs(frame_clock_percentile(clock, 0.95) - 20.1) < 1e-9);
+    assert(fabs(frame_clock_percentile(clock, 0.99) - 20.1) < 1e-9);
+    assert(fabs(frame_clock_percentile(clock, 1) - 50.1) < 1e-9);
+    frame_clock_free(clock);
+}
+
+void test_window() {
+    frame_clock_t *clock = frame_clock_init(0);
+    // a slow start is forgotten once enough fast frames follow it
+    for (size_t i = 0; i < 100; i++) {
+        frame_clock_record(clock, 0.09995);
+    }
+    assert(fabs(frame_clock_percentile(clock, 0.5) - 100.0) < 1e-9);
+    for (size_t i = 0; i < 1000; i++) {
+        frame_clock_record(clock, 0.00405);
+    }
+    assert(frame_clock_frames(clock) < 1000);
+    assert(fabs(frame_clock_percentile(clock, 1) - 4.1) < 1e-9);
+    frame_clock_free(clock);
+}
+
+void test_tick() {
+    frame_clock_t *clock = frame_clock_init(0);
+    assert(frame_clock_tick(clock) == 0);
+    assert(frame_clock_frames(clock) == 0);
+    double dt = frame_clock_tick(clock);
+    assert(dt >= 0);
+    assert(frame_clock_frames(clock) == 1);
+    frame_clock_free(clock);
+}
+
+void test_limit() {
+    frame_clock_t *clock = frame_clock_init(100);
+    double start = frame_clock_now();
+    frame_clock_tick(clock);
+    for (size_t i = 0; i < 5; i++) {
+        // every frame lasts at least the period
+        assert(frame_clock_tick(clock) >= 0.01);
+    }
+    assert(frame_clock_now() - start >= 0.05);
+    assert(frame_clock_percentile(clock, 0.5) >= 10);
+
+    // without a limit, ticks don't wait
+    frame_clock_set_target(clock, 0);
+    frame_clock_tick(clock);
+    assert(frame_clock_tick(clock) < 0.01);
+    frame_clock_free(clock);
+}
+
+int main(int argc, char *argv[]) {
+    puts("frame_clock_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_percentiles)
+    DO_TEST(test_window)
+    DO_TEST(test_tick)
+    DO_TEST(test_limit)
+
+    puts("frame_clock_test PASS");
+}
@@ -219,6 +219,25 @@ void test_full_add() {
     list_free(l);
 }
 
+void test_reserve() {
+    list_t *l = list_init(2, free);
+    list_add(l, malloc(sizeof(vector_t)));
+
+    list_reserve(l, 10);
+    assert(list_capacity(l) == 10);
+    assert(list_size(l) == 1);
+    // reserving less than the capacity doesn't shrink the list
+    list_reserve(l, 4);
+    assert(list_capacity(l) == 10);
+
+    for (size_t i = 1; i < 10; i++) {
+        list_add(l, malloc(sizeof(vector_t)));
+    }
+    assert(list_capacity(l) == 10);
+
+    list_free(l);
+}
+
 void remove_from_empty(void *l) {
     list_remove((list_t *) l, 0);
 }
@@ -272,6 +291,27 @@ void test_remove_index() {
     list_free(l);
 }
 
+void test_swap_remove() {
+    list_t *l = list_init(4, free);
+    for (size_t i = 0; i < 4; i++) {
+        list_add(l, vec_alloc(vec(i, i)));
+    }
+    // the last element takes the removed one's place
+    vector_t *removed = list_swap_remove(l, 1);
+    assert(vec_equal(*removed, vec(1, 1)));
+    free(removed);
+    assert(list_size(l) == 3);
+    assert(vec_equal(*(vector_t *)list_get(l, 1), vec(3, 3)));
+    assert(vec_equal(*(vector_t *)list_get(l, 2), vec(2, 2)));
+
+    removed = list_swap_remove(l, 2);
+    assert(vec_equal(*removed, vec(2, 2)));
+    free(removed);
+    assert(list_size(l) == 2);
+
+    list_free(l);
+}
+
 int main(int argc, char *argv[]) {
     // Run all tests if there are no command-line arguments
     bool all_tests = argc == 1;
@@ -288,8 +328,10 @@ int main(int argc, char *argv[]) {
     DO_TEST(test_list_large_add_remove)
     DO_TEST(test_out_of_bounds_access)
     DO_TEST(test_full_add)
+    DO_TEST(test_reserve)
     DO_TEST(test_empty_remove)
     DO_TEST(test_remove_index)
+    DO_TEST(test_swap_remove)
     DO_TEST(test_null_values)
 
     puts("list_test PASS");
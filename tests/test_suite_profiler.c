@@ -0,0 +1,178 @@
+#include "profiler.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+const char TEST_CSV_PATH[] = "test_profile.csv";
+const char TEST_TRACE_PATH[] = "test_profile_trace.json";
+const char TEST_PAIRS_PATH[] = "test_profile_pairs.csv";
+
+// Keeps the thread busy for about the given number of milliseconds
+void spin_ms(double ms) {
+    clock_t end = clock() + ms * CLOCKS_PER_SEC / 1000;
+    while (clock() < end) {
+    }
+}
+
+// Counts the lines in a file and whether it contains a string
+size_t read_lines(const char *path, const char *needle, bool *found) {
+    FILE *file = fopen(path, "r");
+    assert(file != NULL);
+    char line[512];
+    size_t lines = 0;
+    *found = false;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        lines++;
+        *found = *found || strstr(line, needle) != NULL;
+    }
+    fclose(file);
+    return lines;
+}
+
+void test_nested_zones() {
+    profiler_reset();
+    profiler_begin(ZONE_SCENE_TICK);
+    spin_ms(2);
+    profiler_begin(ZONE_BODY_TICK);
+    spin_ms(2);
+    profiler_end(ZONE_BODY_TICK);
+    profiler_end(ZONE_SCENE_TICK);
+    assert(profiler_average_ms(ZONE_SCENE_TICK) == 0);
+    profiler_frame_end();
+
+    assert(profiler_frames() == 1);
+    double outer = profiler_average_ms(ZONE_SCENE_TICK);
+    double inner = profiler_average_ms(ZONE_BODY_TICK);
+    // the outer zone includes the inner one
+    assert(inner >= 1.5);
+    assert(outer >= inner + 1.5);
+    assert(profiler_average_ms(ZONE_RENDER) == 0);
+    assert(profile_zone_depth(ZONE_SCENE_TICK) == 0);
+    assert(profile_zone_depth(ZONE_BODY_TICK) == 1);
+    assert(strcmp(profile_zone_name(ZONE_BODY_TICK), "body_tick") == 0);
+}
+
+void test_frame_average() {
+    profiler_reset();
+    // a zone that runs twice in a frame counts both times
+    for (size_t i = 0; i < 2; i++) {
+        profiler_begin(ZONE_REMOVAL);
+        spin_ms(1);
+        profiler_end(ZONE_REMOVAL);
+    }
+    profiler_frame_end();
+    double busy = profiler_average_ms(ZONE_REMOVAL);
+    assert(busy >= 1.5);
+    // frames where the zone doesn't run bring the average down
+    profiler_frame_end();
+    profiler_frame_end();
+    profiler_frame_end();
+    assert(profiler_frames() == 4);
+    // averages are kept to the nearest nanosecond
+    assert(fabs(profiler_average_ms(ZONE_REMOVAL) - busy / 4) < 1e-5);
+
+    profiler_reset();
+    assert(profiler_frames() == 0);
+    assert(profiler_average_ms(ZONE_REMOVAL) == 0);
+}
+
+void test_write_csv() {
+    profiler_reset();
+    for (size_t i = 0; i < 3; i++) {
+        profiler_begin(ZONE_CULL);
+        profiler_end(ZONE_CULL);
+        profiler_frame_end();
+    }
+    assert(profiler_write_csv(TEST_CSV_PATH));
+    bool found;
+    // a header and a row per frame
+    assert(read_lines(TEST_CSV_PATH, "cull_ms", &found) == 4);
+    assert(found);
+    read_lines(TEST_CSV_PATH, ",pairs_tested,", &found);
+    assert(found);
+    remove(TEST_CSV_PATH);
+}
+
+void test_counters() {
+    profiler_reset();
+    profiler_count(COUNTER_SAT_TESTS);
+    profiler_pair_begin(3, 1);
+    profiler_count(COUNTER_PAIRS_TESTED);
+    profiler_count(COUNTER_PAIRS_TESTED);
+    profiler_count(COUNTER_HANDLERS_FIRED);
+    profiler_pair_end();
+    // tags past the table are only counted for the frame
+    profiler_pair_begin(2, PROFILER_MAX_TAGS);
+    profiler_count(COUNTER_PAIRS_TESTED);
+    profiler_pair_end();
+    assert(profiler_counter_frame(COUNTER_PAIRS_TESTED) == 0);
+    profiler_frame_end();
+
+    assert(profiler_counter_frame(COUNTER_PAIRS_TESTED) == 3);
+    assert(profiler_counter_frame(COUNTER_SAT_TESTS) == 1);
+    assert(profiler_counter_frame(COUNTER_HANDLERS_FIRED) == 1);
+    // the order of the tags doesn't matter
+    assert(profiler_pair_frame(1, 3, COUNTER_PAIRS_TESTED) == 2);
+    assert(profiler_pair_frame(3, 1, COUNTER_HANDLERS_FIRED) == 1);
+    assert(profiler_pair_frame(1, 3, COUNTER_SAT_TESTS) == 0);
+    assert(profiler_pair_frame(2, 2, COUNTER_PAIRS_TESTED) == 0);
+    assert(strcmp(profile_counter_name(COUNTER_BOUNDING_BOX_PASSED), "bounding_box_passed") == 0);
+
+    // each frame starts from 0, and the totals keep adding up
+    profiler_pair_begin(1, 3);
+    profiler_count(COUNTER_PAIRS_TESTED);
+    profiler_pair_end();
+    profiler_frame_end();
+    assert(profiler_counter_frame(COUNTER_PAIRS_TESTED) == 1);
+    assert(profiler_counter_frame(COUNTER_SAT_TESTS) == 0);
+    assert(profiler_pair_frame(1, 3, COUNTER_PAIRS_TESTED) == 1);
+    assert(profiler_pair_total(3, 1, COUNTER_PAIRS_TESTED) == 3);
+
+    assert(profiler_write_pairs_csv(TEST_PAIRS_PATH));
+    bool found;
+    // a header and a row for the one pair that counted anything
+    assert(read_lines(TEST_PAIRS_PATH, "1,3,3,0,0,1,2", &found) == 2);
+    assert(found);
+    remove(TEST_PAIRS_PATH);
+
+    profiler_reset();
+    assert(profiler_counter_frame(COUNTER_PAIRS_TESTED) == 0);
+    assert(profiler_pair_total(1, 3, COUNTER_PAIRS_TESTED) == 0);
+}
+
+void test_write_trace() {
+    profiler_reset();
+    profiler_begin(ZONE_PAIR_FORCES);
+    profiler_begin(ZONE_COLLISION_HANDLERS);
+    profiler_end(ZONE_COLLISION_HANDLERS);
+    profiler_end(ZONE_PAIR_FORCES);
+    assert(profiler_write_trace(TEST_TRACE_PATH));
+    bool found;
+    // the opening and closing lines and a line per zone
+    assert(read_lines(TEST_TRACE_PATH, "\"name\": \"collision_handlers\", \"ph\": \"X\"", &found) == 4);
+    assert(found);
+    remove(TEST_TRACE_PATH);
+}
+
+int main(int argc, char *argv[]) {
+    puts("profiler_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_nested_zones)
+    DO_TEST(test_frame_average)
+    DO_TEST(test_write_csv)
+    DO_TEST(test_counters)
+    DO_TEST(test_write_trace)
+
+    puts("profiler_test PASS");
+}
@@ -0,0 +1,132 @@
+#include "render_frame.h"
+#include "polygon.h"
+#include "scene.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+void test_capture_bodies() {
+    scene_t *scene = scene_init();
+    body_t *square = body_init(polygon_rect(VEC_ZERO, 2, 2), 1, (rgb_color_t){1, 0, 0});
+    body_t *triangle = body_init(polygon_reg_ngon(vec(5, 5), 1, 3), 1, (rgb_color_t){0, 1, 0});
+    scene_add_body(scene, square);
+    scene_add_body(scene, triangle);
+
+    render_frame_t *frame = render_frame_init();
+    render_frame_capture(frame, scene);
+    assert(render_frame_items(frame) == 2);
+
+    const render_item_t *item = render_frame_get_item(frame, 0);
+    assert(item->vertex_count == 4);
+    assert(item->render.type == COLOR);
+    assert(item->render.data.color.r == 1);
+    assert(vec_isclose(item->centroid, vec(1, 1)));
+    const vector_t *vertices = render_frame_vertices(frame);
+    assert(vec_isclose(vertices[item->first_vertex + 2], vec(2, 2)));
+
+    item = render_frame_get_item(frame, 1);
+    assert(item->vertex_count == 3);
+    assert(item->first_vertex == 4);
+    assert(render_frame_vertex_count(frame) == 7);
+    assert(vec_isclose(vertices[item->first_vertex], vec(5, 6)));
+
+    render_frame_free(frame);
+    scene_free(scene);
+}
+
+// Moving the scene after a capture must not change the captured frame
+void test_capture_is_a_copy() {
+    scene_t *scene = scene_init();
+    body_t *square = body_init(polygon_rect(VEC_ZERO, 2, 2), 1, (rgb_color_t){1, 1, 1});
+    scene_add_body(scene, square);
+
+    render_frame_t *frame = render_frame_init();
+    render_frame_capture(frame, scene);
+    body_set_velocity(square, vec(1, 0));
+    scene_tick(scene, 1);
+    const render_item_t *item = render_frame_get_item(frame, 0);
+    assert(vec_isclose(item->centroid, vec(1, 1)));
+    assert(vec_isclose(render_frame_vertices(frame)[0], VEC_ZERO));
+
+    // Recapturing reuses the frame and sees the new position
+    render_frame_capture(frame, scene);
+    assert(render_frame_items(frame) == 1);
+    item = render_frame_get_item(frame, 0);
+    assert(vec_isclose(item->centroid, vec(2, 1)));
+
+    render_frame_free(frame);
+    scene_free(scene);
+}
+
+void test_capture_text() {
+    scene_t *scene = scene_init();
+    char text[] = "hello";
+    scene_add_text_box(scene, text_box_init(text, 12, vec(3, 4), CENTER));
+
+    render_frame_t *frame = render_frame_init();
+    render_frame_capture(frame, scene);
+    assert(render_frame_items(frame) == 0);
+    assert(render_frame_texts(frame) == 1);
+    const render_text_t *captured = render_frame_get_text(frame, 0);
+    assert(captured->text == text);
+    assert(captured->font_size == 12);
+    assert(vec_equal(captured->origin, vec(3, 4)));
+    assert(captured->justification == CENTER);
+
+    render_frame_free(frame);
+    scene_free(scene);
+}
+
+void test_capture_by_layer() {
+    scene_t *scene = scene_init();
+    body_t *hud = body_init(polygon_rect(VEC_ZERO, 1, 1), 1, (rgb_color_t){1, 0, 0});
+    body_t *middle = body_init(polygon_rect(VEC_ZERO, 2, 2), 1, (rgb_color_t){0, 1, 0});
+    body_t *back = body_init(polygon_reg_ngon(VEC_ZERO, 1, 3), 1, (rgb_color_t){0, 0, 1});
+    body_t *middle2 = body_init(polygon_rect(VEC_ZERO, 3, 3), 1, (rgb_color_t){0, 1, 1});
+    body_set_layer(hud, LAYER_HUD);
+    body_set_layer(back, LAYER_BACKGROUND);
+    assert(body_get_layer(middle) == LAYER_DEFAULT);
+    scene_add_body(scene, hud);
+    scene_add_body(scene, middle);
+    scene_add_body(scene, back);
+    scene_add_body(scene, middle2);
+
+    render_frame_t *frame = render_frame_init();
+    render_frame_capture(frame, scene);
+    assert(render_frame_items(frame) == 4);
+    assert(render_frame_get_item(frame, 0)->render.data.color.b == 1);
+    assert(render_frame_get_item(frame, 1)->render.data.color.g == 1);
+    assert(render_frame_get_item(frame, 1)->render.data.color.b == 0);
+    assert(render_frame_get_item(frame, 2)->render.data.color.b == 1);
+    assert(render_frame_get_item(frame, 3)->render.data.color.r == 1);
+
+    // each item still points at its own vertices
+    const render_item_t *item = render_frame_get_item(frame, 0);
+    assert(item->vertex_count == 3);
+    item = render_frame_get_item(frame, 2);
+    assert(item->vertex_count == 4);
+    assert(vec_isclose(render_frame_vertices(frame)[item->first_vertex + 2], vec(3, 3)));
+
+    render_frame_free(frame);
+    scene_free(scene);
+}
+
+int main(int argc, char *argv[]) {
+    puts("render_frame_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_capture_bodies)
+    DO_TEST(test_capture_is_a_copy)
+    DO_TEST(test_capture_text)
+    DO_TEST(test_capture_by_layer)
+
+    puts("render_frame_test PASS");
+}
@@ -0,0 +1,97 @@
+#include "replay.h"
+#include "test_util.h"
+#include <assert.h>
+#include <stdio.h>
+
+const char TEST_REPLAY_PATH[] = "test_replay.bin";
+
+void test_round_trip() {
+    replay_t *recording = replay_record(TEST_REPLAY_PATH);
+    assert(recording != NULL);
+    replay_record_game(recording, 42);
+    replay_record_tick(recording, 0, 0.25);
+    replay_record_tick(recording, 0b100, 0.5);
+    replay_record_tick(recording, 0b100, 1.0 / 60);
+    replay_record_game(recording, 43);
+    replay_record_tick(recording, 0b10, 0.125);
+    assert(replay_free(recording));
+
+    replay_t *replay = replay_load(TEST_REPLAY_PATH);
+    assert(replay != NULL);
+    size_t key_down;
+    double dt;
+    uint64_t seed;
+    // there are no ticks before the first game starts
+    assert(!replay_next_tick(replay, &key_down, &dt));
+    assert(replay_next_game(replay, &seed));
+    assert(seed == 42);
+    assert(replay_next_tick(replay, &key_down, &dt));
+    assert(key_down == 0 && dt == 0.25);
+    assert(replay_next_tick(replay, &key_down, &dt));
+    assert(key_down == 0b100 && dt == 0.5);
+    assert(replay_next_tick(replay, &key_down, &dt));
+    // times are replayed exactly
+    assert(key_down == 0b100 && dt == 1.0 / 60);
+    assert(!replay_next_tick(replay, &key_down, &dt));
+
+    assert(replay_next_game(replay, &seed));
+    assert(seed == 43);
+    assert(replay_next_tick(replay, &key_down, &dt));
+    assert(key_down == 0b10 && dt == 0.125);
+    assert(!replay_next_tick(replay, &key_down, &dt));
+    assert(!replay_next_game(replay, &seed));
+    replay_free(replay);
+    remove(TEST_REPLAY_PATH);
+}
+
+void test_skip_game() {
+    replay_t *recording = replay_record(TEST_REPLAY_PATH);
+    replay_record_game(recording, 1);
+    replay_record_tick(recording, 0b1000, 0.1);
+    replay_record_tick(recording, 0b1000, 0.1);
+    replay_record_game(recording, 2);
+    // each game starts with no keys held
+    replay_record_tick(recording, 0, 0.2);
+    assert(replay_free(recording));
+
+    replay_t *replay = replay_load(TEST_REPLAY_PATH);
+    size_t key_down;
+    double dt;
+    uint64_t seed;
+    assert(replay_next_game(replay, &seed));
+    assert(replay_next_tick(replay, &key_down, &dt));
+    // the rest of the first game is skipped
+    assert(replay_next_game(replay, &seed));
+    assert(seed == 2);
+    assert(replay_next_tick(replay, &key_down, &dt));
+    assert(key_down == 0 && dt == 0.2);
+    replay_free(replay);
+    remove(TEST_REPLAY_PATH);
+}
+
+void test_load_invalid() {
+    assert(replay_load("no_such_replay.bin") == NULL);
+    FILE *file = fopen(TEST_REPLAY_PATH, "w");
+    fputs("not a replay", file);
+    fclose(file);
+    assert(replay_load(TEST_REPLAY_PATH) == NULL);
+    remove(TEST_REPLAY_PATH);
+}
+
+int main(int argc, char *argv[]) {
+    puts("replay_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_round_trip)
+    DO_TEST(test_skip_game)
+    DO_TEST(test_load_invalid)
+
+    puts("replay_test PASS");
+}
@@ -0,0 +1,72 @@
+#include "rng.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+
+void test_same_seed() {
+    rng_t a = rng_init(42, 0);
+    rng_t b = rng_init(42, 0);
+    for (size_t i = 0; i < 1000; i++) {
+        assert(rng_next(&a) == rng_next(&b));
+    }
+}
+
+void test_streams_differ() {
+    // neighbouring seeds and streams must not give the same numbers
+    rng_t gens[] = {rng_init(1, 0), rng_init(1, 1), rng_init(2, 0), rng_init(0, 1)};
+    uint64_t firsts[4];
+    for (size_t i = 0; i < 4; i++) {
+        firsts[i] = rng_next(&gens[i]);
+    }
+    for (size_t i = 0; i < 4; i++) {
+        for (size_t j = i + 1; j < 4; j++) {
+            assert(firsts[i] != firsts[j]);
+        }
+    }
+}
+
+void test_ranges() {
+    rng_t rng = rng_init(7, 3);
+    size_t counts[5] = {0};
+    double sum = 0;
+    size_t n = 100000;
+    for (size_t i = 0; i < n; i++) {
+        double d = rng_double(&rng);
+        assert(d >= 0 && d < 1);
+        sum += d;
+
+        double r = rng_range(&rng, -2.5, 4);
+        assert(r >= -2.5 && r < 4);
+
+        int k = rng_int_range(&rng, -2, 2);
+        assert(k >= -2 && k <= 2);
+        counts[k + 2]++;
+
+        vector_t v = rng_vec(&rng, vec(0, 10), vec(1, 20));
+        assert(v.x >= 0 && v.x < 1 && v.y >= 10 && v.y < 20);
+    }
+    // roughly uniform
+    assert(fabs(sum / n - 0.5) < 0.01);
+    for (size_t i = 0; i < 5; i++) {
+        assert(fabs((double)counts[i] / n - 0.2) < 0.01);
+    }
+    assert(rng_int_range(&rng, 3, 3) == 3);
+}
+
+int main(int argc, char *argv[]) {
+    puts("rng_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_same_seed)
+    DO_TEST(test_streams_differ)
+    DO_TEST(test_ranges)
+
+    puts("rng_test PASS");
+}
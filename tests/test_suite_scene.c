@@ -233,6 +233,366 @@ void test_reaping() {
     scene_free(scene);
 }
 
+void test_reap_keeps_ticking() {
+    scene_t *scene = scene_init();
+    body_t *bodies[5];
+    for (size_t i = 0; i < 5; i++) {
+        bodies[i] = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+        body_set_velocity(bodies[i], (vector_t) {1, 0});
+        scene_add_body(scene, bodies[i]);
+    }
+    // removing neighbours must not skip the bodies moved into their places
+    body_remove(bodies[1]);
+    body_remove(bodies[2]);
+    scene_tick(scene, 1);
+
+    assert(scene_bodies(scene) == 3);
+    for (size_t i = 0; i < scene_bodies(scene); i++) {
+        body_t *body = scene_get_body(scene, i);
+        assert(body == bodies[0] || body == bodies[3] || body == bodies[4]);
+        assert(isclose(body_get_centroid(body).x, 1));
+    }
+    scene_free(scene);
+}
+
+// Counts the pairs a pair force creator is called with
+void count_pairs(body_t *body1, body_t *body2, void *aux) {
+    assert(body1 != body2);
+    (*(size_t *)aux)++;
+}
+
+void test_kill_box() {
+    scene_t *scene = scene_init();
+    vector_t min, max;
+    assert(!scene_get_kill_box(scene, &min, &max));
+    scene_set_kill_box(scene, (vector_t) {-10, -10}, (vector_t) {10, 10});
+    assert(scene_get_kill_box(scene, &min, &max));
+    assert(vec_equal(min, (vector_t) {-10, -10}) && vec_equal(max, (vector_t) {10, 10}));
+    // the square's bounding circle has radius sqrt(2), so it sticks into the box
+    body_t *grazing = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_set_centroid(grazing, (vector_t) {11, 0});
+    body_set_velocity(grazing, (vector_t) {1, 0});
+    body_set_cullable(grazing, true);
+    body_t *outside = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_set_centroid(outside, (vector_t) {0, -12});
+    body_set_cullable(outside, true);
+    body_t *kept = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_set_centroid(kept, (vector_t) {50, 50});
+    scene_add_body(scene, grazing);
+    scene_add_body(scene, outside);
+    scene_add_body(scene, kept);
+
+    scene_tick(scene, 1);
+    assert(scene_bodies(scene) == 2);
+    assert(isclose(body_get_centroid(grazing).x, 12));
+    scene_tick(scene, 1);
+    assert(scene_bodies(scene) == 1);
+    assert(scene_get_body(scene, 0) == kept);
+    scene_free(scene);
+}
+
+void test_wrap_box() {
+    scene_t *scene = scene_init();
+    vector_t min, max;
+    assert(!scene_get_wrap_box(scene, &min, &max));
+    scene_set_wrap_box(scene, (vector_t) {-10, -10}, (vector_t) {10, 10});
+    assert(scene_get_wrap_box(scene, &min, &max));
+    assert(vec_equal(min, (vector_t) {-10, -10}) && vec_equal(max, (vector_t) {10, 10}));
+    body_t *falling = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_set_centroid(falling, (vector_t) {3, -10});
+    body_set_velocity(falling, (vector_t) {0, -1});
+    body_set_wrapping(falling, true);
+    body_t *fixed = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_set_centroid(fixed, (vector_t) {3, -10});
+    body_set_velocity(fixed, (vector_t) {0, -1});
+    scene_add_body(scene, falling);
+    scene_add_body(scene, fixed);
+
+    // still touching the box
+    scene_tick(scene, 1);
+    assert(vec_isclose(body_get_centroid(falling), (vector_t) {3, -11}));
+    // entirely below it, so it comes back at the top
+    scene_tick(scene, 1);
+    assert(vec_isclose(body_get_centroid(falling), (vector_t) {3, 8}));
+    assert(vec_isclose(*(vector_t *) list_get(body_get_shape(falling), 0), (vector_t) {2, 7}));
+    assert(vec_isclose(body_get_centroid(fixed), (vector_t) {3, -12}));
+    scene_free(scene);
+}
+
+void test_pair_force_creator() {
+    scene_t *scene = scene_init();
+    size_t same_pairs = 0, cross_pairs = 0;
+    scene_add_pair_force_creator(scene, 1, 1, count_pairs, &same_pairs, NULL);
+    scene_add_pair_force_creator(scene, 1, 2, count_pairs, &cross_pairs, NULL);
+    body_t *removed = NULL;
+    for (size_t i = 0; i < 4; i++) {
+        body_t *body = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+        body_set_tag(body, 1);
+        scene_add_body(scene, body);
+        removed = body;
+    }
+    for (size_t i = 0; i < 2; i++) {
+        body_t *body = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+        body_set_tag(body, 2);
+        scene_add_body(scene, body);
+    }
+    scene_add_body(scene, body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0}));
+
+    scene_tick(scene, 1);
+    // 4 bodies make 6 unordered pairs, and 4 * 2 pairs across the tags
+    assert(same_pairs == 6);
+    assert(cross_pairs == 8);
+
+    // bodies marked for removal are skipped
+    body_remove(removed);
+    same_pairs = 0;
+    cross_pairs = 0;
+    scene_tick(scene, 1);
+    assert(same_pairs == 3);
+    assert(cross_pairs == 6);
+    scene_free(scene);
+}
+
+typedef struct contact_test {
+    scene_t *scene;
+    size_t pairs;
+    size_t handled;
+    bool handle_removed;
+} contact_test_t;
+
+void handle_contact(body_t *body1, body_t *body2, vector_t axis, void *aux) {
+    contact_test_t *test = aux;
+    // every pair is tested before the first contact is handled
+    assert(test->pairs == 3);
+    assert(vec_equal(axis, (vector_t) {1, 0}));
+    test->handled++;
+    // handlers can remove bodies and add new ones
+    body_remove(body1);
+    body_t *body = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_set_tag(body, 1);
+    scene_add_body(test->scene, body);
+}
+
+void queue_contact(body_t *body1, body_t *body2, void *aux) {
+    contact_test_t *test = aux;
+    test->pairs++;
+    scene_add_contact(test->scene, body1, body2, (vector_t) {1, 0}, handle_contact, test, test->handle_removed);
+}
+
+void test_contacts() {
+    scene_t *scene = scene_init();
+    contact_test_t test = {.scene = scene, .pairs = 0, .handled = 0, .handle_removed = false};
+    scene_add_pair_force_creator(scene, 1, 1, queue_contact, &test, NULL);
+    for (size_t i = 0; i < 3; i++) {
+        body_t *body = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+        body_set_tag(body, 1);
+        scene_add_body(scene, body);
+    }
+
+    scene_tick(scene, 1);
+    // the pairs are (a, b), (a, c) and (b, c); handling the first removes a,
+    // so the second is skipped and the third removes b
+    assert(test.handled == 2);
+    assert(scene_contacts(scene) == 0);
+    // two of the three bodies were removed and two were added
+    assert(scene_bodies(scene) == 3);
+
+    scene_free(scene);
+
+    // contacts can ask to be handled even once their bodies are removed
+    scene = scene_init();
+    test = (contact_test_t){.scene = scene, .pairs = 0, .handled = 0, .handle_removed = true};
+    scene_add_pair_force_creator(scene, 1, 1, queue_contact, &test, NULL);
+    for (size_t i = 0; i < 3; i++) {
+        body_t *body = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+        body_set_tag(body, 1);
+        scene_add_body(scene, body);
+    }
+    scene_tick(scene, 1);
+    assert(test.handled == 3);
+    // the handler removed a twice and b once
+    assert(scene_bodies(scene) == 4);
+    scene_free(scene);
+
+    // a contact queued between ticks waits for the next one
+    scene = scene_init();
+    test = (contact_test_t){.scene = scene, .pairs = 3, .handled = 0, .handle_removed = false};
+    body_t *body1 = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_t *body2 = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    scene_add_body(scene, body1);
+    scene_add_body(scene, body2);
+    scene_add_contact(scene, body1, body2, (vector_t) {1, 0}, handle_contact, &test, false);
+    assert(scene_contacts(scene) == 1);
+    assert(test.handled == 0);
+    scene_tick(scene, 1);
+    assert(test.handled == 1);
+    assert(scene_contacts(scene) == 0);
+    scene_free(scene);
+}
+
+typedef struct command_test {
+    scene_t *scene;
+    // the bodies in the scene when each handler or command ran
+    size_t seen[6];
+    size_t runs;
+} command_test_t;
+
+void add_tagged_body(command_test_t *test, const size_t *tag) {
+    test->seen[test->runs++] = scene_bodies(test->scene);
+    body_t *body = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_set_tag(body, *tag);
+    scene_add_body(test->scene, body);
+    if (*tag == 2) {
+        // a command can queue another, which runs in the same batch
+        size_t next_tag = 5;
+        scene_defer(test->scene, (scene_command_t)add_tagged_body, test, &next_tag, sizeof(next_tag));
+    }
+}
+
+void defer_spawn(body_t *body1, body_t *body2, vector_t axis, void *aux) {
+    command_test_t *test = aux;
+    test->seen[test->runs++] = scene_bodies(test->scene);
+    // the args are copied, so they can go out of scope
+    size_t tag = 2;
+    scene_defer(test->scene, (scene_command_t)add_tagged_body, test, &tag, sizeof(tag));
+}
+
+void test_deferred_commands() {
+    scene_t *scene = scene_init();
+    command_test_t test = {.scene = scene, .runs = 0};
+    body_t *body1 = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    body_t *body2 = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    scene_add_body(scene, body1);
+    scene_add_body(scene, body2);
+    scene_add_contact(scene, body1, body2, (vector_t) {1, 0}, defer_spawn, &test, false);
+    scene_add_contact(scene, body1, body2, (vector_t) {1, 0}, defer_spawn, &test, false);
+    assert(scene_commands(scene) == 0);
+
+    scene_tick(scene, 1);
+    // both handlers ran before either spawn, then the spawns ran in order,
+    // followed by the ones they queued
+    assert(test.runs == 6);
+    assert(test.seen[0] == 2 && test.seen[1] == 2);
+    for (size_t i = 2; i < 6; i++) {
+        assert(test.seen[i] == i);
+    }
+    assert(scene_commands(scene) == 0);
+    assert(scene_bodies(scene) == 6);
+    assert(scene_tagged_bodies(scene, 2) == 2);
+    assert(scene_tagged_bodies(scene, 5) == 2);
+
+    // a command queued between ticks waits for the next one
+    size_t tag = 3;
+    scene_defer(scene, (scene_command_t)add_tagged_body, &test, &tag, sizeof(tag));
+    test.runs = 0;
+    assert(scene_commands(scene) == 1);
+    assert(scene_bodies(scene) == 6);
+    scene_tick(scene, 1);
+    assert(test.runs == 1);
+    assert(scene_tagged_bodies(scene, 3) == 1);
+    scene_free(scene);
+}
+
+void push_tagged(body_t **bodies, size_t count, void *aux) {
+    for (size_t i = 0; i < count; i++) {
+        body_set_velocity(bodies[i], vec_add(body_get_velocity(bodies[i]), (vector_t) {1, 0}));
+    }
+    *(size_t *) aux += 1;
+}
+
+void test_tag_force_creator() {
+    scene_t *scene = scene_init();
+    size_t calls = 0;
+    scene_add_tag_force_creator(scene, 3, push_tagged, &calls, NULL);
+    body_t *tagged[3];
+    for (size_t i = 0; i < 3; i++) {
+        tagged[i] = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+        body_set_tag(tagged[i], 3);
+        scene_add_body(scene, tagged[i]);
+    }
+    body_t *untagged = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+    scene_add_body(scene, untagged);
+
+    scene_tick(scene, 1);
+    scene_tick(scene, 1);
+    // called once per tick with every tagged body
+    assert(calls == 2);
+    for (size_t i = 0; i < 3; i++) {
+        assert(vec_isclose(body_get_velocity(tagged[i]), (vector_t) {2, 0}));
+    }
+    assert(vec_equal(body_get_velocity(untagged), VEC_ZERO));
+
+    // removed bodies are passed until they are reaped
+    body_remove(tagged[0]);
+    scene_tick(scene, 1);
+    assert(vec_isclose(body_get_velocity(tagged[1]), (vector_t) {3, 0}));
+    assert(scene_bodies(scene) == 3);
+    scene_tick(scene, 1);
+    assert(calls == 4);
+    assert(vec_isclose(body_get_velocity(tagged[1]), (vector_t) {4, 0}));
+    scene_free(scene);
+}
+
+void test_tag_index() {
+    scene_t *scene = scene_init();
+    assert(scene_tagged_bodies(scene, 4) == 0);
+    body_t *bodies[6];
+    for (size_t i = 0; i < 6; i++) {
+        bodies[i] = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+        if (i % 3 != 2) {
+            body_set_tag(bodies[i], i % 3 == 0 ? 4 : 1);
+        }
+        scene_add_body(scene, bodies[i]);
+    }
+    // tags 4 and 1 each have two bodies, the rest are untagged
+    assert(scene_tagged_bodies(scene, 4) == 2);
+    assert(scene_tagged_bodies(scene, 1) == 2);
+    assert(scene_tagged_bodies(scene, 0) == 0);
+    assert(scene_tagged_bodies(scene, 100) == 0);
+    assert(scene_get_tagged_body(scene, 4, 0) == bodies[0]);
+    assert(scene_get_tagged_body(scene, 4, 1) == bodies[3]);
+
+    // removed bodies leave the index when they are reaped
+    body_remove(bodies[0]);
+    body_remove(bodies[2]);
+    assert(scene_tagged_bodies(scene, 4) == 2);
+    scene_tick(scene, 1);
+    assert(scene_tagged_bodies(scene, 4) == 1);
+    assert(scene_get_tagged_body(scene, 4, 0) == bodies[3]);
+    assert(scene_tagged_bodies(scene, 1) == 2);
+    assert(scene_bodies(scene) == 4);
+    scene_free(scene);
+}
+
+void test_reserve() {
+    scene_t *scene = scene_init();
+    scene_reserve(scene, 20, 50);
+    // reserving a tag that has no bodies yet indexes it
+    scene_reserve_tag(scene, 7, 20);
+    assert(scene_tagged_bodies(scene, 7) == 0);
+    assert(scene_tagged_bodies(scene, 6) == 0);
+    body_t *bodies[20];
+    for (size_t i = 0; i < 20; i++) {
+        bodies[i] = body_init(make_shape(), 1, (rgb_color_t) {0, 0, 0});
+        body_set_tag(bodies[i], 7);
+        scene_add_body(scene, bodies[i]);
+    }
+    assert(scene_bodies(scene) == 20);
+    assert(scene_tagged_bodies(scene, 7) == 20);
+    assert(scene_get_tagged_body(scene, 7, 19) == bodies[19]);
+
+    // a smaller reservation keeps what is there
+    scene_reserve(scene, 1, 1);
+    scene_reserve_tag(scene, 7, 1);
+    assert(scene_tagged_bodies(scene, 7) == 20);
+    contact_test_t test = {.scene = scene, .pairs = 0, .handled = 0, .handle_removed = false};
+    for (size_t i = 0; i < 50; i++) {
+        scene_add_contact(scene, bodies[0], bodies[1], (vector_t) {1, 0}, handle_contact, &test, false);
+    }
+    assert(scene_contacts(scene) == 50);
+    scene_free(scene);
+}
+
 int main(int argc, char *argv[]) {
     // Run all tests if there are no command-line arguments
     bool all_tests = argc == 1;
@@ -248,6 +608,15 @@ int main(int argc, char *argv[]) {
     /* DO_TEST(test_force_creator)
     DO_TEST(test_force_creator_aux) */
     DO_TEST(test_reaping)
+    DO_TEST(test_reap_keeps_ticking)
+    DO_TEST(test_kill_box)
+    DO_TEST(test_wrap_box)
+    DO_TEST(test_pair_force_creator)
+    DO_TEST(test_contacts)
+    DO_TEST(test_deferred_commands)
+    DO_TEST(test_tag_force_creator)
+    DO_TEST(test_tag_index)
+    DO_TEST(test_reserve)
 
     puts("scene_test PASS");
 }
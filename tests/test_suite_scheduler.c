@@ -0,0 +1,126 @@
+#include "scheduler.h"
+#include "scene.h"
+#include "test_util.h"
+#include <assert.h>
+#include <stdlib.h>
+
+// Records the order timers fire in
+typedef struct firing_log {
+    int fired[16];
+    size_t count;
+} firing_log_t;
+
+typedef struct logged_timer {
+    firing_log_t *log;
+    int id;
+    // how many more times to repeat, and how often
+    size_t repeats;
+    double period;
+} logged_timer_t;
+
+double log_firing(logged_timer_t *timer) {
+    timer->log->fired[timer->log->count++] = timer->id;
+    if (timer->repeats == 0) {
+        return TIMER_STOP;
+    }
+    timer->repeats--;
+    return timer->period;
+}
+
+logged_timer_t *logged_timer_init(firing_log_t *log, int id, size_t repeats, double period) {
+    logged_timer_t *timer = malloc(sizeof(logged_timer_t));
+    *timer = (logged_timer_t){.log = log, .id = id, .repeats = repeats, .period = period};
+    return timer;
+}
+
+void test_fires_in_order() {
+    scheduler_t *scheduler = scheduler_init();
+    firing_log_t log = {.count = 0};
+    double delays[] = {5, 1, 4, 2, 3, 2};
+    for (int i = 0; i < 6; i++) {
+        scheduler_add(scheduler, delays[i], (timer_callback_t)log_firing, logged_timer_init(&log, i, 0, 0), free);
+    }
+    assert(scheduler_timers(scheduler) == 6);
+
+    scheduler_advance(scheduler, 0.5);
+    assert(log.count == 0);
+    scheduler_advance(scheduler, 2);
+    // timers due at the same time fire in the order they were added
+    int expected[] = {1, 3, 5, 4, 2, 0};
+    assert(log.count == 3);
+    scheduler_advance(scheduler, 10);
+    assert(log.count == 6);
+    for (size_t i = 0; i < 6; i++) {
+        assert(log.fired[i] == expected[i]);
+    }
+    assert(scheduler_timers(scheduler) == 0);
+    assert(isclose(scheduler_time(scheduler), 12.5));
+    scheduler_free(scheduler);
+}
+
+void test_repeating() {
+    scheduler_t *scheduler = scheduler_init();
+    firing_log_t log = {.count = 0};
+    scheduler_add(scheduler, 1, (timer_callback_t)log_firing, logged_timer_init(&log, 7, 3, 1), free);
+    scheduler_add(scheduler, 2.5, (timer_callback_t)log_firing, logged_timer_init(&log, 8, 0, 0), free);
+
+    // a long step catches up on every time the timer was due
+    scheduler_advance(scheduler, 3.2);
+    assert(log.count == 4);
+    assert(log.fired[0] == 7 && log.fired[1] == 7 && log.fired[2] == 8 && log.fired[3] == 7);
+    scheduler_advance(scheduler, 1);
+    assert(log.count == 5);
+    assert(scheduler_timers(scheduler) == 0);
+    scheduler_free(scheduler);
+}
+
+void test_free_pending() {
+    // the aux of timers that never fire is freed with the scheduler
+    scheduler_t *scheduler = scheduler_init();
+    firing_log_t log = {.count = 0};
+    for (int i = 0; i < 20; i++) {
+        scheduler_add(scheduler, 100 + i, (timer_callback_t)log_firing, logged_timer_init(&log, i, 0, 0), free);
+    }
+    scheduler_free(scheduler);
+}
+
+double spawn_body(scene_t *scene) {
+    list_t *shape = list_init(3, free);
+    for (int i = 0; i < 3; i++) {
+        vector_t *v = malloc(sizeof(*v));
+        *v = (vector_t){i, i * i};
+        list_add(shape, v);
+    }
+    scene_add_body(scene, body_init(shape, 1, (rgb_color_t){0, 0, 0}));
+    return 2;
+}
+
+void test_scene_schedule() {
+    scene_t *scene = scene_init();
+    scene_schedule(scene, 1, (timer_callback_t)spawn_body, scene, NULL);
+    for (size_t i = 0; i < 10; i++) {
+        scene_tick(scene, 0.5);
+    }
+    // fired at 1, 3 and 5 seconds
+    assert(scene_bodies(scene) == 3);
+    scene_free(scene);
+}
+
+int main(int argc, char *argv[]) {
+    puts("scheduler_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_fires_in_order)
+    DO_TEST(test_repeating)
+    DO_TEST(test_free_pending)
+    DO_TEST(test_scene_schedule)
+
+    puts("scheduler_test PASS");
+}
@@ -0,0 +1,68 @@
+#include "shape_cache.h"
+#include "polygon.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+// Asserts that a template holds the vertices of a unit shape, then frees it
+void assert_same_shape(const shape_template_t *shape, list_t *expected) {
+    assert(shape_template_size(shape) == list_size(expected));
+    for (size_t i = 0; i < list_size(expected); i++) {
+        assert(vec_isclose(shape_template_vertices(shape)[i], *(vector_t *)list_get(expected, i)));
+    }
+    assert(vec_isclose(shape_template_centroid(shape), polygon_centroid(expected)));
+    list_free(expected);
+}
+
+void test_matches_polygon() {
+    shape_cache_t *cache = shape_cache_init();
+    assert_same_shape(shape_cache_ngon(cache, 7), polygon_reg_ngon(VEC_ZERO, 1, 7));
+    assert_same_shape(shape_cache_star(cache, 0.4, 5), polygon_star(VEC_ZERO, 1, 0.4, 5));
+    assert_same_shape(shape_cache_sector(cache, 40, 8, M_PI / 3), polygon_ngon_sector(VEC_ZERO, 1, 40, 8, M_PI / 3));
+    shape_cache_free(cache);
+}
+
+void test_template_radius() {
+    shape_cache_t *cache = shape_cache_init();
+    // every vertex of a regular polygon is on the unit circle
+    assert(isclose(shape_template_radius(shape_cache_ngon(cache, 6)), 1));
+    // a sector's centroid moves away from the cut, so its far side is farther
+    const shape_template_t *sector = shape_cache_sector(cache, 12, 4, 0);
+    assert(!vec_isclose(shape_template_centroid(sector), VEC_ZERO));
+    assert(shape_template_radius(sector) > 1);
+    shape_cache_free(cache);
+}
+
+void test_reuses_templates() {
+    shape_cache_t *cache = shape_cache_init();
+    const shape_template_t *pentagon = shape_cache_ngon(cache, 5);
+    assert(shape_cache_ngon(cache, 5) == pentagon);
+    assert(shape_cache_ngon(cache, 6) != pentagon);
+    assert(shape_cache_size(cache) == 2);
+
+    // stars with other ratios are different shapes
+    const shape_template_t *star = shape_cache_star(cache, 0.5, 5);
+    assert(shape_cache_star(cache, 0.5, 5) == star);
+    assert(shape_cache_star(cache, 0.25, 5) != star);
+    assert(shape_cache_size(cache) == 4);
+    shape_cache_free(cache);
+}
+
+int main(int argc, char *argv[]) {
+    puts("shape_cache_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_matches_polygon)
+    DO_TEST(test_template_radius)
+    DO_TEST(test_reuses_templates)
+
+    puts("shape_cache_test PASS");
+}
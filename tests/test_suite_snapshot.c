@@ -0,0 +1,281 @@
+#include "snapshot.h"
+#include "polygon.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+const char TEST_SNAPSHOT_PATH[] = "test_snapshot.bin";
+
+// Stands in for an atlas texture; it is only compared, never drawn
+int fake_texture;
+const sprite_t FAKE_SPRITES[2] = {
+    {.tex = (SDL_Texture *)&fake_texture, .uv = {0, 0, 0.5, 1}, .atlas_index = 0},
+    {.tex = (SDL_Texture *)&fake_texture, .uv = {0.5, 0, 0.5, 1}, .atlas_index = 1}};
+
+// Each body's info is the index of another body, or -1 for NULL
+size_t scene_loads = 0;
+
+void test_save_info(scene_t *scene, size_t index, void *out, void *aux) {
+    body_t *target = body_get_info(scene_get_body(scene, index));
+    int64_t target_index = -1;
+    for (size_t i = 0; target != NULL && i < scene_bodies(scene); i++) {
+        if (scene_get_body(scene, i) == target) {
+            target_index = i;
+        }
+    }
+    uint8_t *record = out;
+    snapshot_put_u64(&record, target_index);
+}
+
+void test_load_info(body_t *body, const void *in, body_t *const *bodies, void *aux) {
+    const uint8_t *record = in;
+    int64_t target_index = snapshot_get_u64(&record);
+    body_set_info(body, target_index >= 0 ? bodies[target_index] : NULL, NULL);
+}
+
+void test_save_scene(scene_t *scene, void *out, void *aux) {
+    uint8_t *record = out;
+    snapshot_put_u64(&record, 7);
+}
+
+void test_load_scene(scene_t *scene, const void *in, body_t *const *bodies, size_t count, void *aux) {
+    const uint8_t *record = in;
+    assert(snapshot_get_u64(&record) == 7);
+    scene_loads++;
+}
+
+sprite_t test_asset_sprite(uint32_t asset, void *aux) {
+    return FAKE_SPRITES[asset];
+}
+
+const snapshot_codec_t TEST_CODEC = {
+    .info_size = 8,
+    .scene_size = 8,
+    .save_info = test_save_info,
+    .load_info = test_load_info,
+    .save_scene = test_save_scene,
+    .load_scene = test_load_scene,
+    .asset_sprite = test_asset_sprite};
+
+scene_t *make_scene() {
+    scene_t *scene = scene_init();
+    scene_set_wrap_box(scene, vec(-5, -6), vec(7, 8));
+    body_t *square = body_init(polygon_rect(vec(1, 2), 3, 4), 5, rgb(0.25, 0.5, 1));
+    body_set_velocity(square, vec(-1, 2));
+    body_set_rotation(square, 0.5);
+    body_set_omega(square, 3);
+    body_set_tag(square, 4);
+    body_set_layer(square, LAYER_BACKDROP);
+    body_set_wrapping(square, true);
+    scene_add_body(scene, square);
+
+    body_t *ship = body_init_texture_with_info(
+        polygon_star(vec(10, 20), 4, 2, 5), INFINITY, render_sprite(FAKE_SPRITES[1], 8, 6), square, NULL);
+    body_set_cullable(ship, true);
+    body_set_manual_acceleration(ship, true);
+    body_set_acceleration(ship, vec(0, -9));
+    scene_add_body(scene, ship);
+
+    body_t *removed = body_init(polygon_rect(VEC_ZERO, 1, 1), 1, COLOR_BLACK);
+    scene_add_body(scene, removed);
+    body_remove(removed);
+    return scene;
+}
+
+void assert_bodies_equal(const body_t *a, const body_t *b) {
+    assert(vec_isclose(body_get_centroid(a), body_get_centroid(b)));
+    assert(vec_equal(body_get_velocity(a), body_get_velocity(b)));
+    assert(vec_equal(body_get_acceleration(a), body_get_acceleration(b)));
+    assert(body_get_mass(a) == body_get_mass(b));
+    assert(body_get_angle(a) == body_get_angle(b));
+    assert(body_get_omega(a) == body_get_omega(b));
+    assert(body_get_tag(a) == body_get_tag(b));
+    assert(body_get_layer(a) == body_get_layer(b));
+    assert(body_is_cullable(a) == body_is_cullable(b));
+    assert(body_is_wrapping(a) == body_is_wrapping(b));
+    assert(body_get_manual_acceleration(a) == body_get_manual_acceleration(b));
+    assert(body_is_removed(a) == body_is_removed(b));
+    assert(isclose(body_get_bounding_radius(a), body_get_bounding_radius(b)));
+
+    const list_t *shape_a = body_borrow_shape(a);
+    const list_t *shape_b = body_borrow_shape(b);
+    assert(list_size(shape_a) == list_size(shape_b));
+    for (size_t i = 0; i < list_size(shape_a); i++) {
+        assert(vec_isclose(*(const vector_t *)list_borrow(shape_a, i),
+                           *(const vector_t *)list_borrow(shape_b, i)));
+    }
+
+    render_info_t render_a = body_get_render_data(a);
+    render_info_t render_b = body_get_render_data(b);
+    assert(render_a.type == render_b.type);
+    if (render_a.type == COLOR) {
+        assert(render_a.data.color.b == render_b.data.color.b);
+    } else {
+        assert(render_a.data.texture.tex == render_b.data.texture.tex);
+        assert(render_a.data.texture.uv.x == render_b.data.texture.uv.x);
+        assert(render_a.data.texture.atlas_index == render_b.data.texture.atlas_index);
+        assert(render_a.data.texture.w == render_b.data.texture.w);
+        assert(render_a.data.texture.dy == render_b.data.texture.dy);
+    }
+}
+
+void test_round_trip() {
+    scene_t *scene = make_scene();
+    assert(snapshot_save(scene, &TEST_CODEC, TEST_SNAPSHOT_PATH));
+
+    scene_t *loaded = scene_init();
+    scene_loads = 0;
+    assert(snapshot_load(loaded, &TEST_CODEC, TEST_SNAPSHOT_PATH));
+    assert(scene_loads == 1);
+    assert(scene_bodies(loaded) == scene_bodies(scene));
+    for (size_t i = 0; i < scene_bodies(scene); i++) {
+        assert_bodies_equal(scene_borrow_body(scene, i), scene_borrow_body(loaded, i));
+    }
+    // references between bodies point to the loaded bodies
+    assert(body_get_info(scene_get_body(loaded, 0)) == NULL);
+    assert(body_get_info(scene_get_body(loaded, 1)) == scene_get_body(loaded, 0));
+    assert(scene_tagged_bodies(loaded, 4) == 1);
+    // so are its boxes
+    vector_t min, max;
+    assert(!scene_get_kill_box(loaded, &min, &max));
+    assert(scene_get_wrap_box(loaded, &min, &max));
+    assert(vec_equal(min, vec(-5, -6)) && vec_equal(max, vec(7, 8)));
+
+    // the loaded scene runs like the original
+    scene_tick(scene, 0.1);
+    scene_tick(loaded, 0.1);
+    assert(scene_bodies(loaded) == 2);
+    for (size_t i = 0; i < scene_bodies(scene); i++) {
+        assert_bodies_equal(scene_borrow_body(scene, i), scene_borrow_body(loaded, i));
+    }
+    scene_free(scene);
+    scene_free(loaded);
+    remove(TEST_SNAPSHOT_PATH);
+}
+
+void test_without_codec() {
+    scene_t *scene = scene_init();
+    scene_set_kill_box(scene, vec(-1, -2), vec(3, 4));
+    scene_add_body(scene, body_init(polygon_reg_ngon(VEC_ZERO, 3, 7), 2, COLOR_WHITE));
+    assert(snapshot_save(scene, NULL, TEST_SNAPSHOT_PATH));
+    // a snapshot only loads with the codec it was saved with
+    scene_t *loaded = scene_init();
+    assert(!snapshot_load(loaded, &TEST_CODEC, TEST_SNAPSHOT_PATH));
+    assert(scene_bodies(loaded) == 0);
+    assert(snapshot_load(loaded, NULL, TEST_SNAPSHOT_PATH));
+    assert(scene_bodies(loaded) == 1);
+    assert_bodies_equal(scene_borrow_body(scene, 0), scene_borrow_body(loaded, 0));
+    vector_t min, max;
+    assert(scene_get_kill_box(loaded, &min, &max));
+    assert(vec_equal(min, vec(-1, -2)) && vec_equal(max, vec(3, 4)));
+    assert(!scene_get_wrap_box(loaded, &min, &max));
+    scene_free(scene);
+    scene_free(loaded);
+    remove(TEST_SNAPSHOT_PATH);
+}
+
+void test_load_invalid() {
+    scene_t *scene = scene_init();
+    assert(!snapshot_load(scene, NULL, "no_such_snapshot.bin"));
+    FILE *file = fopen(TEST_SNAPSHOT_PATH, "w");
+    fputs("not a snapshot", file);
+    fclose(file);
+    assert(!snapshot_load(scene, NULL, TEST_SNAPSHOT_PATH));
+    assert(scene_bodies(scene) == 0);
+    scene_free(scene);
+    remove(TEST_SNAPSHOT_PATH);
+}
+
+// Rewrites the snapshot at TEST_SNAPSHOT_PATH, changing one byte
+// and dropping the last drop bytes
+void damage_snapshot(size_t offset, uint8_t value, size_t drop) {
+    FILE *file = fopen(TEST_SNAPSHOT_PATH, "rb");
+    uint8_t data[4096];
+    size_t size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+    assert(size > offset && size > drop && size < sizeof(data));
+    data[offset] = value;
+    file = fopen(TEST_SNAPSHOT_PATH, "wb");
+    fwrite(data, 1, size - drop, file);
+    fclose(file);
+}
+
+void test_load_damaged() {
+    scene_t *scene = make_scene();
+    scene_t *loaded = scene_init();
+
+    // cut short by a byte
+    assert(snapshot_save(scene, &TEST_CODEC, TEST_SNAPSHOT_PATH));
+    damage_snapshot(0, 'A', 1);
+    assert(!snapshot_load(loaded, &TEST_CODEC, TEST_SNAPSHOT_PATH));
+    assert(scene_bodies(loaded) == 0);
+
+    // a version this build doesn't read, which follows the 4-byte magic
+    assert(snapshot_save(scene, &TEST_CODEC, TEST_SNAPSHOT_PATH));
+    damage_snapshot(4, 0xFF, 0);
+    assert(!snapshot_load(loaded, &TEST_CODEC, TEST_SNAPSHOT_PATH));
+    assert(scene_bodies(loaded) == 0);
+
+    // the undamaged file still loads
+    assert(snapshot_save(scene, &TEST_CODEC, TEST_SNAPSHOT_PATH));
+    damage_snapshot(0, 'A', 0);
+    assert(snapshot_load(loaded, &TEST_CODEC, TEST_SNAPSHOT_PATH));
+    assert(scene_bodies(loaded) == scene_bodies(scene));
+    scene_free(scene);
+    scene_free(loaded);
+    remove(TEST_SNAPSHOT_PATH);
+}
+
+void test_save_unsavable_texture() {
+    scene_t *scene = make_scene();
+    sprite_t loose = {.tex = (SDL_Texture *)&fake_texture, .uv = {0, 0, 1, 1}, .atlas_index = NOT_IN_ATLAS};
+    scene_add_body(scene, body_init_texture(polygon_rect(VEC_ZERO, 1, 1), 1, render_sprite(loose, 1, 1)));
+    remove(TEST_SNAPSHOT_PATH);
+    assert(!snapshot_save(scene, &TEST_CODEC, TEST_SNAPSHOT_PATH));
+    // nothing is written
+    assert(fopen(TEST_SNAPSHOT_PATH, "rb") == NULL);
+    scene_free(scene);
+}
+
+void test_byte_order() {
+    uint8_t bytes[36];
+    uint8_t *out = bytes;
+    snapshot_put_u32(&out, 0x01020304);
+    snapshot_put_u64(&out, -2);
+    snapshot_put_f64(&out, 1.5);
+    snapshot_put_vec(&out, vec(-3, 0.25));
+    assert(out == bytes + sizeof(bytes));
+    // little-endian, whatever the host's order is
+    assert(bytes[0] == 4 && bytes[1] == 3 && bytes[2] == 2 && bytes[3] == 1);
+    assert(bytes[4] == 0xFE && bytes[11] == 0xFF);
+
+    const uint8_t *in = bytes;
+    assert(snapshot_get_u32(&in) == 0x01020304);
+    assert((int64_t)snapshot_get_u64(&in) == -2);
+    assert(snapshot_get_f64(&in) == 1.5);
+    assert(vec_equal(snapshot_get_vec(&in), vec(-3, 0.25)));
+    assert(in == bytes + sizeof(bytes));
+}
+
+int main(int argc, char *argv[]) {
+    puts("snapshot_test START");
+
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_round_trip)
+    DO_TEST(test_without_codec)
+    DO_TEST(test_load_invalid)
+    DO_TEST(test_load_damaged)
+    DO_TEST(test_save_unsavable_texture)
+    DO_TEST(test_byte_order)
+
+    puts("snapshot_test PASS");
+}